@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Generates app/src/algo_asa_table.h from the verified asset list in app/src/algo_asa.csv
+
+Asset ids are emitted sorted, in their own array, so algo_asa_get finds an asset
+with a binary search that only touches ids. Names and units live in one string
+pool: equal strings are stored once and a string that ends another one points
+into it, so entries only hold 16-bit offsets and need no pointer relocation.
+
+Usage: python3 app/scripts/gen_algo_asa.py [--check]
+"""
+
+import csv
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "src", "algo_asa.csv")
+OUTPUT = os.path.join(ROOT, "src", "algo_asa_table.h")
+
+# Display limits of the previous fixed-size table (name[32], unit[15] with its trailing space)
+MAX_NAME_LEN = 31
+MAX_UNIT_LEN = 13
+# Digits of UINT64_MAX, the most _toStringBalance can shift
+MAX_DECIMALS = 19
+MAX_POOL_LEN = 0xFFFF
+
+HEADER = """/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+// Generated by app/scripts/gen_algo_asa.py from algo_asa.csv - DO NOT EDIT
+"""
+
+
+def read_assets():
+    assets = []
+    seen = set()
+    with open(SOURCE, newline="") as f:
+        rows = csv.DictReader(line for line in f if not line.startswith("#"))
+        for row in rows:
+            asset_id = int(row["id"])
+            name = row["name"]
+            # Units are printed as an amount prefix, the separating space is part of it
+            unit = row["unit"] + " "
+            decimals = int(row["decimals"])
+            if not 0 <= asset_id < (1 << 64):
+                sys.exit("asset id %d out of range" % asset_id)
+            if asset_id in seen:
+                sys.exit("asset %d listed twice" % asset_id)
+            if not 0 < len(name.encode()) <= MAX_NAME_LEN:
+                sys.exit("asset %d: name must be 1 to %d bytes" % (asset_id, MAX_NAME_LEN))
+            if not 0 < len(unit.encode()) - 1 <= MAX_UNIT_LEN:
+                sys.exit("asset %d: unit must be 1 to %d bytes" % (asset_id, MAX_UNIT_LEN))
+            if not 0 <= decimals <= MAX_DECIMALS:
+                sys.exit("asset %d: decimals out of range" % asset_id)
+            seen.add(asset_id)
+            assets.append((asset_id, name, unit, decimals))
+    if len(assets) > MAX_POOL_LEN:
+        sys.exit("too many assets for 16-bit indices")
+    return sorted(assets)
+
+
+def build_pool(strings):
+    # Longest first, so a shorter string can reuse the tail of one already placed
+    pool = b""
+    offsets = {}
+    for s in sorted(set(strings), key=lambda s: (-len(s.encode()), s)):
+        raw = s.encode() + b"\0"
+        pos = pool.find(raw)
+        if pos < 0:
+            pos = len(pool)
+            pool += raw
+        offsets[s] = pos
+    if len(pool) > MAX_POOL_LEN:
+        sys.exit("string pool does not fit 16-bit offsets")
+    return pool, offsets
+
+
+def c_string(raw):
+    out = ""
+    for b in raw:
+        ch = chr(b)
+        if ch in "\\\"":
+            out += "\\" + ch
+        elif 0x20 <= b < 0x7F:
+            out += ch
+        else:
+            out += "\\%03o" % b
+    return out
+
+
+def generate():
+    assets = read_assets()
+    pool, offsets = build_pool([a[1] for a in assets] + [a[2] for a in assets])
+    plain = sum(len(a[1]) + len(a[2]) + 2 for a in assets)
+
+    out = [HEADER, "#pragma once\n", "#include \"algo_asa.h\"\n"]
+    out.append("#define ALGO_ASA_COUNT %d" % len(assets))
+    out.append("#define ALGO_ASA_STRINGS_LEN %d   // %d bytes before deduplication\n" % (len(pool), plain))
+
+    out.append("// Sorted, searched by algo_asa_get")
+    out.append("static const uint64_t algoAsaIds[ALGO_ASA_COUNT] = {")
+    for asset_id, _, _, _ in assets:
+        out.append("    %dULL," % asset_id)
+    out.append("};\n")
+
+    out.append("static const algo_asset_info_t algoAsaEntries[ALGO_ASA_COUNT] = {")
+    for asset_id, name, unit, decimals in assets:
+        out.append("    {%5d, %5d, %2d},  // %d %s" % (offsets[name], offsets[unit], decimals, asset_id, name))
+    out.append("};\n")
+
+    # One literal per string, so no escape runs into the next character
+    out.append("static const char algoAsaStrings[] =")
+    start = 0
+    while start < len(pool):
+        end = pool.index(b"\0", start) + 1
+        out.append("    \"%s\\0\"" % c_string(pool[start:end - 1]))
+        start = end
+    out[-1] += ";"
+    return "\n".join(out) + "\n"
+
+
+def main():
+    content = generate()
+    if "--check" in sys.argv:
+        with open(OUTPUT) as f:
+            if f.read() != content:
+                sys.exit("%s is out of date, run %s" % (OUTPUT, sys.argv[0]))
+        return
+    with open(OUTPUT, "w") as f:
+        f.write(content)
+
+
+if __name__ == "__main__":
+    main()
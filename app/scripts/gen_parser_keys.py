@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+Generates app/src/parser_keys.h from the KEY_* definitions in parser_txdef.h
+
+Every msgpack key (and tx type string) understood by the parser is packed into a
+uint64 (bytes little endian, length in the top byte) and assigned an id. A
+multiplicative hash over the folded 32-bit value gives a collision free index
+into a small table, so the parser classifies a key with one hash and one compare.
+
+Usage: python3 app/scripts/gen_parser_keys.py [--check]
+"""
+
+import os
+import random
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TXDEF = os.path.join(ROOT, "src", "parser_txdef.h")
+OUTPUT = os.path.join(ROOT, "src", "parser_keys.h")
+
+MAX_PACKED_LEN = 7
+MAX_HASH_BITS = 10
+# Presence of each id is tracked in a uint64 bitmask by the parser
+MAX_KEY_IDS = 64
+KEY_UNKNOWN = 0xFF
+
+HEADER = """/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+// Generated by app/scripts/gen_parser_keys.py from parser_txdef.h - DO NOT EDIT
+"""
+
+
+def pack(key):
+    raw = key.encode()
+    value = len(raw) << 56
+    for i, b in enumerate(raw):
+        value |= b << (8 * i)
+    return value
+
+
+def fold(packed):
+    return (packed ^ (packed >> 32)) & 0xFFFFFFFF
+
+
+def slot(packed, mult, bits):
+    return ((fold(packed) * mult) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def read_keys():
+    keys = []
+    with open(TXDEF) as f:
+        for line in f:
+            m = re.match(r'#define\s+KEY_(\w+)\s+"([^"]*)"', line)
+            if m:
+                keys.append((m.group(1), m.group(2)))
+    return keys
+
+
+def find_hash(packed):
+    rng = random.Random(0x41474F)
+    bits = max(1, (len(packed) - 1).bit_length())
+    while bits <= MAX_HASH_BITS:
+        for _ in range(200000):
+            mult = rng.getrandbits(32) | 1
+            if len({slot(p, mult, bits) for p in packed}) == len(packed):
+                return mult, bits
+        bits += 1
+    sys.exit("no perfect hash found")
+
+
+def generate():
+    ids = []
+    aliases = []
+    byKey = {}
+    for name, key in read_keys():
+        if not 0 < len(key) <= MAX_PACKED_LEN:
+            sys.exit("key %s does not fit in a packed key" % name)
+        if key in byKey:
+            aliases.append((name, byKey[key]))
+            continue
+        byKey[key] = name
+        ids.append((name, key))
+
+    if len(ids) > MAX_KEY_IDS:
+        sys.exit("too many keys for the presence bitmask")
+
+    packed = [pack(key) for _, key in ids]
+    mult, bits = find_hash(packed)
+    table = [KEY_UNKNOWN] * (1 << bits)
+    for i, p in enumerate(packed):
+        table[slot(p, mult, bits)] = i
+
+    out = [HEADER, "#pragma once\n", "#include <stdint.h>\n"]
+    out.append("#define PARSER_KEY_MAX_PACKED_LEN %d" % MAX_PACKED_LEN)
+    out.append("#define PARSER_KEY_HASH_BITS      %d" % bits)
+    out.append("#define PARSER_KEY_HASH_MULT      0x%08XU" % mult)
+    out.append("#define PARSER_KEY_HASH(packed)   ((uint32_t)(((uint32_t)(packed) ^ (uint32_t)((packed) >> 32)) * PARSER_KEY_HASH_MULT) >> (32 - PARSER_KEY_HASH_BITS))\n")
+
+    out.append("typedef enum {")
+    for i, (name, key) in enumerate(ids):
+        out.append("    KEYID_%-22s = %2d,  // \"%s\"" % (name, i, key))
+    out.append("    KEYID_%-22s = %2d," % ("COUNT", len(ids)))
+    out.append("    KEYID_%-22s = 0x%02X," % ("UNKNOWN", KEY_UNKNOWN))
+    out.append("} parser_key_id_e;\n")
+
+    for name, target in aliases:
+        out.append("#define KEYID_%-21s KEYID_%s" % (name, target))
+    out.append("")
+
+    out.append("static const uint64_t parserKeyPacked[KEYID_COUNT] = {")
+    for (name, _), p in zip(ids, packed):
+        out.append("    0x%016XULL,  // %s" % (p, name))
+    out.append("};\n")
+
+    out.append("static const uint8_t parserKeyHashTable[1 << PARSER_KEY_HASH_BITS] = {")
+    for i in range(0, len(table), 16):
+        out.append("    " + " ".join("0x%02X," % v for v in table[i:i + 16]))
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    content = generate()
+    if "--check" in sys.argv:
+        with open(OUTPUT) as f:
+            if f.read() != content:
+                sys.exit("%s is out of date, run %s" % (OUTPUT, sys.argv[0]))
+        return
+    with open(OUTPUT, "w") as f:
+        f.write(content)
+
+
+if __name__ == "__main__":
+    main()
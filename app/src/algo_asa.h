@@ -1,16 +1,42 @@
 #ifndef __ALGO_ASA_H__
 #define __ALGO_ASA_H__
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
 #include <stdint.h>
 
+// Record of the built-in table, generated into algo_asa_table.h from algo_asa.csv.
+// Names and units are offsets into the table's string pool.
 typedef struct {
-    uint64_t        assetId;
+    uint16_t        name;
+    uint16_t        unit;
     uint8_t         decimals;
-    const char      unit[15];
-    const char      name[32];
 } __attribute__((packed)) algo_asset_info_t;
 
+// Verified asset as shown on screen. The strings belong to the table that resolved it.
+typedef struct {
+    const char      *name;
+    const char      *unit;      // Printed before amounts, ends with a space
+    uint8_t         decimals;
+} algo_asset_t;
+
 
-const algo_asset_info_t *algo_asa_get(uint64_t id);
+bool algo_asa_get(uint64_t id, algo_asset_t *asset);
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOS2) && !defined(TARGET_NANOX) && !defined(TARGET_STAX)
+// Host builds can look assets up somewhere else than the built-in table, see host/asset_store.h.
+// The resolver must stay valid and thread safe while transactions are parsed.
+typedef bool (*algo_asa_resolver_t)(const void *ctx, uint64_t id, algo_asset_t *asset);
+
+// Replaces the built-in table with resolver, NULL restores it
+void algo_asa_set_resolver(algo_asa_resolver_t resolver, const void *ctx);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
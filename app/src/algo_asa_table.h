@@ -0,0 +1,176 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+// Generated by app/scripts/gen_algo_asa.py from algo_asa.csv - DO NOT EDIT
+
+#pragma once
+
+#include "algo_asa.h"
+
+#define ALGO_ASA_COUNT 36
+#define ALGO_ASA_STRINGS_LEN 682   // 682 bytes before deduplication
+
+// Sorted, searched by algo_asa_get
+static const uint64_t algoAsaIds[ALGO_ASA_COUNT] = {
+    163650ULL,
+    312769ULL,
+    438828ULL,
+    438831ULL,
+    438832ULL,
+    438833ULL,
+    438836ULL,
+    438837ULL,
+    438838ULL,
+    438839ULL,
+    438840ULL,
+    2725935ULL,
+    2751733ULL,
+    2757561ULL,
+    2836760ULL,
+    2838934ULL,
+    6547014ULL,
+    6587142ULL,
+    27165954ULL,
+    31566704ULL,
+    137594422ULL,
+    142838028ULL,
+    213345970ULL,
+    226701642ULL,
+    230946361ULL,
+    287867876ULL,
+    297995609ULL,
+    300208676ULL,
+    386192725ULL,
+    386195940ULL,
+    403499324ULL,
+    408898501ULL,
+    441139422ULL,
+    470842789ULL,
+    922346083ULL,
+    1003833031ULL,
+};
+
+static const algo_asset_info_t algoAsaEntries[ALGO_ASA_COUNT] = {
+    {   28,   550,  6},  // 163650 Asia Reserve Currency Coin
+    {  295,   634,  6},  // 312769 Tether USDt
+    {   55,   328,  6},  // 438828 MESE USD Exchange Token
+    {  122,   604,  6},  // 438831 MESE Index Fund
+    {  138,   416,  0},  // 438832 Micro-Microsoft
+    {  208,   408,  0},  // 438833 Micro-Amazon
+    {  168,   440,  0},  // 438836 Micro-Twitter
+    {  154,   424,  0},  // 438837 Micro-Netflix
+    {  221,   366,  0},  // 438838 Micro-Google
+    {  271,   400,  0},  // 438839 Micro-Apple
+    {  283,   432,  0},  // 438840 Micro-Tesla
+    {   79,   668,  7},  // 2725935 Realio Security Token
+    {  234,   663,  7},  // 2751733 Realio Token
+    {  338,   622,  7},  // 2757561 realioUSD
+    {  101,   508,  0},  // 2836760 Liquid Mining Fund I
+    {    0,   522,  0},  // 2838934 Credit Opportunities Fund I
+    {  318,   598,  5},  // 6547014 Meld Gold
+    {  259,   592,  5},  // 6587142 Meld Silver
+    {  501,   375,  6},  // 27165954 PLANET
+    {  673,   628,  6},  // 31566704 USDC
+    {  357,   658,  6},  // 137594422 HEADLINE
+    {  384,   574,  6},  // 142838028 AlgoFam
+    {  487,   568,  8},  // 213345970 Exodus
+    {  464,   640,  6},  // 226701642 Yieldly
+    {  348,   580,  6},  // 230946361 AlgoGems
+    {  456,   616, 10},  // 287867876 Opulous
+    {  247,   392,  2},  // 297995609 Choice Coin
+    {  307,   515,  6},  // 300208676 Smile Coin
+    {  646,   529,  8},  // 386192725 goBTC
+    {  652,   536,  8},  // 386195940 goETH
+    {  610,   678,  0},  // 403499324 NEXUS
+    {  195,   586,  1},  // 408898501 Loot Box ASA
+    {  543,   472,  6},  // 441139422 goMINT
+    {  562,   480,  6},  // 470842789 Defly
+    {  494,   448,  6},  // 922346083 Nimble
+    {  182,   556,  6},  // 1003833031 CollecteursX
+};
+
+static const char algoAsaStrings[] =
+    "Credit Opportunities Fund I\0"
+    "Asia Reserve Currency Coin\0"
+    "MESE USD Exchange Token\0"
+    "Realio Security Token\0"
+    "Liquid Mining Fund I\0"
+    "MESE Index Fund\0"
+    "Micro-Microsoft\0"
+    "Micro-Netflix\0"
+    "Micro-Twitter\0"
+    "CollecteursX\0"
+    "Loot Box ASA\0"
+    "Micro-Amazon\0"
+    "Micro-Google\0"
+    "Realio Token\0"
+    "Choice Coin\0"
+    "Meld Silver\0"
+    "Micro-Apple\0"
+    "Micro-Tesla\0"
+    "Tether USDt\0"
+    "Smile Coin\0"
+    "Meld Gold\0"
+    "USD-MESE \0"
+    "realioUSD\0"
+    "AlgoGems\0"
+    "HEADLINE\0"
+    "M-GOOGL \0"
+    "PLANETS \0"
+    "AlgoFam\0"
+    "CHOICE \0"
+    "M-AAPL \0"
+    "M-AMZN \0"
+    "M-MSFT \0"
+    "M-NFLX \0"
+    "M-TSLA \0"
+    "M-TWTR \0"
+    "NIMBLE \0"
+    "Opulous\0"
+    "Yieldly\0"
+    "goMINT \0"
+    "DEFLY \0"
+    "Exodus\0"
+    "Nimble\0"
+    "PLANET\0"
+    "RHO-I \0"
+    "SMILE \0"
+    "VAL-I \0"
+    "goBTC \0"
+    "goETH \0"
+    "goMINT\0"
+    "ARCC \0"
+    "CLTR \0"
+    "Defly\0"
+    "EXIT \0"
+    "FAME \0"
+    "GEMS \0"
+    "LTBX \0"
+    "MCAG \0"
+    "MCAU \0"
+    "MESX \0"
+    "NEXUS\0"
+    "OPUL \0"
+    "RUSD \0"
+    "USDC \0"
+    "USDt \0"
+    "YLDY \0"
+    "goBTC\0"
+    "goETH\0"
+    "HDL \0"
+    "RIO \0"
+    "RST \0"
+    "USDC\0"
+    "GP \0";
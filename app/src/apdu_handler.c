@@ -32,7 +32,10 @@
 #include "zxmacros.h"
 
 static bool tx_initialized = false;
+// The upload in progress is a group (INS_SIGN_GROUP)
+static bool tx_group = false;
 static const unsigned char tmpBuff[] = {'T', 'X'};
+static uint32_t group_hdPath[HDPATH_LEN_DEFAULT];
 
 __Z_INLINE void extractHDPath() {
     hdPath[0] = HDPATH_0_DEFAULT;
@@ -62,11 +65,25 @@ __Z_INLINE uint8_t convertP1P2(const uint8_t p1, const uint8_t p2)
     return 0xFF;
 }
 
-__Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx)
+// Single transactions are stored behind the "TX" prefix they are signed with,
+// groups bring one per member in place of the member lengths
+__Z_INLINE void chunk_start(bool group)
+{
+    tx_initialize();
+    tx_reset();
+    tx_group = group;
+}
+
+__Z_INLINE uint32_t chunk_append(unsigned char *buffer, uint32_t length)
+{
+    return tx_group ? tx_group_append(buffer, length) : tx_append(buffer, length);
+}
+
+__Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx, bool group)
 {
     const uint8_t P1 = G_io_apdu_buffer[OFFSET_P1];
     const uint8_t P2 = G_io_apdu_buffer[OFFSET_P2];
-    const uint8_t payloadType = convertP1P2(P1, P2);
+    const uint8_t payloadType = convertP1P2(P1, (!group && P2 == P2_LAST_WITH_TXID) ? P2_LAST : P2);
 
     if (rx < OFFSET_DATA) {
         THROW(APDU_CODE_WRONG_LENGTH);
@@ -77,20 +94,21 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx)
 
     switch (payloadType) {
         case P1_INIT:
-            tx_initialize();
-            tx_reset();
+            chunk_start(group);
             tx_initialized = true;
             if (P1 == P1_FIRST_ACCOUNT_ID) {
                 extractHDPath();
                 accountIdSize = ACCOUNT_ID_LENGTH;
             }
-            tx_append((unsigned char*)tmpBuff, 2);
+            if (!group) {
+                tx_append((unsigned char*)tmpBuff, 2);
+            }
 
             if (rx < (OFFSET_DATA + accountIdSize)) {
                 THROW(APDU_CODE_WRONG_LENGTH);
             }
 
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA + accountIdSize]), rx - (OFFSET_DATA + accountIdSize));
+            added = chunk_append(&(G_io_apdu_buffer[OFFSET_DATA + accountIdSize]), rx - (OFFSET_DATA + accountIdSize));
             if (added != rx - (OFFSET_DATA + accountIdSize)) {
                 tx_initialized = false;
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
@@ -98,10 +116,10 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx)
             return false;
 
         case P1_ADD:
-            if (!tx_initialized) {
+            if (!tx_initialized || tx_group != group) {
                 THROW(APDU_CODE_TX_NOT_INITIALIZED);
             }
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
+            added = chunk_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
             if (added != rx - OFFSET_DATA) {
                 tx_initialized = false;
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
@@ -109,10 +127,10 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx)
             return false;
 
         case P1_LAST:
-            if (!tx_initialized) {
+            if (!tx_initialized || tx_group != group) {
                 THROW(APDU_CODE_TX_NOT_INITIALIZED);
             }
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
+            added = chunk_append(&(G_io_apdu_buffer[OFFSET_DATA]), rx - OFFSET_DATA);
             tx_initialized = false;
             if (added != rx - OFFSET_DATA) {
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
@@ -120,14 +138,15 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx)
             return true;
 
         case P1_SINGLE_CHUNK:
-            tx_initialize();
-            tx_reset();
+            chunk_start(group);
             if (P1 == P1_FIRST_ACCOUNT_ID) {
                 extractHDPath();
                 accountIdSize = ACCOUNT_ID_LENGTH;
             }
-            tx_append((unsigned char*)tmpBuff, 2);
-            added = tx_append(&(G_io_apdu_buffer[OFFSET_DATA + accountIdSize]), rx - (OFFSET_DATA + accountIdSize));
+            if (!group) {
+                tx_append((unsigned char*)tmpBuff, 2);
+            }
+            added = chunk_append(&(G_io_apdu_buffer[OFFSET_DATA + accountIdSize]), rx - (OFFSET_DATA + accountIdSize));
             tx_initialized = false;
             if (added != rx - (OFFSET_DATA + accountIdSize)) {
                 THROW(APDU_CODE_OUTPUT_BUFFER_TOO_SMALL);
@@ -140,13 +159,19 @@ __Z_INLINE bool process_chunk(__Z_UNUSED volatile uint32_t *tx, uint32_t rx)
 
 __Z_INLINE void handle_sign_msgpack(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx)
 {
-    if (!process_chunk(tx, rx)) {
+    const bool last_chunk = process_chunk(tx, rx, false);
+
+    // Malformed input is rejected at the chunk where it shows up
+    const char *error_msg = tx_stream_error();
+    if (error_msg != NULL) {
+        tx_initialized = false;
+    } else if (!last_chunk) {
         THROW(APDU_CODE_OK);
+    } else {
+        error_msg = tx_parse();
+        CHECK_APP_CANARY()
     }
 
-    const char *error_msg = tx_parse();
-    CHECK_APP_CANARY()
-
     if (error_msg != NULL) {
         int error_msg_length = strlen(error_msg);
         memcpy(G_io_apdu_buffer, error_msg, error_msg_length);
@@ -154,11 +179,96 @@ __Z_INLINE void handle_sign_msgpack(volatile uint32_t *flags, volatile uint32_t
         THROW(APDU_CODE_DATA_INVALID);
     }
 
+    action_signWithTxid = G_io_apdu_buffer[OFFSET_P2] == P2_LAST_WITH_TXID;
     view_review_init(tx_getItem, tx_getNumItems, app_sign);
     view_review_show(REVIEW_TXN);
     *flags |= IO_ASYNCH_REPLY;
 }
 
+__Z_INLINE void handle_group_signature(volatile uint32_t *tx)
+{
+    const uint8_t *message = NULL;
+    uint16_t messageLength = 0;
+    uint8_t txnId[TXID_LEN];
+
+    // Only members in the sign mask of the approved group, with the account it was uploaded for
+    if (tx_group_get_txn(G_io_apdu_buffer[OFFSET_P2], &message, &messageLength, txnId) != zxerr_ok) {
+        THROW(APDU_CODE_COMMAND_NOT_ALLOWED);
+    }
+
+    // hdPath stays the account of the last INS_GET_ADDRESS for later INS_SIGN_MSGPACK
+    const zxerr_t err = crypto_signWithPath(group_hdPath, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 3,
+                                            message, messageLength);
+    if (err != zxerr_ok) {
+        THROW(APDU_CODE_SIGN_VERIFY_ERROR);
+    }
+
+    // Same layout as the INS_SIGN_MSGPACK reply with P2_LAST_WITH_TXID
+    MEMCPY(G_io_apdu_buffer + SK_LEN_25519, txnId, TXID_LEN);
+    *tx = SK_LEN_25519 + TXID_LEN;
+    THROW(APDU_CODE_OK);
+}
+
+__Z_INLINE void handle_sign_group(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx)
+{
+    if (G_io_apdu_buffer[OFFSET_P1] == P1_GROUP_SIGNATURE) {
+        handle_group_signature(tx);
+        return;
+    }
+
+    const bool last_chunk = process_chunk(tx, rx, true);
+
+    const char *error_msg = tx_group_stream_error();
+    if (error_msg != NULL) {
+        tx_initialized = false;
+    } else if (!last_chunk) {
+        THROW(APDU_CODE_OK);
+    } else {
+        error_msg = tx_group_parse();
+        CHECK_APP_CANARY()
+    }
+
+    if (error_msg != NULL) {
+        int error_msg_length = strlen(error_msg);
+        memcpy(G_io_apdu_buffer, error_msg, error_msg_length);
+        *tx += (error_msg_length);
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+
+    // Other instructions may derive another account before the signatures are requested
+    MEMCPY(group_hdPath, hdPath, sizeof(group_hdPath));
+
+    view_review_init(tx_group_getItem, tx_group_getNumItems, app_approve_group);
+    view_review_show(REVIEW_TXN);
+    *flags |= IO_ASYNCH_REPLY;
+}
+
+__Z_INLINE void handle_get_address_range(__Z_UNUSED volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx)
+{
+    if (G_io_apdu_buffer[OFFSET_DATA_LEN] != ACCOUNT_ID_LENGTH + 1 || rx < OFFSET_DATA + ACCOUNT_ID_LENGTH + 1) {
+        THROW(APDU_CODE_WRONG_LENGTH);
+    }
+
+    const bool withAddress = G_io_apdu_buffer[OFFSET_P1] == P1_RANGE_WITH_ADDRESS;
+    const uint8_t count = G_io_apdu_buffer[OFFSET_DATA + ACCOUNT_ID_LENGTH];
+    if (count == 0) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+    extractHDPath();
+
+    uint16_t replyLen = 0;
+    const zxerr_t err = crypto_fillPublicKeys(count, withAddress, G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 2, &replyLen);
+    if (err == zxerr_out_of_bounds) {
+        THROW(APDU_CODE_DATA_INVALID);
+    }
+    if (err != zxerr_ok) {
+        THROW(APDU_CODE_UNKNOWN);
+    }
+
+    *tx = replyLen;
+    THROW(APDU_CODE_OK);
+}
+
 __Z_INLINE void handle_get_public_key(volatile uint32_t *flags, volatile uint32_t *tx, __Z_UNUSED uint32_t rx)
 {
     const uint8_t requireConfirmation = G_io_apdu_buffer[OFFSET_P1];
@@ -229,13 +339,25 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                 THROW(APDU_CODE_WRONG_LENGTH);
             }
 
+            // The key kept for the last account does not outlive a device lock, nor the group
+            // signatures it was kept for
             const uint8_t ins = G_io_apdu_buffer[OFFSET_INS];
+            const bool groupSignature = ins == INS_SIGN_GROUP && G_io_apdu_buffer[OFFSET_P1] == P1_GROUP_SIGNATURE;
+            if (os_global_pin_is_validated() != BOLOS_UX_OK || !groupSignature) {
+                crypto_clearKeyCache();
+            }
+
             switch (ins) {
                 case INS_SIGN_MSGPACK:
                     CHECK_PIN_VALIDATED()
                     handle_sign_msgpack(flags, tx, rx);
                     break;
 
+                case INS_SIGN_GROUP:
+                    CHECK_PIN_VALIDATED()
+                    handle_sign_group(flags, tx, rx);
+                    break;
+
                 case INS_GET_ADDRESS:
                 case INS_GET_PUBLIC_KEY: {
                     CHECK_PIN_VALIDATED()
@@ -243,6 +365,12 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
                     break;
                 }
 
+                case INS_GET_ADDRESS_RANGE: {
+                    CHECK_PIN_VALIDATED()
+                    handle_get_address_range(flags, tx, rx);
+                    break;
+                }
+
                 case INS_GET_VERSION: {
                     handle_getversion(flags, tx);
                     THROW(APDU_CODE_OK);
@@ -255,6 +383,7 @@ void handleApdu(volatile uint32_t *flags, volatile uint32_t *tx, uint32_t rx) {
         }
         CATCH(EXCEPTION_IO_RESET)
         {
+            crypto_clearKeyCache();
             THROW(EXCEPTION_IO_RESET);
         }
         CATCH_OTHER(e)
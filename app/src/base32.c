@@ -19,8 +19,75 @@
 
 #include "base32.h"
 
+#include <stdbool.h>
 #include <string.h>
 
+static const char BASE32_ALPHABET[32] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '2', '3', '4', '5', '6', '7',
+};
+
+// Characters emitted for a trailing group of 0..4 bytes
+static const uint8_t BASE32_TAIL_CHARS[BASE32_BLOCK_BYTES] = {0, 2, 4, 5, 7};
+
+// 5 input bytes -> 8 output characters, one table lookup per character
+static inline void base32_encode_block(const uint8_t *in, char *out) {
+    const uint64_t bits = ((uint64_t)in[0] << 32) | ((uint64_t)in[1] << 24) |
+                          ((uint64_t)in[2] << 16) | ((uint64_t)in[3] << 8) | (uint64_t)in[4];
+    out[0] = BASE32_ALPHABET[(bits >> 35) & 0x1F];
+    out[1] = BASE32_ALPHABET[(bits >> 30) & 0x1F];
+    out[2] = BASE32_ALPHABET[(bits >> 25) & 0x1F];
+    out[3] = BASE32_ALPHABET[(bits >> 20) & 0x1F];
+    out[4] = BASE32_ALPHABET[(bits >> 15) & 0x1F];
+    out[5] = BASE32_ALPHABET[(bits >> 10) & 0x1F];
+    out[6] = BASE32_ALPHABET[(bits >> 5) & 0x1F];
+    out[7] = BASE32_ALPHABET[bits & 0x1F];
+}
+
+// Last partial group, zero padded on the right as the bitwise encoder does
+static inline uint32_t base32_encode_tail(const uint8_t *in, uint32_t length, char *out) {
+    uint8_t block[BASE32_BLOCK_BYTES] = {0};
+    char chars[BASE32_BLOCK_CHARS];
+    memcpy(block, in, length);
+    base32_encode_block(block, chars);
+    memcpy(out, chars, BASE32_TAIL_CHARS[length]);
+    return BASE32_TAIL_CHARS[length];
+}
+
+// Bit by bit encoder, only used when the output does not fit so that the
+// truncated contents left in result stay the same as they always were
+static uint32_t base32_encode_truncated(const uint8_t *data,
+                                        uint32_t length,
+                                        char *result,
+                                        uint32_t resultLen) {
+    uint32_t count = 0;
+    uint32_t buffer = data[0];
+    uint32_t next = 1;
+    uint32_t bitsLeft = 8;
+    while (count < resultLen && (bitsLeft > 0 || next < length)) {
+        if (bitsLeft < 5) {
+            if (next < length) {
+                buffer <<= 8;
+                buffer |= data[next++] & 0xFF;
+                bitsLeft += 8;
+            } else {
+                uint32_t pad = 5u - bitsLeft;
+                buffer <<= pad;
+                bitsLeft += pad;
+            }
+        }
+        uint32_t index = 0x1Fu & (buffer >> (bitsLeft - 5u));
+        bitsLeft -= 5;
+        result[count++] = BASE32_ALPHABET[index];
+    }
+    if (count < resultLen) {
+        result[count] = '\000';
+    } else{
+        count = 0;
+    }
+    return count;
+}
+
 uint32_t base32_encode(const uint8_t *data,
                        uint32_t length,
                        char *result,
@@ -29,32 +96,133 @@ uint32_t base32_encode(const uint8_t *data,
         length > (1 << 28) || length == 0 || resultLen == 0) {
         return 0;
     }
-    uint32_t count = 0;
-    if (length > 0) {
-        uint32_t buffer = data[0];
-        uint32_t next = 1;
-        uint32_t bitsLeft = 8;
-        while (count < resultLen && (bitsLeft > 0 || next < length)) {
-            if (bitsLeft < 5) {
-                if (next < length) {
-                    buffer <<= 8;
-                    buffer |= data[next++] & 0xFF;
-                    bitsLeft += 8;
-                } else {
-                    uint32_t pad = 5u - bitsLeft;
-                    buffer <<= pad;
-                    bitsLeft += pad;
-                }
-            }
-            uint32_t index = 0x1Fu & (buffer >> (bitsLeft - 5u));
-            bitsLeft -= 5;
-            result[count++] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"[index];
+
+    const uint32_t blocks = length / BASE32_BLOCK_BYTES;
+    const uint32_t tail = length % BASE32_BLOCK_BYTES;
+    const uint32_t outLen = blocks * BASE32_BLOCK_CHARS + BASE32_TAIL_CHARS[tail];
+    if (outLen >= resultLen) {
+        return base32_encode_truncated(data, length, result, resultLen);
+    }
+
+    char *out = result;
+    for (uint32_t i = 0; i < blocks; i++) {
+        base32_encode_block(data, out);
+        data += BASE32_BLOCK_BYTES;
+        out += BASE32_BLOCK_CHARS;
+    }
+    if (tail > 0) {
+        out += base32_encode_tail(data, tail, out);
+    }
+    *out = '\000';
+    return outLen;
+}
+
+uint32_t base32_encode_address(const uint8_t *data, char *result, uint32_t resultLen) {
+    if (data == NULL || result == NULL || resultLen <= BASE32_ADDRESS_LEN) {
+        return base32_encode(data, BASE32_ADDRESS_INPUT_LEN, result, resultLen);
+    }
+
+    // 36 bytes = 7 full groups + 1 byte -> 56 + 2 characters
+    base32_encode_block(data, result);
+    base32_encode_block(data + 5, result + 8);
+    base32_encode_block(data + 10, result + 16);
+    base32_encode_block(data + 15, result + 24);
+    base32_encode_block(data + 20, result + 32);
+    base32_encode_block(data + 25, result + 40);
+    base32_encode_block(data + 30, result + 48);
+    result[56] = BASE32_ALPHABET[data[35] >> 3];
+    result[57] = BASE32_ALPHABET[(data[35] << 2) & 0x1F];
+    result[58] = '\000';
+    return BASE32_ADDRESS_LEN;
+}
+
+// 5-bit value of each alphabet character, 0xFF for anything else
+static const uint8_t BASE32_DECODE[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+// Bytes produced by a trailing group of 0..7 characters, 0 where no valid
+// encoding ends with that many characters
+static const uint8_t BASE32_TAIL_BYTES[BASE32_BLOCK_CHARS] = {0, 0, 1, 0, 2, 3, 0, 4};
+
+// 8 characters -> 5 bytes. Returns false on characters outside the alphabet
+static inline bool base32_decode_block(const char *in, uint8_t *out) {
+    const uint8_t c0 = BASE32_DECODE[(uint8_t) in[0]];
+    const uint8_t c1 = BASE32_DECODE[(uint8_t) in[1]];
+    const uint8_t c2 = BASE32_DECODE[(uint8_t) in[2]];
+    const uint8_t c3 = BASE32_DECODE[(uint8_t) in[3]];
+    const uint8_t c4 = BASE32_DECODE[(uint8_t) in[4]];
+    const uint8_t c5 = BASE32_DECODE[(uint8_t) in[5]];
+    const uint8_t c6 = BASE32_DECODE[(uint8_t) in[6]];
+    const uint8_t c7 = BASE32_DECODE[(uint8_t) in[7]];
+    if ((c0 | c1 | c2 | c3 | c4 | c5 | c6 | c7) & 0xE0u) {
+        return false;
+    }
+    const uint64_t bits = ((uint64_t) c0 << 35) | ((uint64_t) c1 << 30) | ((uint64_t) c2 << 25) |
+                          ((uint64_t) c3 << 20) | ((uint64_t) c4 << 15) | ((uint64_t) c5 << 10) |
+                          ((uint64_t) c6 << 5) | (uint64_t) c7;
+    out[0] = (uint8_t) (bits >> 32);
+    out[1] = (uint8_t) (bits >> 24);
+    out[2] = (uint8_t) (bits >> 16);
+    out[3] = (uint8_t) (bits >> 8);
+    out[4] = (uint8_t) bits;
+    return true;
+}
+
+uint32_t base32_decode(const char *encoded,
+                       uint32_t length,
+                       uint8_t *result,
+                       uint32_t resultLen) {
+    if (encoded == NULL || result == NULL || length == 0 || length > (1 << 28)) {
+        return 0;
+    }
+
+    const uint32_t blocks = length / BASE32_BLOCK_CHARS;
+    const uint32_t tail = length % BASE32_BLOCK_CHARS;
+    const uint32_t tailBytes = BASE32_TAIL_BYTES[tail];
+    if (tail > 0 && tailBytes == 0) {
+        return 0;
+    }
+    const uint32_t outLen = blocks * BASE32_BLOCK_BYTES + tailBytes;
+    if (outLen > resultLen) {
+        return 0;
+    }
+
+    uint8_t *out = result;
+    for (uint32_t i = 0; i < blocks; i++) {
+        if (!base32_decode_block(encoded, out)) {
+            return 0;
         }
+        encoded += BASE32_BLOCK_CHARS;
+        out += BASE32_BLOCK_BYTES;
     }
-    if (count < resultLen) {
-        result[count] = '\000';
-    } else{
-        count = 0;
+
+    if (tail > 0) {
+        // Pad with 'A' (zero bits). The bits the encoder padded must be zero
+        // as well, so every byte string has exactly one accepted encoding
+        char chars[BASE32_BLOCK_CHARS];
+        uint8_t block[BASE32_BLOCK_BYTES];
+        memset(chars, 'A', sizeof(chars));
+        memcpy(chars, encoded, tail);
+        if (!base32_decode_block(chars, block) || block[tailBytes] != 0) {
+            return 0;
+        }
+        memcpy(out, block, tailBytes);
     }
-    return count;
+    return outLen;
 }
@@ -35,11 +35,11 @@
 //   ABCDEFGHIJKLMNOPQRSTUVWXYZ234567
 // This alphabet is documented in RFC 4648/3548
 //
-// We allow white-space and hyphens, but all other characters are considered
-// invalid.
+// Output is unpadded. The decoder accepts only the upper case alphabet; padding,
+// white-space and hyphens are rejected.
 //
-// All functions return the number of output bytes or -1 on error. If the
-// output buffer is too small, the result will silently be truncated.
+// All functions return the number of output bytes (excluding the encoder's NUL
+// terminator), or 0 on invalid input or when the output buffer is too small.
 
 #pragma once
 
@@ -49,9 +49,27 @@
 extern "C" {
 #endif
 
+// Every 5 input bytes map to exactly 8 output characters
+#define BASE32_BLOCK_BYTES 5u
+#define BASE32_BLOCK_CHARS 8u
+
+// Checksummed public key (32 + 4 bytes) and its unpadded encoding
+#define BASE32_ADDRESS_INPUT_LEN 36u
+#define BASE32_ADDRESS_LEN 58u
+
 uint32_t base32_encode(const uint8_t *data, unsigned int length,
                        char *result, uint32_t bufSize) __attribute__((visibility("hidden")));
 
+// Same output as base32_encode(data, BASE32_ADDRESS_INPUT_LEN, ...), unrolled
+// for the fixed address length
+uint32_t base32_encode_address(const uint8_t *data,
+                               char *result, uint32_t bufSize) __attribute__((visibility("hidden")));
+
+// Inverse of base32_encode. The unused trailing bits must be zero, so each
+// byte string has a single accepted encoding
+uint32_t base32_decode(const char *encoded, uint32_t length,
+                       uint8_t *result, uint32_t bufSize) __attribute__((visibility("hidden")));
+
 #ifdef __cplusplus
 }
 #endif
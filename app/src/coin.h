@@ -44,6 +44,10 @@ extern "C" {
 #define MAX_SIGN_SIZE 256u
 #define BLAKE2B_DIGEST_SIZE 32u
 
+// SHA512/256 of "TX" || msgpack, shown as unpadded base32
+#define TXID_LEN 32u
+#define TXID_BASE32_LEN 52u
+
 #define COIN_AMOUNT_DECIMAL_PLACES 6
 #define COIN_TICKER "ALGO "
 
@@ -67,13 +71,24 @@ extern "C" {
 #define P1_MORE  0x80
 #define P1_WITH_REQUEST_USER_APPROVAL  0x80
 
+// INS_SIGN_GROUP: signature of member P2 of the approved group
+#define P1_GROUP_SIGNATURE 0x02
+
+// INS_GET_ADDRESS_RANGE: follow each public key with its address
+#define P1_RANGE_WITH_ADDRESS 0x01
+
 #define P2_LAST  0x00
 #define P2_MORE  0x80
 
+// INS_SIGN_MSGPACK: last chunk, the transaction ID follows the signature in the reply
+#define P2_LAST_WITH_TXID 0x01
+
 #define INS_GET_VERSION     0x00
 #define INS_GET_PUBLIC_KEY  0x03
 #define INS_GET_ADDRESS     0x04
+#define INS_GET_ADDRESS_RANGE 0x05
 #define INS_SIGN_MSGPACK    0x08
+#define INS_SIGN_GROUP      0x09
 
 #ifdef __cplusplus
 }
@@ -24,6 +24,7 @@
 #include "zxerror.h"
 
 extern uint16_t action_addrResponseLen;
+extern bool action_signWithTxid;
 
 __Z_INLINE zxerr_t app_fill_address() {
     // Put data directly in the apdu buffer
@@ -48,12 +49,32 @@ __Z_INLINE void app_sign() {
     if (err != zxerr_ok) {
         set_code(G_io_apdu_buffer, 0, APDU_CODE_SIGN_VERIFY_ERROR);
         io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
+    } else if (action_signWithTxid) {
+        // The transaction ID follows the signature
+        MEMCPY(G_io_apdu_buffer + SK_LEN_25519, tx_get_txid(), TXID_LEN);
+        set_code(G_io_apdu_buffer, SK_LEN_25519 + TXID_LEN, APDU_CODE_OK);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, SK_LEN_25519 + TXID_LEN + 2);
     } else {
         set_code(G_io_apdu_buffer, SK_LEN_25519, APDU_CODE_OK);
         io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, SK_LEN_25519 + 2);
     }
 }
 
+__Z_INLINE void app_approve_group() {
+    // Replies with the group ID, signatures are then requested one member at a time
+    const uint16_t replyLen = tx_group_approve(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE - 2);
+
+    if (replyLen == 0) {
+        set_code(G_io_apdu_buffer, 0, APDU_CODE_EXECUTION_ERROR);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 2);
+    } else {
+        // Members are signed with one account, derived once for the whole group
+        crypto_openKeySession();
+        set_code(G_io_apdu_buffer, replyLen, APDU_CODE_OK);
+        io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, replyLen + 2);
+    }
+}
+
 __Z_INLINE void app_reject() {
     MEMZERO(G_io_apdu_buffer, IO_APDU_BUFFER_SIZE);
     set_code(G_io_apdu_buffer, 0, APDU_CODE_COMMAND_NOT_ALLOWED);
@@ -16,9 +16,22 @@
 ********************************************************************************/
 #include "app_main.h"
 #include "view.h"
+#include "crypto.h"
 
 #include <os_io_seproxyhal.h>
 
+// io_event belongs to ledger-zxlib, the app is linked with --wrap=io_event (see app/Makefile)
+// so a lock is seen on the next ticker event instead of on the next APDU
+unsigned char __real_io_event(unsigned char channel);
+
+unsigned char __wrap_io_event(unsigned char channel) {
+    if (G_io_seproxyhal_spi_buffer[0] == SEPROXYHAL_TAG_TICKER_EVENT &&
+        os_global_pin_is_validated() != BOLOS_UX_OK) {
+        crypto_clearKeyCache();
+    }
+    return __real_io_event(channel);
+}
+
 __attribute__((section(".boot"))) int
 main(void) {
     // exit critical section
@@ -37,7 +50,9 @@ main(void) {
         CATCH_OTHER(e)
         {}
         FINALLY
-        {}
+        {
+            crypto_clearKeyCache();
+        }
     }
     END_TRY;
 }
@@ -31,11 +31,29 @@ parser_error_t parser_parse(parser_context_t *ctx,
                             size_t dataLen,
                             parser_tx_t *tx_obj);
 
+//// starts scanning a tx buffer that is still being received
+parser_error_t parser_streamInit(parser_stream_t *stream, parser_context_t *ctx);
+
+//// scans the bytes received since the last call, data holds the whole buffer so far
+parser_error_t parser_streamAppend(parser_stream_t *stream,
+                                   const uint8_t *data,
+                                   size_t dataLen);
+
+//// parses a tx buffer that was fully scanned by parser_streamAppend
+parser_error_t parser_parseStreamed(parser_context_t *ctx,
+                                    const parser_stream_t *stream,
+                                    const uint8_t *data,
+                                    size_t dataLen,
+                                    parser_tx_t *tx_obj);
+
 //// verifies tx fields
 parser_error_t parser_validate(parser_context_t *ctx);
 
+//// verifies tx fields without formatting them (same checks as parser_validate)
+parser_error_t parser_validateStructure(parser_context_t *ctx);
+
 //// returns the number of items in the current parsing context
-parser_error_t parser_getNumItems(uint8_t *num_items);
+parser_error_t parser_getNumItems(const parser_context_t *ctx, uint8_t *num_items);
 
 // retrieves a readable output for each field / page
 parser_error_t parser_getItem(parser_context_t *ctx,
@@ -44,7 +62,7 @@ parser_error_t parser_getItem(parser_context_t *ctx,
                               char *outVal, uint16_t outValLen,
                               uint8_t pageIdx, uint8_t *pageCount);
 
-parser_error_t getItem(uint8_t index, uint8_t* displayIdx);
+parser_error_t getItem(const parser_context_t *ctx, uint8_t index, uint8_t* displayIdx);
 
 parser_error_t parser_getTxnText(parser_context_t *ctx, char *outVal, uint16_t outValLen);
 
@@ -20,6 +20,7 @@ extern "C" {
 #endif
 
 #include "parser_txdef.h"
+#include "msgpack.h"
 #include <stdint.h>
 #include <stddef.h>
 
@@ -82,15 +83,158 @@ typedef enum {
     parser_msgpack_array_too_big,
     parser_msgpack_array_type_expected,
 
+    parser_msgpack_depth_exceeded,
+
+    // Transaction groups
+    parser_group_id_mismatch,
+
 } parser_error_t;
 
+// An application call, the longest transaction, has 23 top-level keys
+#define MAX_TOP_LEVEL_KEYS 24
+#define MAX_KEY_LEN 20
+
+// Location of a top-level key and its value inside the parsed buffer
+typedef struct {
+    uint16_t keyOffset;
+    uint16_t valueLen;
+    uint8_t keyLen;
+    uint8_t keyId;      // parser_key_id_e, KEYID_UNKNOWN for keys the parser does not use
+} parser_key_entry_t;
+
+// Values are read right after their key
+#define KEY_VALUE_OFFSET(entry) ((uint16_t) ((entry)->keyOffset + (entry)->keyLen))
+
+#define MAX_ITEM_ARRAY 50
+
+// Ordered list of display items produced while parsing a transaction
+typedef struct {
+    uint8_t num_items;
+    uint8_t common_num_items;
+    uint8_t tx_num_items;
+    uint8_t itemIndex;
+    uint8_t itemArray[MAX_ITEM_ARRAY];
+} parser_display_plan_t;
+
+// Rendered addresses, digests and paged items are kept in the context between page requests.
+// Nano S has no RAM to spare for them: its caches only live on the stack while one page is
+// formatted, and every page runs the formatter.
+#if !defined(TARGET_NANOS)
+#define PARSER_RENDER_CACHE
+#endif
+
+// Addresses rendered while displaying the current transaction. A transaction
+// shows at most 6 distinct addresses (sender, rekey and 4 asset params or app accounts)
+#if defined(PARSER_RENDER_CACHE)
+#define ADDRESS_CACHE_ENTRIES 6
+#else
+#define ADDRESS_CACHE_ENTRIES 1
+#endif
+#define ADDRESS_CACHE_KEY_LEN 32        // PK_LEN_25519
+#define ADDRESS_CACHE_TEXT_LEN (58 + 1) // BASE32_ADDRESS_LEN and terminator
+
+typedef struct {
+    uint8_t keys[ADDRESS_CACHE_ENTRIES][ADDRESS_CACHE_KEY_LEN];
+    char text[ADDRESS_CACHE_ENTRIES][ADDRESS_CACHE_TEXT_LEN];
+    uint8_t count;
+    uint8_t next;       // Entry replaced once the cache is full
+} parser_address_cache_t;
+
+// SHA-256 of the approval/clear programs and app args, shown as base64. With an
+// entry per item every digest is computed once per parse
+#if defined(PARSER_RENDER_CACHE)
+#define DIGEST_CACHE_ENTRIES (MAX_ARG + 2)
+#else
+#define DIGEST_CACHE_ENTRIES 1
+#endif
+#define DIGEST_CACHE_HASH_LEN 32        // CX_SHA256_SIZE
+
+typedef struct {
+    const uint8_t *data[DIGEST_CACHE_ENTRIES];  // Hashed bytes in the parsed buffer
+    uint16_t dataLen[DIGEST_CACHE_ENTRIES];
+    uint8_t hash[DIGEST_CACHE_ENTRIES][DIGEST_CACHE_HASH_LEN];
+    uint8_t count;
+    uint8_t next;       // Entry replaced once the cache is full
+} parser_digest_cache_t;
+
+// Last item that spans several pages. Once the user comes back to it (a second
+// page request, or a third one for two page items) the whole value is formatted
+// here, and every later page is cut from it without running the formatter again.
+// The longest paged value is an asset URL (ASA_URL_MAX_LENGTH)
+#define RENDER_KEY_LEN 32
+#define RENDER_VALUE_LEN 128
+
+typedef enum {
+    RENDER_NONE = 0,
+    RENDER_SHOWN,       // One page shown, value not kept yet
+    RENDER_REVISITED,   // Both pages of a two page item shown
+    RENDER_READY,       // key and value hold the full item
+    RENDER_UNCACHED,    // Does not fit here, every page runs the formatter
+} parser_render_state_e;
+
+typedef struct {
+    char key[RENDER_KEY_LEN];
+    char value[RENDER_VALUE_LEN];
+    uint16_t valueLen;
+    uint8_t keyLen;
+    uint16_t outKeyLen;     // Widths the item was requested with
+    uint16_t outValLen;
+    uint8_t displayIdx;
+    uint8_t pageCount;
+    uint8_t state;          // parser_render_state_e
+} parser_rendered_item_t;
+
 typedef struct {
     const uint8_t *buffer;
     uint16_t bufferLen;
     uint16_t offset;
     parser_tx_t *parser_tx_obj;
+
+    parser_display_plan_t display;
+
+#if defined(PARSER_RENDER_CACHE)
+    // Filled on first use by _renderAddress, cleared on every parse
+    parser_address_cache_t addresses;
+    // Filled on first use by _renderDigest, cleared on every parse
+    parser_digest_cache_t digests;
+    // Filled by parser_getItem, cleared on every parse
+    parser_rendered_item_t rendered;
+#endif
+
+    // Top-level map index, built in a single pass by _read
+    parser_key_entry_t keys[MAX_TOP_LEVEL_KEYS];
+    uint8_t numKeys;
+    // Bit n set when the key with parser_key_id_e n is present
+    uint64_t keyMask;
+
+    // Bytes consumed by the msgpack readers since parser_init
+    uint32_t bytesScanned;
 } parser_context_t;
 
+// Incremental scan of the top-level map while the transaction is still being received.
+// The key index of ctx is built in place, so only the field readers run once the upload completes.
+typedef struct {
+    parser_context_t *ctx;
+
+    uint16_t offset;        // Bytes scanned so far
+    uint16_t keysLeft;      // Top-level entries still to come
+    uint16_t fieldValue;    // Length field of the current token, read big endian
+    uint32_t skipLeft;      // Payload bytes of the current token still to come
+
+    // Values left at each nesting level of the current top-level value
+    uint32_t remaining;
+    uint32_t pending[MSGPACK_MAX_DEPTH];
+    uint8_t depth;
+
+    uint8_t state;
+    uint8_t token;          // Header state that started the current token
+    uint8_t header;         // Type byte of the current token
+    uint8_t fieldLeft;      // Length field bytes still to come
+
+    // First error found, every later call returns it
+    parser_error_t error;
+} parser_stream_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,8 +18,13 @@
 #include "apdu_codes.h"
 #include "buffering.h"
 #include "parser.h"
+#include "parser_group.h"
 #include <string.h>
 #include "zxmacros.h"
+#include "zxformat.h"
+#include "app_mode.h"
+#include "base32.h"
+#include "sha512.h"
 
 #if defined(TARGET_NANOX) || defined(TARGET_NANOS2) || defined(TARGET_STAX)
 #define RAM_BUFFER_SIZE 8192
@@ -27,6 +32,10 @@
 #elif defined(TARGET_NANOS)
 #define RAM_BUFFER_SIZE 256
 #define FLASH_BUFFER_SIZE 8192
+#else
+// Host builds (tests/sdk_standin), sized as the larger devices
+#define RAM_BUFFER_SIZE 8192
+#define FLASH_BUFFER_SIZE 16384
 #endif
 
 // Ram
@@ -41,10 +50,25 @@ typedef struct
 #if defined(TARGET_NANOS) || defined(TARGET_NANOX) || defined(TARGET_NANOS2) || defined(TARGET_STAX)
 storage_t NV_CONST N_appdata_impl __attribute__((aligned(64)));
 #define N_appdata (*(NV_VOLATILE storage_t *)PIC(&N_appdata_impl))
+#else
+static storage_t N_appdata;
 #endif
 
 static parser_tx_t parser_tx_obj;
 static parser_context_t ctx_parsed_tx;
+static parser_stream_t stream_tx;
+
+// Running transaction ID hash, fed with every appended chunk
+static SHA512_256_CTX txid_ctx;
+static uint8_t txid[TXID_LEN];
+
+// Group uploaded with INS_SIGN_GROUP. It shares the buffer with single transactions,
+// so every reset ends it and signatures are only released for the approved upload.
+static parser_group_t group_tx;
+static bool group_approved = false;
+
+// 'TX' is prepended to input buffer
+#define TX_PREFIX_LEN 2
 
 void tx_initialize()
 {
@@ -58,11 +82,25 @@ void tx_initialize()
 void tx_reset()
 {
     buffering_reset();
+    parser_streamInit(&stream_tx, &ctx_parsed_tx);
+    SHA512_256_Init(&txid_ctx);
+    MEMZERO(txid, sizeof(txid));
+    parser_groupInit(&group_tx);
+    group_approved = false;
 }
 
 uint32_t tx_append(unsigned char *buffer, uint32_t length)
 {
-    return buffering_append(buffer, length);
+    const uint32_t added = buffering_append(buffer, length);
+    SHA512_256_Update(&txid_ctx, buffer, added);
+
+    // Scan what arrived so far, the buffer may have moved from ram to flash
+    if (tx_get_buffer_length() > TX_PREFIX_LEN) {
+        parser_streamAppend(&stream_tx,
+                            tx_get_buffer() + TX_PREFIX_LEN,
+                            tx_get_buffer_length() - TX_PREFIX_LEN);
+    }
+    return added;
 }
 
 uint32_t tx_get_buffer_length()
@@ -75,14 +113,36 @@ uint8_t *tx_get_buffer()
     return buffering_get_buffer()->data;
 }
 
+const char *tx_stream_error()
+{
+    const parser_error_t err = stream_tx.error;
+    if (err != parser_ok)
+    {
+        return parser_getErrorDescription(err);
+    }
+    return NULL;
+}
+
+const uint8_t *tx_get_txid()
+{
+    return txid;
+}
+
 const char *tx_parse()
 {
     MEMZERO(&parser_tx_obj, sizeof(parser_tx_obj));
 
-    uint8_t err = parser_parse(&ctx_parsed_tx,
-                               tx_get_buffer()+2,   // 'TX' is prepended to input buffer
-                               tx_get_buffer_length(),
-                               &parser_tx_obj);
+    // The whole signed message went through tx_append, 'TX' prefix included
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256_Final(&txid_ctx, digest);
+    MEMCPY(txid, digest, sizeof(txid));
+
+    // The key index was built by tx_append while the chunks arrived
+    uint8_t err = parser_parseStreamed(&ctx_parsed_tx,
+                                       &stream_tx,
+                                       tx_get_buffer() + TX_PREFIX_LEN,
+                                       tx_get_buffer_length() - TX_PREFIX_LEN,
+                                       &parser_tx_obj);
     CHECK_APP_CANARY()
 
     if (err != parser_ok)
@@ -90,7 +150,7 @@ const char *tx_parse()
         return parser_getErrorDescription(err);
     }
 
-    err = parser_validate(&ctx_parsed_tx);
+    err = parser_validateStructure(&ctx_parsed_tx);
     CHECK_APP_CANARY()
 
     if (err != parser_ok)
@@ -108,10 +168,29 @@ void tx_parse_reset()
 
 zxerr_t tx_getNumItems(uint8_t *num_items)
 {
-    parser_error_t err = parser_getNumItems(num_items);
+    parser_error_t err = parser_getNumItems(&ctx_parsed_tx, num_items);
     if (err != parser_ok) {
         return zxerr_unknown;
     }
+
+    // Expert mode closes the review with the transaction ID
+    if (app_mode_expert()) {
+        (*num_items)++;
+    }
+    return zxerr_ok;
+}
+
+static zxerr_t tx_getTxIdItem(char *outKey, uint16_t outKeyLen,
+                              char *outVal, uint16_t outValLen,
+                              uint8_t pageIdx, uint8_t *pageCount)
+{
+    char buff[TXID_BASE32_LEN + 1] = {0};
+    if (base32_encode(txid, sizeof(txid), buff, sizeof(buff)) != TXID_BASE32_LEN) {
+        return zxerr_encoding_failed;
+    }
+
+    snprintf(outKey, outKeyLen, "Txn ID");
+    pageString(outVal, outValLen, buff, pageIdx, pageCount);
     return zxerr_ok;
 }
 
@@ -135,6 +214,10 @@ zxerr_t tx_getItem(int8_t displayIdx,
         return zxerr_no_data;
     }
 
+    if (app_mode_expert() && displayIdx == numItems - 1) {
+        return tx_getTxIdItem(outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+    }
+
     parser_error_t err = parser_getItem(&ctx_parsed_tx,
                                         displayIdx,
                                         outKey, outKeyLen,
@@ -152,3 +235,100 @@ zxerr_t tx_getItem(int8_t displayIdx,
 
     return zxerr_ok;
 }
+
+uint32_t tx_group_append(unsigned char *buffer, uint32_t length)
+{
+    if (length > UINT16_MAX) {
+        return 0;
+    }
+    // Member lengths become the "TX" prefix of each member before the chunk is stored
+    parser_groupScan(&group_tx, buffer, (uint16_t) length);
+    return buffering_append(buffer, length);
+}
+
+const char *tx_group_stream_error()
+{
+    if (group_tx.error != parser_ok)
+    {
+        return parser_getErrorDescription(group_tx.error);
+    }
+    return NULL;
+}
+
+const char *tx_group_parse()
+{
+    MEMZERO(&parser_tx_obj, sizeof(parser_tx_obj));
+
+    const parser_error_t err = parser_groupVerify(&group_tx,
+                                                  &ctx_parsed_tx,
+                                                  &parser_tx_obj,
+                                                  tx_get_buffer(),
+                                                  (uint16_t) tx_get_buffer_length());
+    CHECK_APP_CANARY()
+
+    if (err != parser_ok)
+    {
+        return parser_getErrorDescription(err);
+    }
+    return NULL;
+}
+
+zxerr_t tx_group_getNumItems(uint8_t *num_items)
+{
+    if (parser_groupGetNumItems(&group_tx, num_items) != parser_ok) {
+        return zxerr_unknown;
+    }
+    return zxerr_ok;
+}
+
+zxerr_t tx_group_getItem(int8_t displayIdx,
+                         char *outKey, uint16_t outKeyLen,
+                         char *outVal, uint16_t outValLen,
+                         uint8_t pageIdx, uint8_t *pageCount)
+{
+    if (displayIdx < 0) {
+        return zxerr_no_data;
+    }
+
+    parser_error_t err = parser_groupGetItem(&group_tx, &ctx_parsed_tx, &parser_tx_obj,
+                                             (uint8_t) displayIdx,
+                                             outKey, outKeyLen,
+                                             outVal, outValLen,
+                                             pageIdx, pageCount);
+
+    // Convert error codes
+    if (err == parser_no_data ||
+        err == parser_display_idx_out_of_range ||
+        err == parser_display_page_out_of_range)
+        return zxerr_no_data;
+
+    if (err != parser_ok)
+        return zxerr_unknown;
+
+    return zxerr_ok;
+}
+
+uint16_t tx_group_approve(uint8_t *groupId, uint16_t groupIdLen)
+{
+    if (groupId == NULL || groupIdLen < GROUP_ID_LEN || group_tx.numItems == 0) {
+        return 0;
+    }
+    group_approved = true;
+    MEMCPY(groupId, group_tx.groupId, GROUP_ID_LEN);
+    return GROUP_ID_LEN;
+}
+
+zxerr_t tx_group_get_txn(uint8_t idx, const uint8_t **message, uint16_t *messageLen, uint8_t *txnId)
+{
+    if (!group_approved || message == NULL || messageLen == NULL || txnId == NULL) {
+        return zxerr_unknown;
+    }
+    if (parser_groupGetSignedTxn(&group_tx, idx, message, messageLen) != parser_ok) {
+        return zxerr_no_data;
+    }
+
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256(*message, *messageLen, digest);
+    MEMCPY(txnId, digest, TXID_LEN);
+    return zxerr_ok;
+}
@@ -39,6 +39,15 @@ uint32_t tx_get_buffer_length();
 /// \return
 uint8_t *tx_get_buffer();
 
+/// Returns the first error found while scanning the chunks received so far
+/// \return It returns NULL if no error was found or error message otherwise.
+const char *tx_stream_error();
+
+/// Returns the ID of the transaction passed to tx_parse
+/// It is the SHA512/256 of the whole buffer ("TX" || msgpack), hashed as the chunks were appended
+/// \return TXID_LEN bytes
+const uint8_t *tx_get_txid();
+
 /// Parse message stored in transaction buffer
 /// This function should be called as soon as full buffer data is loaded.
 /// \return It returns NULL if data is valid or error message otherwise.
@@ -52,3 +61,33 @@ zxerr_t tx_getItem(int8_t displayIdx,
                    char *outKey, uint16_t outKeyLen,
                    char *outValue, uint16_t outValueLen,
                    uint8_t pageIdx, uint8_t *pageCount);
+
+/// Appends the next chunk of a transaction group (INS_SIGN_GROUP)
+/// Member lengths are replaced in buffer by the "TX" prefix they are signed with
+/// \return bytes added, less than length if the buffer is full
+uint32_t tx_group_append(unsigned char *buffer, uint32_t length);
+
+/// Returns the first error found while scanning the group chunks received so far
+/// \return It returns NULL if no error was found or error message otherwise.
+const char *tx_group_stream_error();
+
+/// Parses every member of the uploaded group and checks their group ID
+/// \return It returns NULL if the group is valid or error message otherwise.
+const char *tx_group_parse();
+
+/// Return the number of items in the group review
+zxerr_t tx_group_getNumItems(uint8_t *num_items);
+
+/// Gets an specific item from the group review (including paging)
+zxerr_t tx_group_getItem(int8_t displayIdx,
+                         char *outKey, uint16_t outKeyLen,
+                         char *outValue, uint16_t outValueLen,
+                         uint8_t pageIdx, uint8_t *pageCount);
+
+/// Marks the reviewed group as approved, until the next upload
+/// \return length of the group ID written to groupId, 0 if there is no group to approve
+uint16_t tx_group_approve(uint8_t *groupId, uint16_t groupIdLen);
+
+/// Returns the message to sign for member idx of the approved group and its transaction ID
+/// Fails for members outside the sign mask or before the group is approved
+zxerr_t tx_group_get_txn(uint8_t idx, const uint8_t **message, uint16_t *messageLen, uint8_t *txnId);
@@ -19,32 +19,98 @@
 #include "cx.h"
 #include "zxmacros.h"
 #include "parser_encoding.h"
+#include "base32.h"
 
 uint32_t hdPath[HDPATH_LEN_DEFAULT];
 
-zxerr_t crypto_extractPublicKey(uint8_t *pubKey, uint16_t pubKeyLen) {
-    if (pubKey == NULL || pubKeyLen < PK_LEN_25519) {
-        return zxerr_invalid_crypto_settings;
+// Key of the last account used. It outlives the call that derived it only while a key session
+// is open, so the signatures of one approved group derive once. Wiped whenever another path is
+// requested and when the session ends.
+typedef struct {
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    cx_ecfp_private_key_t privateKey;
+    uint8_t publicKey[PK_LEN_25519];
+    bool valid;
+    bool hasPublicKey;
+} crypto_key_cache_t;
+
+static crypto_key_cache_t keyCache;
+static bool keySession = false;
+
+static void crypto_wipeKey(void) {
+    MEMZERO(&keyCache, sizeof(keyCache));
+}
+
+// Outside a session nothing is kept once the key has been used
+static void crypto_releaseKey(void) {
+    if (!keySession) {
+        crypto_wipeKey();
+    }
+}
+
+void crypto_openKeySession(void) {
+    keySession = true;
+}
+
+void crypto_clearKeyCache(void) {
+    crypto_wipeKey();
+    keySession = false;
+}
+
+// Leaves the key of path in keyCache, derived only if the cache holds another one
+static zxerr_t crypto_loadKey(const uint32_t *path) {
+    if (keyCache.valid && MEMCMP(keyCache.path, path, sizeof(keyCache.path)) == 0) {
+        return zxerr_ok;
     }
+    crypto_wipeKey();
 
     zxerr_t error = zxerr_unknown;
-    cx_ecfp_public_key_t cx_publicKey;
-    cx_ecfp_private_key_t cx_privateKey;
     uint8_t privateKeyData[SK_LEN_25519] = {0};
 
-    // Generate keys
     CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL,
                                                      CX_CURVE_Ed25519,
-                                                     hdPath,
+                                                     path,
                                                      HDPATH_LEN_DEFAULT,
                                                      privateKeyData,
                                                      NULL,
                                                      NULL,
                                                      0));
 
-    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519, privateKeyData, 32, &cx_privateKey));
+    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519, privateKeyData, 32, &keyCache.privateKey));
+    MEMCPY(keyCache.path, path, sizeof(keyCache.path));
+    keyCache.valid = true;
+    error = zxerr_ok;
+
+catch_cx_error:
+    MEMZERO(privateKeyData, SK_LEN_25519);
+
+    if (error != zxerr_ok) {
+        crypto_wipeKey();
+    }
+
+    return error;
+}
+
+static zxerr_t crypto_publicKeyAt(const uint32_t *path, uint8_t *pubKey, uint16_t pubKeyLen) {
+    if (pubKey == NULL || pubKeyLen < PK_LEN_25519) {
+        return zxerr_invalid_crypto_settings;
+    }
+
+    zxerr_t error = zxerr_unknown;
+    cx_ecfp_public_key_t cx_publicKey;
+
+    if (crypto_loadKey(path) != zxerr_ok) {
+        goto catch_cx_error;
+    }
+    if (keyCache.hasPublicKey) {
+        MEMCPY(pubKey, keyCache.publicKey, PK_LEN_25519);
+        crypto_releaseKey();
+        return zxerr_ok;
+    }
+
+    // Generate keys
     CATCH_CXERROR(cx_ecfp_init_public_key_no_throw(CX_CURVE_Ed25519, NULL, 0, &cx_publicKey));
-    CATCH_CXERROR(cx_ecfp_generate_pair_no_throw(CX_CURVE_Ed25519, &cx_publicKey, &cx_privateKey, 1));
+    CATCH_CXERROR(cx_ecfp_generate_pair_no_throw(CX_CURVE_Ed25519, &cx_publicKey, &keyCache.privateKey, 1));
 
     for (unsigned int i = 0; i < PK_LEN_25519; i++) {
         pubKey[i] = cx_publicKey.W[64 - i];
@@ -53,40 +119,37 @@ zxerr_t crypto_extractPublicKey(uint8_t *pubKey, uint16_t pubKeyLen) {
     if ((cx_publicKey.W[PK_LEN_25519] & 1) != 0) {
         pubKey[31] |= 0x80;
     }
+    MEMCPY(keyCache.publicKey, pubKey, PK_LEN_25519);
+    keyCache.hasPublicKey = true;
     error = zxerr_ok;
 
 catch_cx_error:
-    MEMZERO(&cx_privateKey, sizeof(cx_privateKey));
-    MEMZERO(privateKeyData, SK_LEN_25519);
-
     if (error != zxerr_ok) {
+        crypto_wipeKey();
         MEMZERO(pubKey, pubKeyLen);
     }
+    crypto_releaseKey();
 
     return error;
 }
 
-zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen) {
-    if (signature == NULL || message == NULL || signatureMaxlen < ED25519_SIGNATURE_SIZE || messageLen == 0) {
+zxerr_t crypto_extractPublicKey(uint8_t *pubKey, uint16_t pubKeyLen) {
+    return crypto_publicKeyAt(hdPath, pubKey, pubKeyLen);
+}
+
+zxerr_t crypto_signWithPath(const uint32_t *path,
+                            uint8_t *signature, uint16_t signatureMaxlen,
+                            const uint8_t *message, uint16_t messageLen) {
+    if (path == NULL || signature == NULL || message == NULL || signatureMaxlen < ED25519_SIGNATURE_SIZE || messageLen == 0) {
         return zxerr_unknown;
     }
 
-    cx_ecfp_private_key_t cx_privateKey;
-    uint8_t privateKeyData[SK_LEN_25519] = {0};
-
     zxerr_t error = zxerr_unknown;
 
-    CATCH_CXERROR(os_derive_bip32_with_seed_no_throw(HDW_NORMAL,
-                                                     CX_CURVE_Ed25519,
-                                                     hdPath,
-                                                     HDPATH_LEN_DEFAULT,
-                                                     privateKeyData,
-                                                     NULL,
-                                                     NULL,
-                                                     0));
-
-    CATCH_CXERROR(cx_ecfp_init_private_key_no_throw(CX_CURVE_Ed25519, privateKeyData, 32, &cx_privateKey));
-    CATCH_CXERROR(cx_eddsa_sign_no_throw(&cx_privateKey,
+    if (crypto_loadKey(path) != zxerr_ok) {
+        goto catch_cx_error;
+    }
+    CATCH_CXERROR(cx_eddsa_sign_no_throw(&keyCache.privateKey,
                                          CX_SHA512,
                                          message,
                                          messageLen,
@@ -95,16 +158,19 @@ zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t
     error = zxerr_ok;
 
 catch_cx_error:
-    MEMZERO(&cx_privateKey, sizeof(cx_privateKey));
-    MEMZERO(privateKeyData, SK_LEN_25519);
-
     if (error != zxerr_ok) {
+        crypto_wipeKey();
         MEMZERO(signature, signatureMaxlen);
     }
+    crypto_releaseKey();
 
     return error;
 }
 
+zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen) {
+    return crypto_signWithPath(hdPath, signature, signatureMaxlen, message, messageLen);
+}
+
 zxerr_t crypto_fillAddress(uint8_t *buffer, uint16_t bufferLen, uint16_t *addrResponseLen)
 {
     if (bufferLen < PK_LEN_25519 + SS58_ADDRESS_MAX_LEN) {
@@ -126,3 +192,59 @@ zxerr_t crypto_fillAddress(uint8_t *buffer, uint16_t bufferLen, uint16_t *addrRe
     *addrResponseLen = PK_LEN_25519 + outLen;
     return zxerr_ok;
 }
+
+zxerr_t crypto_fillPublicKeys(uint8_t count, bool withAddress, uint8_t *buffer, uint16_t bufferLen, uint16_t *responseLen)
+{
+    if (buffer == NULL || responseLen == NULL || count == 0) {
+        return zxerr_unknown;
+    }
+
+    // Accounts are hardened, the last one of the range must still fit in 31 bits
+    const uint32_t firstAccount = hdPath[2] & ~HDPATH_2_DEFAULT;
+    if (firstAccount > (~HDPATH_2_DEFAULT) - (count - 1u)) {
+        return zxerr_out_of_bounds;
+    }
+
+    const uint16_t recordLen = PK_LEN_25519 + (withAddress ? BASE32_ADDRESS_LEN : 0);
+    const uint16_t fits = bufferLen / recordLen;
+    if (fits == 0) {
+        return zxerr_buffer_too_small;
+    }
+    if (count > fits) {
+        count = (uint8_t) fits;
+    }
+
+    MEMZERO(buffer, bufferLen);
+    *responseLen = 0;
+
+    // hdPath keeps the account the host selected, a later P1_FIRST signature still uses it
+    uint32_t path[HDPATH_LEN_DEFAULT];
+    MEMCPY(path, hdPath, sizeof(path));
+
+    zxerr_t err = zxerr_ok;
+    uint8_t address[2 * PK_LEN_25519 + 1];
+    for (uint8_t i = 0; i < count && err == zxerr_ok; i++) {
+        uint8_t *record = buffer + i * recordLen;
+        path[2] = HDPATH_2_DEFAULT | (firstAccount + i);
+
+        err = crypto_publicKeyAt(path, record, PK_LEN_25519);
+        if (err == zxerr_ok && withAddress) {
+            if (encodePubKey(address, sizeof(address), record) == BASE32_ADDRESS_LEN) {
+                MEMCPY(record + PK_LEN_25519, address, BASE32_ADDRESS_LEN);
+            } else {
+                err = zxerr_encoding_failed;
+            }
+        }
+    }
+
+    // Only public keys were asked for, no private key of the range stays in RAM
+    crypto_wipeKey();
+
+    if (err != zxerr_ok) {
+        MEMZERO(buffer, bufferLen);
+        return err;
+    }
+
+    *responseLen = count * recordLen;
+    return zxerr_ok;
+}
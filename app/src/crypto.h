@@ -29,8 +29,26 @@ extern uint32_t hdPath[HDPATH_LEN_DEFAULT];
 
 zxerr_t crypto_fillAddress(uint8_t *buffer, uint16_t bufferLen, uint16_t *addrResponseLen);
 
+// Public keys of `count` consecutive accounts starting at the one in hdPath, packed back to back,
+// each followed by its address when withAddress is set. Stops at the last record that fits in
+// the buffer. hdPath is not modified and no derived key is left in the key cache.
+zxerr_t crypto_fillPublicKeys(uint8_t count, bool withAddress, uint8_t *buffer, uint16_t bufferLen, uint16_t *responseLen);
+
 zxerr_t crypto_sign(uint8_t *signature, uint16_t signatureMaxlen, const uint8_t *message, uint16_t messageLen);
 
+// Same as crypto_sign with the account of path instead of hdPath, which is not modified
+zxerr_t crypto_signWithPath(const uint32_t *path,
+                            uint8_t *signature, uint16_t signatureMaxlen,
+                            const uint8_t *message, uint16_t messageLen);
+
+// Keeps the derived key between calls until crypto_clearKeyCache, for the signatures of one group.
+// Outside a session the key is wiped as soon as it has been used.
+void crypto_openKeySession(void);
+
+// Wipes the key kept for the last account and ends the key session. Called when a session is left,
+// when the device locks and on exit.
+void crypto_clearKeyCache(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -50,6 +50,24 @@ extern "C" {
 #define MAP16       0xde
 #define MAP32       0xdf
 
+// Type table entries: value class in the high nibble, size in bytes of the
+// length/value field that follows the type byte in the low nibble
+#define MSGPACK_CLASS_INVALID   0x00
+#define MSGPACK_CLASS_UINT      0x10
+#define MSGPACK_CLASS_MAP       0x20
+#define MSGPACK_CLASS_ARRAY     0x30
+#define MSGPACK_CLASS_STR       0x40
+#define MSGPACK_CLASS_BIN       0x50
+#define MSGPACK_CLASS_BOOL      0x60
+#define MSGPACK_CLASS_MASK      0xF0
+
+#define MSGPACK_FIELD_MASK      0x0F
+// Length/value is stored in the type byte itself (fixint, fixmap, fixarray, fixstr)
+#define MSGPACK_FIELD_INLINE    0x0F
+
+// Maximum nesting accepted when skipping over values
+#define MSGPACK_MAX_DEPTH       8
+
 #ifdef __cplusplus
 }
 #endif
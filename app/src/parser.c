@@ -40,10 +40,34 @@ parser_error_t parser_parse(parser_context_t *ctx,
     return _read(ctx, tx_obj);
 }
 
+parser_error_t parser_streamInit(parser_stream_t *stream, parser_context_t *ctx) {
+    return _streamInit(stream, ctx);
+}
+
+parser_error_t parser_streamAppend(parser_stream_t *stream,
+                                   const uint8_t *data,
+                                   size_t dataLen) {
+    if (dataLen > UINT16_MAX) {
+        return parser_unexpected_buffer_end;
+    }
+    return _streamAppend(stream, data, (uint16_t) dataLen);
+}
+
+parser_error_t parser_parseStreamed(parser_context_t *ctx,
+                                    const parser_stream_t *stream,
+                                    const uint8_t *data,
+                                    size_t dataLen,
+                                    parser_tx_t *tx_obj) {
+    if (dataLen > UINT16_MAX) {
+        return parser_unexpected_buffer_end;
+    }
+    return _readStreamed(ctx, stream, data, (uint16_t) dataLen, tx_obj);
+}
+
 parser_error_t parser_validate(parser_context_t *ctx) {
     // Iterate through all items to check that all can be shown and are valid
     uint8_t numItems = 0;
-    CHECK_ERROR(parser_getNumItems(&numItems))
+    CHECK_ERROR(parser_getNumItems(ctx, &numItems))
 
     char tmpKey[40];
     char tmpVal[40];
@@ -55,24 +79,27 @@ parser_error_t parser_validate(parser_context_t *ctx) {
     return parser_ok;
 }
 
-parser_error_t parser_getNumItems(uint8_t *num_items) {
-    *num_items = _getNumItems();
+parser_error_t parser_getNumItems(const parser_context_t *ctx, uint8_t *num_items) {
+    if (ctx == NULL || num_items == NULL) {
+        return parser_unexpected_value;
+    }
+    *num_items = _getNumItems(ctx);
     if(*num_items == 0) {
         return parser_unexpected_number_items;
     }
     return parser_ok;
 }
 
-static parser_error_t parser_getCommonNumItems(uint8_t *common_num_items) {
-    *common_num_items = _getCommonNumItems();
+static parser_error_t parser_getCommonNumItems(const parser_context_t *ctx, uint8_t *common_num_items) {
+    *common_num_items = _getCommonNumItems(ctx);
     if(*common_num_items == 0) {
         return parser_unexpected_number_items;
     }
     return parser_ok;
 }
 
-static parser_error_t parser_getTxNumItems(uint8_t *tx_num_items) {
-    *tx_num_items = _getTxNumItems();
+static parser_error_t parser_getTxNumItems(const parser_context_t *ctx, uint8_t *tx_num_items) {
+    *tx_num_items = _getTxNumItems(ctx);
     return parser_ok;
 }
 
@@ -155,7 +182,19 @@ static parser_error_t parser_printBoxes(char *outKey, uint16_t outKeyLen, char *
     return parser_ok;
 }
 
-static parser_error_t parser_printCommonParams(const parser_tx_t *parser_tx_obj,
+// Pages the base32 form of publicKey, encoded once per transaction
+static parser_error_t parser_printAddress(parser_address_cache_t *addresses, const uint8_t *publicKey,
+                                          char *outVal, uint16_t outValLen,
+                                          uint8_t pageIdx, uint8_t *pageCount)
+{
+    const char *address = NULL;
+    CHECK_ERROR(_renderAddress(addresses, publicKey, &address))
+    pageString(outVal, outValLen, address, pageIdx, pageCount);
+    return parser_ok;
+}
+
+static parser_error_t parser_printCommonParams(parser_address_cache_t *addresses,
+                                               const parser_tx_t *parser_tx_obj,
                                                uint8_t displayIdx,
                                                char *outKey, uint16_t outKeyLen,
                                                char *outVal, uint16_t outValLen,
@@ -166,20 +205,16 @@ static parser_error_t parser_printCommonParams(const parser_tx_t *parser_tx_obj,
     switch (displayIdx) {
         case IDX_COMMON_SENDER:
             snprintf(outKey, outKeyLen, "Sender");
-            if (encodePubKey((uint8_t*) buff, sizeof(buff), parser_tx_obj->sender) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, parser_tx_obj->sender, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_COMMON_REKEY_TO: {
             snprintf(outKey, outKeyLen, "Rekey to");
             const char warning[9] = "WARNING: ";
             const uint8_t warning_size = strnlen(warning, 9);
+            const char *address = NULL;
+            CHECK_ERROR(_renderAddress(addresses, parser_tx_obj->rekey, &address))
             MEMCPY(buff, warning, warning_size);
-            if (encodePubKey((uint8_t*) (buff + warning_size), sizeof(buff) - warning_size, parser_tx_obj->rekey) == 0) {
-                 return parser_unexpected_buffer_end;
-            }
+            MEMCPY(buff + warning_size, address, ADDRESS_CACHE_TEXT_LEN);
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
         }
@@ -196,19 +231,19 @@ static parser_error_t parser_printCommonParams(const parser_tx_t *parser_tx_obj,
 
         case IDX_COMMON_LEASE:
             snprintf(outKey, outKeyLen, "Lease");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) parser_tx_obj->lease, sizeof(parser_tx_obj->lease));
+            base64_encode(buff, sizeof(buff), parser_tx_obj->lease, LEASE_SIZE);
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
         case IDX_COMMON_GEN_HASH:
             snprintf(outKey, outKeyLen, "Genesis hash");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) parser_tx_obj->genesisHash, sizeof(parser_tx_obj->genesisHash));
+            base64_encode(buff, sizeof(buff), parser_tx_obj->genesisHash, HASH_SIZE);
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
         case IDX_COMMON_GROUP_ID:
             snprintf(outKey, outKeyLen, "Group ID");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) parser_tx_obj->groupID, sizeof(parser_tx_obj->groupID));
+            base64_encode(buff, sizeof(buff), parser_tx_obj->groupID, HASH_SIZE);
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
@@ -239,22 +274,18 @@ static parser_error_t parser_printCommonParams(const parser_tx_t *parser_tx_obj,
     return parser_display_idx_out_of_range;
 }
 
-static parser_error_t parser_printTxPayment(const txn_payment *payment,
+static parser_error_t parser_printTxPayment(parser_address_cache_t *addresses,
+                                            const txn_payment *payment,
                                                    uint8_t displayIdx,
                                                    char *outKey, uint16_t outKeyLen,
                                                    char *outVal, uint16_t outValLen,
                                                    uint8_t pageIdx, uint8_t *pageCount)
 {
     *pageCount = 1;
-    char buff[65] = {0};
     switch (displayIdx) {
         case IDX_PAYMENT_RECEIVER:
             snprintf(outKey, outKeyLen, "Receiver");
-            if (encodePubKey((uint8_t*) buff, sizeof(buff), payment->receiver) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, payment->receiver, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_PAYMENT_AMOUNT:
             snprintf(outKey, outKeyLen, "Amount");
@@ -264,11 +295,7 @@ static parser_error_t parser_printTxPayment(const txn_payment *payment,
 
         case IDX_PAYMENT_CLOSE_TO:
             snprintf(outKey, outKeyLen, "Close to");
-            if (encodePubKey((uint8_t*) buff, sizeof(buff), payment->close) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, payment->close, outVal, outValLen, pageIdx, pageCount);
             break;
 
         default:
@@ -289,20 +316,20 @@ static parser_error_t parser_printTxKeyreg(const txn_keyreg *keyreg,
     switch (displayIdx) {
         case IDX_KEYREG_VOTE_PK:
             snprintf(outKey, outKeyLen, "Vote PK");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) keyreg->votepk, sizeof(keyreg->votepk));
+            base64_encode(buff, sizeof(buff), keyreg->votepk, VOTE_PK_SIZE);
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
         case IDX_KEYREG_VRF_PK:
             snprintf(outKey, outKeyLen, "VRF PK");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) keyreg->vrfpk, sizeof(keyreg->vrfpk));
+            base64_encode(buff, sizeof(buff), keyreg->vrfpk, VRF_PK_SIZE);
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
         case IDX_KEYREG_SPRF_PK: {
             snprintf(outKey, outKeyLen, "SPRF PK");
             char tmpBuff[90];
-            base64_encode(tmpBuff, sizeof(tmpBuff), (const uint8_t*) keyreg->sprfkey, sizeof(keyreg->sprfkey));
+            base64_encode(tmpBuff, sizeof(tmpBuff), keyreg->sprfkey, SPRF_PK_SIZE);
             pageString(outVal, outValLen, tmpBuff, pageIdx, pageCount);
             return parser_ok;
         }
@@ -344,69 +371,55 @@ static parser_error_t parser_printTxKeyreg(const txn_keyreg *keyreg,
     return parser_display_idx_out_of_range;
 }
 
-static parser_error_t parser_printTxAssetXfer(const txn_asset_xfer *asset_xfer,
+static parser_error_t parser_printTxAssetXfer(parser_address_cache_t *addresses,
+                                              const txn_asset_xfer *asset_xfer,
                                                    uint8_t displayIdx,
                                                    char *outKey, uint16_t outKeyLen,
                                                    char *outVal, uint16_t outValLen,
                                                    uint8_t pageIdx, uint8_t *pageCount)
 {
     *pageCount = 1;
-    union {
-        char bufferUI[200];
-        char buff[65];
-    } tmpBuff;
+    char bufferUI[200];
 
     switch (displayIdx) {
         case IDX_XFER_ASSET_ID: {
             snprintf(outKey, outKeyLen, "Asset ID");
-            const algo_asset_info_t *asa = algo_asa_get(asset_xfer->id);
-            if (uint64_to_str(tmpBuff.bufferUI, sizeof(tmpBuff.bufferUI), asset_xfer->id) != NULL) {
+            const algo_asset_t *asa = &asset_xfer->asa;
+            if (uint64_to_str(bufferUI, sizeof(bufferUI), asset_xfer->id) != NULL) {
                 return parser_unexpected_value;
             }
-            if (asa == NULL) {
-                snprintf(outVal, outValLen, "#%s", tmpBuff.bufferUI);
+            if (asa->name == NULL) {
+                snprintf(outVal, outValLen, "#%s", bufferUI);
             } else {
-                snprintf(outVal, outValLen, "%s (#%s)", asa->name, tmpBuff.bufferUI);
+                snprintf(outVal, outValLen, "%s (#%s)", asa->name, bufferUI);
             }
             return parser_ok;
         }
 
         case IDX_XFER_AMOUNT: {
-            const algo_asset_info_t *asa = algo_asa_get(asset_xfer->id);
-            if (asa == NULL) {
+            const algo_asset_t *asa = &asset_xfer->asa;
+            if (asa->name == NULL) {
                 snprintf(outKey, outKeyLen, "Amount");
                 return _toStringBalance((uint64_t*) &asset_xfer->amount, 0, "", "Base unit ",
                                         outVal, outValLen, pageIdx, pageCount);
             } else {
                 snprintf(outKey, outKeyLen, "Amount");
-                return _toStringBalance((uint64_t*) &asset_xfer->amount, asa->decimals, "", (char*)asa->unit,
+                return _toStringBalance((uint64_t*) &asset_xfer->amount, asa->decimals, "", asa->unit,
                                         outVal, outValLen, pageIdx, pageCount);
             }
         }
 
         case IDX_XFER_SOURCE:
             snprintf(outKey, outKeyLen, "Asset src");
-            if (encodePubKey((uint8_t*) tmpBuff.buff, sizeof(tmpBuff.buff), asset_xfer->sender) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, tmpBuff.buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, asset_xfer->sender, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_XFER_DESTINATION:
             snprintf(outKey, outKeyLen, "Asset dst");
-            if (encodePubKey((uint8_t*) tmpBuff.buff, sizeof(tmpBuff.buff), asset_xfer->receiver) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, tmpBuff.buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, asset_xfer->receiver, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_XFER_CLOSE:
             snprintf(outKey, outKeyLen, "Asset close");
-            if (encodePubKey((uint8_t*) tmpBuff.buff, sizeof(tmpBuff.buff), asset_xfer->close) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, tmpBuff.buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, asset_xfer->close, outVal, outValLen, pageIdx, pageCount);
 
         default:
             break;
@@ -415,14 +428,14 @@ static parser_error_t parser_printTxAssetXfer(const txn_asset_xfer *asset_xfer,
     return parser_display_idx_out_of_range;
 }
 
-static parser_error_t parser_printTxAssetFreeze(const txn_asset_freeze *asset_freeze,
+static parser_error_t parser_printTxAssetFreeze(parser_address_cache_t *addresses,
+                                                const txn_asset_freeze *asset_freeze,
                                                    uint8_t displayIdx,
                                                    char *outKey, uint16_t outKeyLen,
                                                    char *outVal, uint16_t outValLen,
                                                    uint8_t pageIdx, uint8_t *pageCount)
 {
     *pageCount = 1;
-    char buff[65] = {0};
     switch (displayIdx) {
         case IDX_FREEZE_ASSET_ID:
             snprintf(outKey, outKeyLen, "Asset ID");
@@ -433,11 +446,7 @@ static parser_error_t parser_printTxAssetFreeze(const txn_asset_freeze *asset_fr
 
         case IDX_FREEZE_ACCOUNT:
             snprintf(outKey, outKeyLen, "Asset account");
-            if (encodePubKey((uint8_t*) buff, sizeof(buff), asset_freeze->account) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, asset_freeze->account, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_FREEZE_FLAG:
             snprintf(outKey, outKeyLen, "Freeze flag");
@@ -456,14 +465,15 @@ static parser_error_t parser_printTxAssetFreeze(const txn_asset_freeze *asset_fr
     return parser_display_idx_out_of_range;
 }
 
-static parser_error_t parser_printTxAssetConfig(const txn_asset_config *asset_config,
+static parser_error_t parser_printTxAssetConfig(parser_address_cache_t *addresses,
+                                                const txn_asset_config *asset_config,
                                                    uint8_t displayIdx,
                                                    char *outKey, uint16_t outKeyLen,
                                                    char *outVal, uint16_t outValLen,
                                                    uint8_t pageIdx, uint8_t *pageCount)
 {
     *pageCount = 1;
-    char buff[100] = {0};
+    char buff[45] = {0};
     switch (displayIdx) {
         case IDX_CONFIG_ASSET_ID:
             snprintf(outKey, outKeyLen, "Asset ID");
@@ -494,8 +504,8 @@ static parser_error_t parser_printTxAssetConfig(const txn_asset_config *asset_co
 
         case IDX_CONFIG_UNIT_NAME:
             snprintf(outKey, outKeyLen, "Unit name");
-            MEMCPY(buff,asset_config->params.unitname, sizeof(asset_config->params.unitname));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageStringExt(outVal, outValLen, (const char*) asset_config->params.unitname,
+                          strnlen((const char*) asset_config->params.unitname, asset_config->params.unitname_len), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_CONFIG_DECIMALS:
@@ -507,37 +517,37 @@ static parser_error_t parser_printTxAssetConfig(const txn_asset_config *asset_co
 
         case IDX_CONFIG_ASSET_NAME:
             snprintf(outKey, outKeyLen, "Asset name");
-            MEMCPY(buff,asset_config->params.assetname, sizeof(asset_config->params.assetname));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageStringExt(outVal, outValLen, (const char*) asset_config->params.assetname,
+                          strnlen((const char*) asset_config->params.assetname, asset_config->params.assetname_len), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_CONFIG_URL:
             snprintf(outKey, outKeyLen, "URL");
-            MEMCPY(buff,asset_config->params.url, sizeof(asset_config->params.url));
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
+            pageStringExt(outVal, outValLen, (const char*) asset_config->params.url,
+                          strnlen((const char*) asset_config->params.url, asset_config->params.url_len), pageIdx, pageCount);
             return parser_ok;
 
         case IDX_CONFIG_METADATA_HASH:
             snprintf(outKey, outKeyLen, "Metadata hash");
-            base64_encode(buff, sizeof(buff), (const uint8_t*) asset_config->params.metadata_hash, sizeof(asset_config->params.metadata_hash));
+            base64_encode(buff, sizeof(buff), asset_config->params.metadata_hash, HASH_SIZE);
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
         case IDX_CONFIG_MANAGER:
             snprintf(outKey, outKeyLen, "Manager");
-            return _toStringAddress((uint8_t*) asset_config->params.manager, outVal, outValLen, pageIdx, pageCount);
+            return _toStringAddress(addresses, asset_config->params.manager, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_CONFIG_RESERVE:
             snprintf(outKey, outKeyLen, "Reserve");
-            return _toStringAddress((uint8_t*) asset_config->params.reserve, outVal, outValLen, pageIdx, pageCount);
+            return _toStringAddress(addresses, asset_config->params.reserve, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_CONFIG_FREEZER:
             snprintf(outKey, outKeyLen, "Freezer");
-            return _toStringAddress((uint8_t*) asset_config->params.freeze, outVal, outValLen, pageIdx, pageCount);
+            return _toStringAddress(addresses, asset_config->params.freeze, outVal, outValLen, pageIdx, pageCount);
 
         case IDX_CONFIG_CLAWBACK:
             snprintf(outKey, outKeyLen, "Clawback");
-            return _toStringAddress((uint8_t*) asset_config->params.clawback, outVal, outValLen, pageIdx, pageCount);
+            return _toStringAddress(addresses, asset_config->params.clawback, outVal, outValLen, pageIdx, pageCount);
 
         default:
             break;
@@ -546,7 +556,9 @@ static parser_error_t parser_printTxAssetConfig(const txn_asset_config *asset_co
     return parser_display_idx_out_of_range;
 }
 
-static parser_error_t parser_printTxApplication(parser_context_t *ctx,
+static parser_error_t parser_printTxApplication(parser_address_cache_t *addresses,
+                                                parser_digest_cache_t *digests,
+                                                txn_application *application,
                                                 uint8_t displayIdx,
                                                 txn_application_index_e itemType,
                                                 char *outKey, uint16_t outKeyLen,
@@ -555,7 +567,6 @@ static parser_error_t parser_printTxApplication(parser_context_t *ctx,
 {
     *pageCount = 1;
     char buff[65] = {0};
-    txn_application *application = &ctx->parser_tx_obj->application;
 
     switch (itemType) {
         case IDX_APP_ID:
@@ -621,24 +632,18 @@ static parser_error_t parser_printTxApplication(parser_context_t *ctx,
 
         case IDX_ACCOUNTS: {
             const uint8_t tmpIdx = (displayIdx - application->num_foreign_apps - application->num_foreign_assets - application->num_boxes) - IDX_BOXES;
-            uint8_t account[ACCT_SIZE] = {0};
+            if (tmpIdx >= application->num_accounts) return parser_unexpected_number_items;
             snprintf(outKey, outKeyLen, "Account %d", tmpIdx);
-            CHECK_ERROR(_getAccount(ctx, account, tmpIdx, application->num_accounts))
-            if (encodePubKey((uint8_t*) buff, sizeof(buff), account) == 0) {
-                return parser_unexpected_buffer_end;
-            }
-            pageString(outVal, outValLen, buff, pageIdx, pageCount);
-            return parser_ok;
+            return parser_printAddress(addresses, application->accounts[tmpIdx], outVal, outValLen, pageIdx, pageCount);
         }
 
         case IDX_APP_ARGS: {
             const uint8_t tmpIdx = (displayIdx - application->num_foreign_apps - application->num_foreign_assets - application->num_accounts - application->num_boxes) - IDX_BOXES;
             // Check max index
             if (tmpIdx >= MAX_ARG) return parser_unexpected_value;
+            if (tmpIdx >= application->num_app_args) return parser_unexpected_number_items;
             snprintf(outKey, outKeyLen, "App arg %d", tmpIdx);
-            uint8_t* app_args_ptr = NULL;
-            CHECK_ERROR(_getAppArg(ctx, &app_args_ptr, &application->app_args_len[tmpIdx], tmpIdx, MAX_ARGLEN, MAX_ARG))
-            b64hash_data((unsigned char*)app_args_ptr, application->app_args_len[tmpIdx], buff, sizeof(buff));
+            CHECK_ERROR(_renderDigest(digests, application->app_args[tmpIdx], application->app_args_len[tmpIdx], buff, sizeof(buff)))
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
         }
@@ -658,13 +663,13 @@ static parser_error_t parser_printTxApplication(parser_context_t *ctx,
 
         case IDX_APPROVE:
             snprintf(outKey, outKeyLen, "Apprv");
-            b64hash_data((unsigned char*) application->aprog, application->aprog_len, buff, sizeof(buff));
+            CHECK_ERROR(_renderDigest(digests, application->aprog, application->aprog_len, buff, sizeof(buff)))
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
         case IDX_CLEAR:
             snprintf(outKey, outKeyLen, "Clear");
-            b64hash_data((unsigned char*) application->cprog, application->cprog_len, buff, sizeof(buff));
+            CHECK_ERROR(_renderDigest(digests, application->cprog, application->cprog_len, buff, sizeof(buff)))
             pageString(outVal, outValLen, buff, pageIdx, pageCount);
             return parser_ok;
 
@@ -676,49 +681,60 @@ static parser_error_t parser_printTxApplication(parser_context_t *ctx,
 }
 
 
-parser_error_t parser_getItem(parser_context_t *ctx,
-                              uint8_t displayIdx,
-                              char *outKey, uint16_t outKeyLen,
-                              char *outVal, uint16_t outValLen,
-                              uint8_t pageIdx, uint8_t *pageCount) {
-    if (ctx == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
-        return parser_unexpected_value;
-    }
-
+static parser_error_t parser_formatItem(parser_context_t *ctx,
+                                        uint8_t displayIdx,
+                                        char *outKey, uint16_t outKeyLen,
+                                        char *outVal, uint16_t outValLen,
+                                        uint8_t pageIdx, uint8_t *pageCount) {
     cleanOutput(outKey, outKeyLen, outVal, outValLen);
     *pageCount = 0;
 
     uint8_t numItems = 0;
-    CHECK_ERROR(parser_getNumItems(&numItems))
+    CHECK_ERROR(parser_getNumItems(ctx, &numItems))
     CHECK_APP_CANARY()
 
     uint8_t commonItems = 0;
-    CHECK_ERROR(parser_getCommonNumItems(&commonItems))
+    CHECK_ERROR(parser_getCommonNumItems(ctx, &commonItems))
 
     uint8_t txItems = 0;
-    CHECK_ERROR(parser_getTxNumItems(&txItems))
+    CHECK_ERROR(parser_getTxNumItems(ctx, &txItems))
 
     CHECK_ERROR(checkSanity(numItems, displayIdx))
 
+#if defined(PARSER_RENDER_CACHE)
+    parser_address_cache_t *addresses = &ctx->addresses;
+    parser_digest_cache_t *digests = &ctx->digests;
+#else
+    // Nothing is kept once the page is formatted
+    parser_address_cache_t addressScratch;
+    parser_digest_cache_t digestScratch;
+    addressScratch.count = 0;
+    addressScratch.next = 0;
+    digestScratch.count = 0;
+    digestScratch.next = 0;
+    parser_address_cache_t *addresses = &addressScratch;
+    parser_digest_cache_t *digests = &digestScratch;
+#endif
+
     if (displayIdx == 0) {
         return parser_printTxType(ctx, outKey, outKeyLen, outVal, outValLen, pageCount);
     }
 
     if (displayIdx <= commonItems) {
         uint8_t commonDisplayIdx = 0;
-        CHECK_ERROR(getItem(displayIdx - 1, &commonDisplayIdx))
-        return parser_printCommonParams(ctx->parser_tx_obj, commonDisplayIdx, outKey, outKeyLen,
+        CHECK_ERROR(getItem(ctx, displayIdx - 1, &commonDisplayIdx))
+        return parser_printCommonParams(addresses, ctx->parser_tx_obj, commonDisplayIdx, outKey, outKeyLen,
                                         outVal, outValLen, pageIdx, pageCount);
     }
 
     uint8_t txDisplayIdx = 0;
-    CHECK_ERROR(getItem(displayIdx - 1, &txDisplayIdx))
+    CHECK_ERROR(getItem(ctx, displayIdx - 1, &txDisplayIdx))
     displayIdx = displayIdx - commonItems -1;
 
     if (displayIdx < txItems) {
         switch (ctx->parser_tx_obj->type) {
             case TX_PAYMENT:
-                return parser_printTxPayment(&ctx->parser_tx_obj->payment,
+                return parser_printTxPayment(addresses, &ctx->parser_tx_obj->payment,
                                              txDisplayIdx, outKey, outKeyLen,
                                              outVal, outValLen, pageIdx, pageCount);
                 break;
@@ -728,22 +744,23 @@ parser_error_t parser_getItem(parser_context_t *ctx,
                                             outVal, outValLen, pageIdx, pageCount);
                 break;
             case TX_ASSET_XFER:
-                return parser_printTxAssetXfer(&ctx->parser_tx_obj->asset_xfer,
+                return parser_printTxAssetXfer(addresses, &ctx->parser_tx_obj->asset_xfer,
                                                txDisplayIdx, outKey, outKeyLen,
                                                outVal, outValLen, pageIdx, pageCount);
                 break;
             case TX_ASSET_FREEZE:
-                return parser_printTxAssetFreeze(&ctx->parser_tx_obj->asset_freeze,
+                return parser_printTxAssetFreeze(addresses, &ctx->parser_tx_obj->asset_freeze,
                                                  txDisplayIdx, outKey, outKeyLen,
                                                  outVal, outValLen, pageIdx, pageCount);
                 break;
             case TX_ASSET_CONFIG:
-                return parser_printTxAssetConfig(&ctx->parser_tx_obj->asset_config,
+                return parser_printTxAssetConfig(addresses, &ctx->parser_tx_obj->asset_config,
                                                  txDisplayIdx, outKey, outKeyLen,
                                                  outVal, outValLen, pageIdx, pageCount);
                 break;
             case TX_APPLICATION:
-                return parser_printTxApplication(ctx,displayIdx, txDisplayIdx, outKey, outKeyLen,
+                return parser_printTxApplication(addresses, digests, &ctx->parser_tx_obj->application,
+                                                 displayIdx, txDisplayIdx, outKey, outKeyLen,
                                                  outVal, outValLen, pageIdx, pageCount);
                 break;
             default:
@@ -755,6 +772,223 @@ parser_error_t parser_getItem(parser_context_t *ctx,
     return parser_display_idx_out_of_range;
 }
 
+#if defined(PARSER_RENDER_CACHE)
+// Formats the whole value of the item into ctx->rendered. Pages are cut from it
+// with the same fixed-width split pageStringExt applies, so page boundaries are
+// pageIdx * (outValLen - 1) and need no table.
+static void parser_renderItem(parser_context_t *ctx)
+{
+    parser_rendered_item_t *item = &ctx->rendered;
+    item->state = RENDER_UNCACHED;
+
+    uint8_t fullPages = 0;
+    if (parser_formatItem(ctx, item->displayIdx, item->key, sizeof(item->key),
+                          item->value, sizeof(item->value), 0, &fullPages) != parser_ok || fullPages != 1) {
+        return;
+    }
+
+    // Keys are cut by snprintf, so a key that fits here truncates like the one shown.
+    // The value must split exactly like the one shown.
+    const uint16_t pageLen = item->outValLen - 1;
+    item->keyLen = (uint8_t) strnlen(item->key, sizeof(item->key));
+    item->valueLen = (uint16_t) strnlen(item->value, sizeof(item->value));
+    if (item->keyLen >= sizeof(item->key) - 1 ||
+        (item->valueLen + pageLen - 1) / pageLen != item->pageCount) {
+        return;
+    }
+    item->state = RENDER_READY;
+}
+#endif
+
+parser_error_t parser_getItem(parser_context_t *ctx,
+                              uint8_t displayIdx,
+                              char *outKey, uint16_t outKeyLen,
+                              char *outVal, uint16_t outValLen,
+                              uint8_t pageIdx, uint8_t *pageCount) {
+    if (ctx == NULL || outKey == NULL || outVal == NULL || pageCount == NULL) {
+        return parser_unexpected_value;
+    }
+
+#if !defined(PARSER_RENDER_CACHE)
+    return parser_formatItem(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+#else
+    parser_rendered_item_t *item = &ctx->rendered;
+    if (item->state != RENDER_NONE && item->displayIdx == displayIdx &&
+        item->outKeyLen == outKeyLen && item->outValLen == outValLen) {
+        // Only items the user actually pages through are kept. A two page item
+        // read forward once is cheaper to format twice than to render in full.
+        if (item->state == RENDER_SHOWN && item->pageCount == 2) {
+            item->state = RENDER_REVISITED;
+            return parser_formatItem(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        }
+        if (item->state == RENDER_SHOWN || item->state == RENDER_REVISITED) {
+            parser_renderItem(ctx);
+        }
+        if (item->state != RENDER_READY) {
+            return parser_formatItem(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+        }
+        // Same bytes snprintf would leave in outKey, without formatting again
+        MEMZERO(outKey, outKeyLen);
+        MEMCPY(outKey, item->key, item->keyLen < outKeyLen ? item->keyLen : outKeyLen - 1);
+        pageStringExt(outVal, outValLen, item->value, item->valueLen, pageIdx, pageCount);
+        return parser_ok;
+    }
+
+    item->state = RENDER_NONE;
+    CHECK_ERROR(parser_formatItem(ctx, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount))
+    if (*pageCount > 1 && outKeyLen > 0 && outValLen > 1) {
+        item->displayIdx = displayIdx;
+        item->outKeyLen = outKeyLen;
+        item->outValLen = outValLen;
+        item->pageCount = *pageCount;
+        item->state = RENDER_SHOWN;
+    }
+    return parser_ok;
+#endif
+}
+
+static parser_error_t parser_checkCommonParams(uint8_t displayIdx)
+{
+    // First and Last valid are never displayed, see parser_printCommonParams
+    if (displayIdx > IDX_COMMON_REKEY_TO) {
+        return parser_display_idx_out_of_range;
+    }
+    return parser_ok;
+}
+
+static parser_error_t parser_checkTxApplication(parser_context_t *ctx,
+                                                uint8_t displayIdx,
+                                                txn_application_index_e itemType)
+{
+    txn_application *application = &ctx->parser_tx_obj->application;
+
+    // Same index arithmetic and bounds checks as parser_printTxApplication
+    switch (itemType) {
+        case IDX_APP_ID:
+        case IDX_ON_COMPLETION:
+        case IDX_GLOBAL_SCHEMA:
+        case IDX_LOCAL_SCHEMA:
+        case IDX_EXTRA_PAGES:
+        case IDX_APPROVE:
+        case IDX_CLEAR:
+            return parser_ok;
+
+        case IDX_BOXES: {
+            const uint8_t tmpIdx = displayIdx - IDX_BOXES;
+            if (tmpIdx >= MAX_FOREIGN_APPS) return parser_unexpected_value;
+            return parser_ok;
+        }
+
+        case IDX_FOREIGN_APP: {
+            const uint8_t tmpIdx = (displayIdx - (application->num_boxes)) - IDX_BOXES;
+            if (tmpIdx >= MAX_FOREIGN_APPS) return parser_unexpected_value;
+            return parser_ok;
+        }
+
+        case IDX_FOREIGN_ASSET: {
+            const uint8_t tmpIdx = (displayIdx - application->num_foreign_apps - application->num_boxes) - IDX_BOXES;
+            if (tmpIdx >= MAX_FOREIGN_ASSETS) return parser_unexpected_value;
+            return parser_ok;
+        }
+
+        case IDX_ACCOUNTS: {
+            const uint8_t tmpIdx = (displayIdx - application->num_foreign_apps - application->num_foreign_assets - application->num_boxes) - IDX_BOXES;
+            if (tmpIdx >= application->num_accounts) return parser_unexpected_number_items;
+            return parser_ok;
+        }
+
+        case IDX_APP_ARGS: {
+            const uint8_t tmpIdx = (displayIdx - application->num_foreign_apps - application->num_foreign_assets - application->num_accounts - application->num_boxes) - IDX_BOXES;
+            if (tmpIdx >= MAX_ARG) return parser_unexpected_value;
+            if (tmpIdx >= application->num_app_args) return parser_unexpected_number_items;
+            return parser_ok;
+        }
+
+        default:
+            break;
+    }
+
+    return parser_display_idx_out_of_range;
+}
+
+static parser_error_t parser_checkTxItem(parser_context_t *ctx, uint8_t displayIdx, uint8_t txDisplayIdx)
+{
+    uint8_t lastIdx = 0;
+    switch (ctx->parser_tx_obj->type) {
+        case TX_PAYMENT:
+            lastIdx = IDX_PAYMENT_CLOSE_TO;
+            break;
+        case TX_KEYREG:
+            lastIdx = IDX_KEYREG_PARTICIPATION;
+            break;
+        case TX_ASSET_XFER:
+            lastIdx = IDX_XFER_CLOSE;
+            break;
+        case TX_ASSET_FREEZE:
+            lastIdx = IDX_FREEZE_FLAG;
+            break;
+        case TX_ASSET_CONFIG:
+            lastIdx = IDX_CONFIG_CLAWBACK;
+            break;
+        case TX_APPLICATION:
+            return parser_checkTxApplication(ctx, displayIdx, txDisplayIdx);
+        default:
+            return parser_unexpected_error;
+    }
+
+    if (txDisplayIdx > lastIdx) {
+        return parser_display_idx_out_of_range;
+    }
+    return parser_ok;
+}
+
+parser_error_t parser_validateStructure(parser_context_t *ctx) {
+    if (ctx == NULL || ctx->parser_tx_obj == NULL) {
+        return parser_unexpected_value;
+    }
+
+    uint8_t numItems = 0;
+    CHECK_ERROR(parser_getNumItems(ctx, &numItems))
+    CHECK_APP_CANARY()
+
+    uint8_t commonItems = 0;
+    CHECK_ERROR(parser_getCommonNumItems(ctx, &commonItems))
+
+    uint8_t txItems = 0;
+    CHECK_ERROR(parser_getTxNumItems(ctx, &txItems))
+
+    // Item 0 is the transaction type
+    switch (ctx->parser_tx_obj->type) {
+        case TX_PAYMENT:
+        case TX_KEYREG:
+        case TX_ASSET_XFER:
+        case TX_ASSET_FREEZE:
+        case TX_ASSET_CONFIG:
+        case TX_APPLICATION:
+            break;
+        default:
+            return parser_unexpected_error;
+    }
+
+    for (uint8_t idx = 1; idx < numItems; idx++) {
+        uint8_t itemIdx = 0;
+        CHECK_ERROR(getItem(ctx, idx - 1, &itemIdx))
+
+        if (idx <= commonItems) {
+            CHECK_ERROR(parser_checkCommonParams(itemIdx))
+            continue;
+        }
+
+        const uint8_t txIdx = idx - commonItems - 1;
+        if (txIdx >= txItems) {
+            return parser_display_idx_out_of_range;
+        }
+        CHECK_ERROR(parser_checkTxItem(ctx, txIdx, itemIdx))
+    }
+
+    return parser_ok;
+}
+
 parser_error_t parser_getTxnText(parser_context_t *ctx,
                                  char *outVal, uint16_t outValLen) {
     if (ctx == NULL || outVal == NULL) {
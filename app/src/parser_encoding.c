@@ -30,31 +30,89 @@
 
 #endif
 
-uint32_t encodePubKey(uint8_t *buffer, uint16_t bufferLen, const uint8_t *publicKey)
+static uint32_t encodeChecksummed(char *buffer, uint16_t bufferLen, const uint8_t *publicKey)
 {
-    if(bufferLen < (2 * PK_LEN_25519 + 1)) {
-        return 0;
-    }
     uint8_t messageDigest[CX_SHA512_SIZE];
     SHA512_256(publicKey, 32, messageDigest);
 
-    uint8_t checksummed[36] = {0};
+    uint8_t checksummed[BASE32_ADDRESS_INPUT_LEN] = {0};
     memmove(&checksummed[0], publicKey, 32);
     memmove(&checksummed[32], &messageDigest[28], 4);
 
-    return base32_encode(checksummed, sizeof(checksummed), (char*)buffer, bufferLen);
+    return base32_encode_address(checksummed, buffer, bufferLen);
 }
 
-parser_error_t b64hash_data(unsigned char *data, size_t data_len, char *b64hash, size_t b64hashLen)
+uint32_t encodePubKey(uint8_t *buffer, uint16_t bufferLen, const uint8_t *publicKey)
+{
+    if(publicKey == NULL || bufferLen < (2 * PK_LEN_25519 + 1)) {
+        return 0;
+    }
+    return encodeChecksummed((char*)buffer, bufferLen, publicKey);
+}
+
+parser_error_t _renderAddress(parser_address_cache_t *cache, const uint8_t *publicKey, const char **address)
+{
+    if (cache == NULL || publicKey == NULL || address == NULL) {
+        return parser_unexpected_value;
+    }
+
+    for (uint8_t i = 0; i < cache->count; i++) {
+        if (memcmp(cache->keys[i], publicKey, PK_LEN_25519) == 0) {
+            *address = cache->text[i];
+            return parser_ok;
+        }
+    }
+
+    char text[ADDRESS_CACHE_TEXT_LEN];
+    if (encodeChecksummed(text, sizeof(text), publicKey) != BASE32_ADDRESS_LEN) {
+        return parser_unexpected_buffer_end;
+    }
+
+    const uint8_t slot = cache->next;
+    memmove(cache->keys[slot], publicKey, PK_LEN_25519);
+    memmove(cache->text[slot], text, sizeof(text));
+    cache->next = (slot + 1) % ADDRESS_CACHE_ENTRIES;
+    if (cache->count < ADDRESS_CACHE_ENTRIES) {
+        cache->count++;
+    }
+
+    *address = cache->text[slot];
+    return parser_ok;
+}
+
+parser_error_t decodeAddress(const char *address, size_t addressLen, uint8_t *publicKey)
+{
+    if (address == NULL || publicKey == NULL) {
+        return parser_no_data;
+    }
+    if (addressLen != BASE32_ADDRESS_LEN) {
+        return parser_invalid_address;
+    }
+
+    uint8_t checksummed[BASE32_ADDRESS_INPUT_LEN];
+    if (base32_decode(address, addressLen, checksummed, sizeof(checksummed)) != sizeof(checksummed)) {
+        return parser_invalid_address;
+    }
+
+    uint8_t messageDigest[CX_SHA512_SIZE];
+    SHA512_256(checksummed, PK_LEN_25519, messageDigest);
+    if (memcmp(&checksummed[PK_LEN_25519], &messageDigest[28], 4) != 0) {
+        return parser_invalid_address;
+    }
+
+    memmove(publicKey, checksummed, PK_LEN_25519);
+    return parser_ok;
+}
+
+static parser_error_t sha256_data(const unsigned char *data, size_t data_len, unsigned char hash[DIGEST_CACHE_HASH_LEN])
 {
-    unsigned char hash[32];
 #if defined(TARGET_NANOS) || defined(TARGET_NANOS2) || defined(TARGET_NANOX) || defined(TARGET_STAX)
-    // Hash program and b64 encode for display
+    // Digest of a program or app arg, shown base64 encoded
     cx_sha256_t ctx;
     memset(&ctx, 0, sizeof(ctx));
     cx_sha256_init(&ctx);
     
-    if (cx_hash_no_throw(&ctx.header, CX_LAST, data, data_len, hash, sizeof(hash)) != CX_OK) {
+    if (cx_hash_no_throw(&ctx.header, CX_LAST, data, data_len, hash, DIGEST_CACHE_HASH_LEN) != CX_OK) {
         return parser_unexpected_error;
     }
 #else
@@ -63,10 +121,45 @@ parser_error_t b64hash_data(unsigned char *data, size_t data_len, char *b64hash,
     picohash_update(&ctx, data, data_len);
     picohash_final(&ctx, hash);
 #endif
+    return parser_ok;
+}
+
+parser_error_t b64hash_data(unsigned char *data, size_t data_len, char *b64hash, size_t b64hashLen)
+{
+    unsigned char hash[DIGEST_CACHE_HASH_LEN];
+    CHECK_ERROR(sha256_data(data, data_len, hash))
     base64_encode(b64hash, b64hashLen, (const uint8_t *)hash, sizeof(hash));
     return parser_ok;
 }
 
+parser_error_t _renderDigest(parser_digest_cache_t *cache, const uint8_t *data, uint16_t dataLen,
+                             char *b64hash, size_t b64hashLen)
+{
+    if (cache == NULL || b64hash == NULL) {
+        return parser_unexpected_value;
+    }
+
+    // Every item hashes different bytes of the buffer, so where they sit identifies them
+    for (uint8_t i = 0; i < cache->count; i++) {
+        if (cache->data[i] == data && cache->dataLen[i] == dataLen) {
+            base64_encode(b64hash, b64hashLen, cache->hash[i], DIGEST_CACHE_HASH_LEN);
+            return parser_ok;
+        }
+    }
+
+    const uint8_t slot = cache->next;
+    CHECK_ERROR(sha256_data(data, dataLen, cache->hash[slot]))
+    cache->data[slot] = data;
+    cache->dataLen[slot] = dataLen;
+    cache->next = (slot + 1) % DIGEST_CACHE_ENTRIES;
+    if (cache->count < DIGEST_CACHE_ENTRIES) {
+        cache->count++;
+    }
+
+    base64_encode(b64hash, b64hashLen, cache->hash[slot], DIGEST_CACHE_HASH_LEN);
+    return parser_ok;
+}
+
 parser_error_t _toStringBalance(uint64_t* amount, uint8_t decimalPlaces, const char *postfix, const char *prefix,
                                 char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount)
 {
@@ -89,17 +182,18 @@ parser_error_t _toStringBalance(uint64_t* amount, uint8_t decimalPlaces, const c
     return parser_ok;
 }
 
-parser_error_t _toStringAddress(uint8_t* address, char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount)
+parser_error_t _toStringAddress(parser_address_cache_t *cache, const uint8_t* address,
+                                char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount)
 {
     if (all_zero_key(address)) {
         snprintf(outValue, outValueLen, "Zero");
         *pageCount = 1;
     } else {
-        char buff[65] = {0};
-        if (encodePubKey((uint8_t*)buff, sizeof(buff), address) == 0) {
+        const char *text = NULL;
+        if (_renderAddress(cache, address, &text) != parser_ok) {
             return parser_unexpected_value;
         }
-        pageString(outValue, outValueLen, buff, pageIdx, pageCount);
+        pageString(outValue, outValueLen, text, pageIdx, pageCount);
     }
     return parser_ok;
 }
@@ -134,14 +228,15 @@ parser_error_t _toStringSchema(const state_schema *schema, char* outValue, uint1
 bool is_opt_in_tx(parser_tx_t *tx_obj) {
 
     if(tx_obj->type == TX_ASSET_XFER && tx_obj->asset_xfer.amount == 0 && tx_obj->asset_xfer.id != 0 &&
-        memcmp(tx_obj->asset_xfer.receiver, tx_obj->asset_xfer.sender, sizeof(tx_obj->asset_xfer.receiver)) == 0)
+        tx_obj->asset_xfer.receiver != NULL && tx_obj->asset_xfer.sender != NULL &&
+        memcmp(tx_obj->asset_xfer.receiver, tx_obj->asset_xfer.sender, ACCT_SIZE) == 0)
     {
             return true;
     }
     return false;
 }
 
-bool all_zero_key(uint8_t *buff) {
+bool all_zero_key(const uint8_t *buff) {
   for (int i = 0; i < 32; i++) {
     if (buff[i] != 0) {
       return false;
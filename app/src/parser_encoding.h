@@ -15,20 +15,41 @@
 ********************************************************************************/
 
 #pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #include "stdint.h"
 #include "stdbool.h"
 #include "parser_common.h"
 
 uint32_t encodePubKey(uint8_t *buffer, uint16_t bufferLen, const uint8_t *publicKey);
 
+// Inverse of encodePubKey: checks length, alphabet and the 4 byte checksum
+// before writing the PK_LEN_25519 byte key
+parser_error_t decodeAddress(const char *address, size_t addressLen, uint8_t *publicKey);
+
 parser_error_t b64hash_data(unsigned char *data, size_t data_len, char *b64hash, size_t b64hashLen);
 
+// Same output as b64hash_data, hashing data on the first request and serving the digest from cache afterwards
+parser_error_t _renderDigest(parser_digest_cache_t *cache, const uint8_t *data, uint16_t dataLen,
+                             char *b64hash, size_t b64hashLen);
+
 parser_error_t _toStringBalance(uint64_t* amount, uint8_t decimalPlaces, const char *postfix, const char *prefix,
                                 char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount);
 
-parser_error_t _toStringAddress(uint8_t* address, char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount);
+// Base32 form of publicKey, encoded on the first request and served from cache afterwards
+parser_error_t _renderAddress(parser_address_cache_t *cache, const uint8_t *publicKey, const char **address);
+
+parser_error_t _toStringAddress(parser_address_cache_t *cache, const uint8_t* address,
+                                char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount);
 
 parser_error_t _toStringSchema(const state_schema *schema, char* outValue, uint16_t outValueLen, uint8_t pageIdx, uint8_t* pageCount);
 
-bool all_zero_key(uint8_t *buff);
+bool all_zero_key(const uint8_t *buff);
 bool is_opt_in_tx(parser_tx_t *tx_obj);
+
+#ifdef __cplusplus
+}
+#endif
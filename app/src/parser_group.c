@@ -0,0 +1,481 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <zxmacros.h>
+#include <zxformat.h>
+
+#include "parser_group.h"
+#include "parser.h"
+#include "parser_impl.h"
+#include "parser_keys.h"
+#include "msgpack.h"
+#include "sha512.h"
+
+#define GROUP_SCAN_COUNT        0
+#define GROUP_SCAN_MASK_HI      1
+#define GROUP_SCAN_MASK_LO      2
+#define GROUP_SCAN_LEN_HI       3
+#define GROUP_SCAN_LEN_LO       4
+#define GROUP_SCAN_TXN          5
+#define GROUP_SCAN_DONE         6
+
+// Common items that are shown once when every member has the same value. Lease,
+// note and rekey stay with their member, a rekey warning must never be merged.
+#define GROUP_SHARED_CANDIDATES ((1u << IDX_COMMON_SENDER) | (1u << IDX_COMMON_FEE) | \
+                                 (1u << IDX_COMMON_GEN_ID) | (1u << IDX_COMMON_GEN_HASH) | \
+                                 (1u << IDX_COMMON_GROUP_ID))
+
+// Items before the shared ones: group size and signed members
+#define GROUP_SUMMARY_ITEMS     2
+
+// "16/16 " in front of member keys
+#define GROUP_KEY_PREFIX_LEN    7
+
+static const uint8_t groupHashPrefix[] = {'T', 'G'};
+static const uint8_t txnHashPrefix[] = {'T', 'X'};
+
+parser_error_t parser_groupInit(parser_group_t *group)
+{
+    if (group == NULL) {
+        return parser_unexpected_value;
+    }
+    MEMZERO(group, sizeof(parser_group_t));
+    group->state = GROUP_SCAN_COUNT;
+    group->error = parser_ok;
+    group->current = GROUP_MAX_TXNS;
+    return parser_ok;
+}
+
+static parser_error_t _groupScan(parser_group_t *g, uint8_t *chunk, uint16_t chunkLen)
+{
+    if (chunkLen > UINT16_MAX - g->offset) {
+        return parser_buffer_too_small;
+    }
+
+    uint16_t i = 0;
+    while (i < chunkLen) {
+        switch (g->state) {
+            case GROUP_SCAN_COUNT:
+                if (chunk[i] == 0 || chunk[i] > GROUP_MAX_TXNS) {
+                    return parser_unexpected_number_items;
+                }
+                g->numTxns = chunk[i];
+                g->state = GROUP_SCAN_MASK_HI;
+                break;
+
+            case GROUP_SCAN_MASK_HI:
+                g->signMask = (uint16_t) (chunk[i] << 8);
+                g->state = GROUP_SCAN_MASK_LO;
+                break;
+
+            case GROUP_SCAN_MASK_LO:
+                g->signMask |= chunk[i];
+                // At least one member is signed, and only members that exist
+                if (g->signMask == 0 || (g->numTxns < 16 && (g->signMask >> g->numTxns) != 0)) {
+                    return parser_unexpected_value;
+                }
+                g->state = GROUP_SCAN_LEN_HI;
+                break;
+
+            case GROUP_SCAN_LEN_HI:
+                g->txnOffset[g->numScanned] = g->offset + i;
+                g->txnLeft = (uint16_t) (chunk[i] << 8);
+                chunk[i] = txnHashPrefix[0];
+                g->state = GROUP_SCAN_LEN_LO;
+                break;
+
+            case GROUP_SCAN_LEN_LO:
+                g->txnLeft |= chunk[i];
+                chunk[i] = txnHashPrefix[1];
+                if (g->txnLeft == 0) {
+                    return parser_unexpected_buffer_end;
+                }
+                g->txnLen[g->numScanned] = g->txnLeft;
+                g->numScanned++;
+                g->state = GROUP_SCAN_TXN;
+                break;
+
+            case GROUP_SCAN_TXN: {
+                // Member bytes are kept as they are
+                const uint16_t avail = chunkLen - i;
+                const uint16_t take = g->txnLeft < avail ? g->txnLeft : avail;
+                g->txnLeft -= take;
+                i += take;
+                if (g->txnLeft == 0) {
+                    g->state = (g->numScanned == g->numTxns) ? GROUP_SCAN_DONE : GROUP_SCAN_LEN_HI;
+                }
+                continue;
+            }
+
+            default:
+                // Bytes after the last member
+                return parser_unexpected_characters;
+        }
+        i++;
+    }
+
+    g->offset += chunkLen;
+    return parser_ok;
+}
+
+parser_error_t parser_groupScan(parser_group_t *group, uint8_t *chunk, uint16_t chunkLen)
+{
+    if (group == NULL || (chunk == NULL && chunkLen > 0)) {
+        return parser_unexpected_value;
+    }
+    if (group->error == parser_ok) {
+        group->error = _groupScan(group, chunk, chunkLen);
+    }
+    return group->error;
+}
+
+static parser_error_t parser_groupLoadTxn(parser_group_t *g, parser_context_t *ctx, parser_tx_t *tx, uint8_t idx)
+{
+    if (idx >= g->numTxns) {
+        return parser_display_idx_out_of_range;
+    }
+    if (g->current == idx && ctx->parser_tx_obj == tx) {
+        return parser_ok;
+    }
+
+    g->current = GROUP_MAX_TXNS;
+    MEMZERO(tx, sizeof(parser_tx_t));
+    CHECK_ERROR(parser_parse(ctx, g->buffer + g->txnOffset[idx] + GROUP_TXN_PREFIX_LEN, g->txnLen[idx], tx))
+    g->current = idx;
+    return parser_ok;
+}
+
+// The group ID commits to the ID each member had before grp was set: SHA512/256 of
+// "TX" || member without its grp entry. Keys are sorted and unique, so removing the
+// entry and shrinking the map header gives the canonical encoding of that transaction.
+static parser_error_t parser_groupTxnHash(const parser_context_t *ctx, uint8_t *hash)
+{
+    const parser_key_entry_t *grp = NULL;
+    uint16_t mapEnd = 0;
+    for (uint8_t i = 0; i < ctx->numKeys; i++) {
+        const parser_key_entry_t *entry = &ctx->keys[i];
+        if (entry->keyId == KEYID_COMMON_GROUP_ID) {
+            grp = entry;
+        }
+        const uint16_t valueEnd = KEY_VALUE_OFFSET(entry) + entry->valueLen;
+        if (valueEnd > mapEnd) {
+            mapEnd = valueEnd;
+        }
+    }
+    if (grp == NULL) {
+        return parser_missing_field;
+    }
+    // Bytes after the map would be signed without being covered by the group ID
+    if (mapEnd != ctx->bufferLen) {
+        return parser_unexpected_characters;
+    }
+
+    const uint16_t entryStart = grp->keyOffset - 1;
+    const uint16_t entryEnd = KEY_VALUE_OFFSET(grp) + grp->valueLen;
+    if (ctx->buffer[entryStart] != FIXSTR_0 + grp->keyLen) {
+        return parser_msgpack_str_type_not_supported;
+    }
+
+    uint16_t headerLen = 0;
+    if (ctx->buffer[0] >= FIXMAP_0 && ctx->buffer[0] <= FIXMAP_15) {
+        headerLen = 1;
+    } else if (ctx->buffer[0] == MAP16) {
+        headerLen = 3;
+    } else {
+        return parser_msgpack_map_type_not_supported;
+    }
+
+    const uint16_t numKeys = ctx->numKeys - 1;
+    uint8_t header[3] = {0};
+    uint8_t newHeaderLen = 1;
+    if (numKeys <= FIXMAP_15 - FIXMAP_0) {
+        header[0] = (uint8_t) (FIXMAP_0 + numKeys);
+    } else {
+        header[0] = MAP16;
+        header[1] = (uint8_t) (numKeys >> 8);
+        header[2] = (uint8_t) numKeys;
+        newHeaderLen = 3;
+    }
+
+    SHA512_256_CTX sha;
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256_Init(&sha);
+    SHA512_256_Update(&sha, txnHashPrefix, sizeof(txnHashPrefix));
+    SHA512_256_Update(&sha, header, newHeaderLen);
+    SHA512_256_Update(&sha, ctx->buffer + headerLen, entryStart - headerLen);
+    SHA512_256_Update(&sha, ctx->buffer + entryEnd, ctx->bufferLen - entryEnd);
+    SHA512_256_Final(&sha, digest);
+    MEMCPY(hash, digest, GROUP_ID_LEN);
+    return parser_ok;
+}
+
+// Common items of the member in ctx that may be shared
+static uint16_t parser_groupCandidates(const parser_context_t *ctx)
+{
+    uint16_t present = 0;
+    for (uint8_t i = 0; i < ctx->display.common_num_items; i++) {
+        uint8_t commonIdx = 0;
+        if (getItem(ctx, i, &commonIdx) == parser_ok && commonIdx < 16) {
+            present |= (uint16_t) (1u << commonIdx);
+        }
+    }
+    return present & GROUP_SHARED_CANDIDATES;
+}
+
+static uint8_t parser_groupCountBits(uint16_t mask)
+{
+    uint8_t count = 0;
+    for (; mask != 0; mask &= (uint16_t) (mask - 1)) {
+        count++;
+    }
+    return count;
+}
+
+parser_error_t parser_groupVerify(parser_group_t *group,
+                                  parser_context_t *ctx, parser_tx_t *tx,
+                                  const uint8_t *buffer, uint16_t bufferLen)
+{
+    if (group == NULL || ctx == NULL || tx == NULL || buffer == NULL) {
+        return parser_unexpected_value;
+    }
+    CHECK_ERROR(group->error)
+    if (group->state != GROUP_SCAN_DONE || group->offset != bufferLen) {
+        return parser_unexpected_buffer_end;
+    }
+
+    group->buffer = buffer;
+    group->current = GROUP_MAX_TXNS;
+    group->numItems = 0;
+
+    // Values of the first member, the others are compared with them
+    uint8_t sender[ACCT_SIZE];
+    uint8_t genesisHash[HASH_SIZE];
+    char genesisID[sizeof(tx->genesisID)];
+    uint64_t fee = 0;
+    uint16_t shared = GROUP_SHARED_CANDIDATES;
+    uint16_t present[GROUP_MAX_TXNS];
+
+    // msgpack of {"txlist": [member IDs]}
+    const uint8_t txlistHeader[] = {FIXMAP_0 + 1, FIXSTR_0 + 6, 't', 'x', 'l', 'i', 's', 't'};
+    const uint8_t idHeader[] = {BIN8, GROUP_ID_LEN};
+    uint8_t arrayHeader[3] = {FIXARR_0 + group->numTxns, 0, 0};
+    uint8_t arrayHeaderLen = 1;
+    if (group->numTxns > FIXARR_15 - FIXARR_0) {
+        arrayHeader[0] = ARR16;
+        arrayHeader[2] = group->numTxns;
+        arrayHeaderLen = 3;
+    }
+
+    SHA512_256_CTX sha;
+    SHA512_256_Init(&sha);
+    SHA512_256_Update(&sha, groupHashPrefix, sizeof(groupHashPrefix));
+    SHA512_256_Update(&sha, txlistHeader, sizeof(txlistHeader));
+    SHA512_256_Update(&sha, arrayHeader, arrayHeaderLen);
+
+    for (uint8_t i = 0; i < group->numTxns; i++) {
+        CHECK_ERROR(parser_groupLoadTxn(group, ctx, tx, i))
+        CHECK_ERROR(parser_validateStructure(ctx))
+
+        uint8_t txnId[GROUP_ID_LEN];
+        CHECK_ERROR(parser_groupTxnHash(ctx, txnId))
+        SHA512_256_Update(&sha, idHeader, sizeof(idHeader));
+        SHA512_256_Update(&sha, txnId, sizeof(txnId));
+
+        if (i == 0) {
+            MEMCPY(group->groupId, tx->groupID, GROUP_ID_LEN);
+            MEMCPY(sender, tx->sender, sizeof(sender));
+            MEMCPY(genesisHash, tx->genesisHash, sizeof(genesisHash));
+            MEMCPY(genesisID, tx->genesisID, sizeof(genesisID));
+            fee = tx->fee;
+        } else {
+            if (memcmp(group->groupId, tx->groupID, GROUP_ID_LEN) != 0) {
+                return parser_group_id_mismatch;
+            }
+            if (memcmp(sender, tx->sender, sizeof(sender)) != 0) {
+                shared &= ~(1u << IDX_COMMON_SENDER);
+            }
+            if (fee != tx->fee) {
+                shared &= ~(1u << IDX_COMMON_FEE);
+            }
+            if (memcmp(genesisID, tx->genesisID, sizeof(genesisID)) != 0) {
+                shared &= ~(1u << IDX_COMMON_GEN_ID);
+            }
+            if (memcmp(genesisHash, tx->genesisHash, sizeof(genesisHash)) != 0) {
+                shared &= ~(1u << IDX_COMMON_GEN_HASH);
+            }
+        }
+
+        present[i] = parser_groupCandidates(ctx);
+        group->txnItems[i] = _getNumItems(ctx);
+    }
+
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256_Final(&sha, digest);
+    if (memcmp(digest, group->groupId, GROUP_ID_LEN) != 0) {
+        return parser_group_id_mismatch;
+    }
+
+    group->sharedMask = shared;
+    group->headerItems = GROUP_SUMMARY_ITEMS + parser_groupCountBits(present[0] & shared);
+    uint16_t numItems = group->headerItems;
+    for (uint8_t i = 0; i < group->numTxns; i++) {
+        group->txnItems[i] -= parser_groupCountBits(present[i] & shared);
+        numItems += group->txnItems[i];
+    }
+    if (numItems > GROUP_MAX_ITEMS) {
+        return parser_unexpected_number_items;
+    }
+    group->numItems = (uint8_t) numItems;
+    return parser_ok;
+}
+
+parser_error_t parser_groupGetNumItems(const parser_group_t *group, uint8_t *numItems)
+{
+    if (group == NULL || numItems == NULL) {
+        return parser_unexpected_value;
+    }
+    *numItems = group->numItems;
+    if (*numItems == 0) {
+        return parser_unexpected_number_items;
+    }
+    return parser_ok;
+}
+
+static bool parser_groupIsShared(const parser_group_t *g, const parser_context_t *ctx, uint8_t displayIdx)
+{
+    // Item 0 is the transaction type, common items follow it
+    if (displayIdx == 0 || displayIdx > ctx->display.common_num_items) {
+        return false;
+    }
+    uint8_t commonIdx = 0;
+    if (getItem(ctx, displayIdx - 1, &commonIdx) != parser_ok || commonIdx >= 16) {
+        return false;
+    }
+    return (g->sharedMask & (1u << commonIdx)) != 0;
+}
+
+// Display index, within the member in ctx, of its n-th shared or n-th own item
+static parser_error_t parser_groupFindItem(const parser_group_t *g, const parser_context_t *ctx,
+                                           bool shared, uint8_t n, uint8_t *displayIdx)
+{
+    const uint8_t numItems = _getNumItems(ctx);
+    for (uint8_t i = 0; i < numItems; i++) {
+        if (parser_groupIsShared(g, ctx, i) != shared) {
+            continue;
+        }
+        if (n == 0) {
+            *displayIdx = i;
+            return parser_ok;
+        }
+        n--;
+    }
+    return parser_display_idx_out_of_range;
+}
+
+static parser_error_t parser_groupPrintSummary(const parser_group_t *g, uint8_t displayIdx,
+                                               char *outKey, uint16_t outKeyLen,
+                                               char *outVal, uint16_t outValLen,
+                                               uint8_t pageIdx, uint8_t *pageCount)
+{
+    *pageCount = 1;
+    if (displayIdx == 0) {
+        snprintf(outKey, outKeyLen, "Group");
+        snprintf(outVal, outValLen, "%d txns", g->numTxns);
+        return parser_ok;
+    }
+
+    // "1, 2, ..., 16"
+    char buff[GROUP_MAX_TXNS * 4] = {0};
+    uint16_t len = 0;
+    for (uint8_t i = 0; i < g->numTxns; i++) {
+        if ((g->signMask & (1u << i)) == 0) {
+            continue;
+        }
+        len += snprintf(buff + len, sizeof(buff) - len, len == 0 ? "%d" : ", %d", i + 1);
+    }
+    snprintf(outKey, outKeyLen, "Sign txns");
+    pageString(outVal, outValLen, buff, pageIdx, pageCount);
+    return parser_ok;
+}
+
+parser_error_t parser_groupGetItem(parser_group_t *group,
+                                   parser_context_t *ctx, parser_tx_t *tx,
+                                   uint8_t displayIdx,
+                                   char *outKey, uint16_t outKeyLen,
+                                   char *outVal, uint16_t outValLen,
+                                   uint8_t pageIdx, uint8_t *pageCount)
+{
+    if (group == NULL || ctx == NULL || tx == NULL ||
+        outKey == NULL || outVal == NULL || pageCount == NULL || outKeyLen == 0) {
+        return parser_unexpected_value;
+    }
+    if (displayIdx >= group->numItems) {
+        return parser_display_idx_out_of_range;
+    }
+
+    if (displayIdx < GROUP_SUMMARY_ITEMS) {
+        MEMZERO(outKey, outKeyLen);
+        MEMZERO(outVal, outValLen);
+        return parser_groupPrintSummary(group, displayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+    }
+
+    // Shared items are shown as the first member has them
+    uint8_t txnDisplayIdx = 0;
+    if (displayIdx < group->headerItems) {
+        CHECK_ERROR(parser_groupLoadTxn(group, ctx, tx, 0))
+        CHECK_ERROR(parser_groupFindItem(group, ctx, true, displayIdx - GROUP_SUMMARY_ITEMS, &txnDisplayIdx))
+        return parser_getItem(ctx, txnDisplayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+    }
+
+    uint8_t idx = displayIdx - group->headerItems;
+    uint8_t txn = 0;
+    while (idx >= group->txnItems[txn]) {
+        idx -= group->txnItems[txn];
+        txn++;
+    }
+    CHECK_ERROR(parser_groupLoadTxn(group, ctx, tx, txn))
+    CHECK_ERROR(parser_groupFindItem(group, ctx, false, idx, &txnDisplayIdx))
+
+    // Member keys start with "i/n ", written in front of what the parser formats
+    char prefix[GROUP_KEY_PREFIX_LEN];
+    const int prefixLen = snprintf(prefix, sizeof(prefix), "%d/%d ", txn + 1, group->numTxns);
+    if (prefixLen <= 0 || (uint16_t) prefixLen >= outKeyLen) {
+        return parser_getItem(ctx, txnDisplayIdx, outKey, outKeyLen, outVal, outValLen, pageIdx, pageCount);
+    }
+    CHECK_ERROR(parser_getItem(ctx, txnDisplayIdx, outKey + prefixLen, outKeyLen - prefixLen,
+                               outVal, outValLen, pageIdx, pageCount))
+    MEMCPY(outKey, prefix, prefixLen);
+    return parser_ok;
+}
+
+parser_error_t parser_groupGetSignedTxn(const parser_group_t *group, uint8_t idx,
+                                        const uint8_t **message, uint16_t *messageLen)
+{
+    if (group == NULL || message == NULL || messageLen == NULL || group->buffer == NULL) {
+        return parser_unexpected_value;
+    }
+    if (idx >= group->numTxns || group->numItems == 0) {
+        return parser_display_idx_out_of_range;
+    }
+    if ((group->signMask & (1u << idx)) == 0) {
+        return parser_unexpected_value;
+    }
+    *message = group->buffer + group->txnOffset[idx];
+    *messageLen = group->txnLen[idx] + GROUP_TXN_PREFIX_LEN;
+    return parser_ok;
+}
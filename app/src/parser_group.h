@@ -0,0 +1,87 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "parser_common.h"
+#include <stdint.h>
+
+// Atomic transaction group reviewed and signed in one session. It is uploaded as
+//   count (1) || sign mask (2, big endian, bit i signs member i) || [length (2, big endian) || msgpack] x count
+// While scanning, every length is overwritten with "TX", so the group buffer holds
+// each member exactly as the message its signature covers.
+#define GROUP_MAX_TXNS          16
+#define GROUP_HEADER_LEN        3
+#define GROUP_TXN_PREFIX_LEN    2
+#define GROUP_ID_LEN            32
+// Review items are addressed with an int8_t by the UI
+#define GROUP_MAX_ITEMS         127
+
+typedef struct {
+    // Filled by parser_groupScan as the chunks arrive
+    uint16_t txnOffset[GROUP_MAX_TXNS];     // "TX" prefix of each member in the group buffer
+    uint16_t txnLen[GROUP_MAX_TXNS];        // msgpack length, prefix excluded
+    uint16_t signMask;
+    uint8_t numTxns;
+    uint8_t numScanned;     // Members whose length was read
+    uint16_t offset;        // Group bytes scanned so far
+    uint16_t txnLeft;       // Bytes of the current member still to come
+    uint8_t state;
+    // First error found, every later call returns it
+    parser_error_t error;
+
+    // Filled by parser_groupVerify
+    const uint8_t *buffer;
+    uint8_t groupId[GROUP_ID_LEN];
+    uint16_t sharedMask;    // Bit n set when IDX_COMMON item n is the same in every member
+    uint8_t headerItems;    // Group summary and shared items, shown once
+    uint8_t txnItems[GROUP_MAX_TXNS];   // Items left to show for each member
+    uint8_t numItems;
+    uint8_t current;        // Member parsed into the context, GROUP_MAX_TXNS if none
+} parser_group_t;
+
+//// starts a group upload
+parser_error_t parser_groupInit(parser_group_t *group);
+
+//// scans the next chunk of the upload, replacing member lengths with "TX" in place
+parser_error_t parser_groupScan(parser_group_t *group, uint8_t *chunk, uint16_t chunkLen);
+
+//// parses every member of the scanned group and checks their grp against the group ID
+//// recomputed from them. ctx and tx are reused to show the members afterwards.
+parser_error_t parser_groupVerify(parser_group_t *group,
+                                  parser_context_t *ctx, parser_tx_t *tx,
+                                  const uint8_t *buffer, uint16_t bufferLen);
+
+parser_error_t parser_groupGetNumItems(const parser_group_t *group, uint8_t *numItems);
+
+// retrieves a readable output for each field / page of the group review
+parser_error_t parser_groupGetItem(parser_group_t *group,
+                                   parser_context_t *ctx, parser_tx_t *tx,
+                                   uint8_t displayIdx,
+                                   char *outKey, uint16_t outKeyLen,
+                                   char *outVal, uint16_t outValLen,
+                                   uint8_t pageIdx, uint8_t *pageCount);
+
+//// returns "TX" || msgpack of member idx, only for members in the sign mask
+parser_error_t parser_groupGetSignedTxn(const parser_group_t *group, uint8_t idx,
+                                        const uint8_t **message, uint16_t *messageLen);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,264 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "parser_group_build.h"
+
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOS2) && !defined(TARGET_NANOX) && !defined(TARGET_STAX)
+
+#include <string.h>
+#include <zxmacros.h>
+
+#include "parser_impl.h"
+#include "msgpack.h"
+#include "sha512.h"
+
+static const uint8_t grpKey[] = {'g', 'r', 'p'};
+
+// Canonical msgpack orders keys bytewise, a key sorts before any longer key it prefixes
+static int keyCompare(const uint8_t *a, uint8_t aLen, const uint8_t *b, uint8_t bLen)
+{
+    const int cmp = memcmp(a, b, aLen < bLen ? aLen : bLen);
+    if (cmp != 0) {
+        return cmp;
+    }
+    return (int) aLen - (int) bLen;
+}
+
+static uint8_t mapHeader(uint16_t numKeys, uint8_t *header)
+{
+    if (numKeys <= FIXMAP_15 - FIXMAP_0) {
+        header[0] = (uint8_t) (FIXMAP_0 + numKeys);
+        return 1;
+    }
+    header[0] = MAP16;
+    header[1] = (uint8_t) (numKeys >> 8);
+    header[2] = (uint8_t) numKeys;
+    return 3;
+}
+
+parser_error_t group_txnLayout(const uint8_t *data, uint16_t len, group_txn_layout_t *layout)
+{
+    if (data == NULL || layout == NULL) {
+        return parser_unexpected_value;
+    }
+    MEMZERO(layout, sizeof(group_txn_layout_t));
+
+    parser_context_t ctx;
+    CHECK_ERROR(parser_init(&ctx, data, len))
+    CHECK_ERROR(_buildKeyIndex(&ctx))
+    if (ctx.offset != len) {
+        return parser_unexpected_characters;
+    }
+    if (ctx.numKeys == 0) {
+        return parser_no_data;
+    }
+    layout->bodyOffset = ctx.keys[0].keyOffset - 1;
+
+    bool insertFound = false;
+    for (uint8_t i = 0; i < ctx.numKeys; i++) {
+        const parser_key_entry_t *entry = &ctx.keys[i];
+        // Only fixstr keys, so the entry starts one byte before the key
+        if (data[entry->keyOffset - 1] != FIXSTR_0 + entry->keyLen) {
+            return parser_msgpack_str_type_not_supported;
+        }
+        if (i > 0) {
+            const parser_key_entry_t *prev = &ctx.keys[i - 1];
+            if (keyCompare(data + prev->keyOffset, prev->keyLen, data + entry->keyOffset, entry->keyLen) >= 0) {
+                return parser_msgpack_unexpected_key;
+            }
+        }
+
+        const int cmp = keyCompare(data + entry->keyOffset, entry->keyLen, grpKey, sizeof(grpKey));
+        if (cmp == 0) {
+            if (entry->valueLen != GROUP_GRP_ENTRY_LEN - 1 - sizeof(grpKey) ||
+                data[KEY_VALUE_OFFSET(entry)] != BIN8 || data[KEY_VALUE_OFFSET(entry) + 1] != GROUP_ID_LEN) {
+                return parser_msgpack_bin_unexpected_size;
+            }
+            layout->grpOffset = entry->keyOffset - 1;
+            layout->grpLen = GROUP_GRP_ENTRY_LEN;
+            insertFound = true;
+        } else if (cmp > 0 && !insertFound) {
+            layout->grpOffset = entry->keyOffset - 1;
+            insertFound = true;
+        }
+    }
+    if (!insertFound) {
+        layout->grpOffset = len;
+    }
+
+    layout->numKeys = ctx.numKeys - (layout->grpLen != 0 ? 1 : 0);
+    layout->headerLen = mapHeader(layout->numKeys, layout->header);
+    return parser_ok;
+}
+
+uint32_t group_txnIdMessage(const uint8_t *data, uint16_t len, const group_txn_layout_t *layout,
+                            uint8_t *out, uint32_t outLen)
+{
+    if (data == NULL || layout == NULL || out == NULL) {
+        return 0;
+    }
+    const uint16_t head = layout->grpOffset - layout->bodyOffset;
+    const uint16_t tailOffset = layout->grpOffset + layout->grpLen;
+    const uint32_t messageLen = 2 + layout->headerLen + head + (uint32_t) (len - tailOffset);
+    if (messageLen > outLen) {
+        return 0;
+    }
+
+    uint8_t *p = out;
+    *p++ = 'T';
+    *p++ = 'X';
+    MEMCPY(p, layout->header, layout->headerLen);
+    p += layout->headerLen;
+    MEMCPY(p, data + layout->bodyOffset, head);
+    p += head;
+    MEMCPY(p, data + tailOffset, len - tailOffset);
+    return messageLen;
+}
+
+uint32_t group_idMessage(const uint8_t (*txnIds)[GROUP_ID_LEN], uint8_t count,
+                         uint8_t *out, uint32_t outLen)
+{
+    static const uint8_t prefix[] = {'T', 'G', FIXMAP_0 + 1, FIXSTR_0 + 6, 't', 'x', 'l', 'i', 's', 't'};
+
+    if (txnIds == NULL || out == NULL || count == 0 || count > GROUP_MAX_TXNS) {
+        return 0;
+    }
+    const uint8_t arrayHeaderLen = count > FIXARR_15 - FIXARR_0 ? 3 : 1;
+    const uint32_t messageLen = sizeof(prefix) + arrayHeaderLen + count * (2u + GROUP_ID_LEN);
+    if (messageLen > outLen) {
+        return 0;
+    }
+
+    uint8_t *p = out;
+    MEMCPY(p, prefix, sizeof(prefix));
+    p += sizeof(prefix);
+    if (arrayHeaderLen == 1) {
+        *p++ = (uint8_t) (FIXARR_0 + count);
+    } else {
+        *p++ = ARR16;
+        *p++ = 0;
+        *p++ = count;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        *p++ = BIN8;
+        *p++ = GROUP_ID_LEN;
+        MEMCPY(p, txnIds[i], GROUP_ID_LEN);
+        p += GROUP_ID_LEN;
+    }
+    return messageLen;
+}
+
+uint32_t group_txnGroupedLen(uint16_t len, const group_txn_layout_t *layout)
+{
+    if (layout == NULL || layout->grpLen != 0) {
+        return len;
+    }
+    uint8_t header[3];
+    const uint8_t headerLen = mapHeader(layout->numKeys + 1, header);
+    return (uint32_t) len + (headerLen - layout->bodyOffset) + GROUP_GRP_ENTRY_LEN;
+}
+
+parser_error_t group_txnSetGroup(group_txn_t *txn, const group_txn_layout_t *layout, const uint8_t *groupId)
+{
+    if (txn == NULL || txn->data == NULL || layout == NULL || groupId == NULL) {
+        return parser_unexpected_value;
+    }
+    if (layout->grpLen != 0) {
+        MEMCPY(txn->data + layout->grpOffset + GROUP_GRP_ENTRY_LEN - GROUP_ID_LEN, groupId, GROUP_ID_LEN);
+        return parser_ok;
+    }
+    if (group_txnGroupedLen(txn->len, layout) > txn->capacity) {
+        return parser_buffer_too_small;
+    }
+
+    uint8_t header[3];
+    const uint8_t headerLen = mapHeader(layout->numKeys + 1, header);
+    const uint16_t headerGrowth = headerLen - layout->bodyOffset;
+    uint8_t *data = txn->data;
+
+    // Keys after grp move by the whole growth, keys before it only by the header growth
+    memmove(data + layout->grpOffset + headerGrowth + GROUP_GRP_ENTRY_LEN,
+            data + layout->grpOffset, txn->len - layout->grpOffset);
+    if (headerGrowth != 0) {
+        memmove(data + headerLen, data + layout->bodyOffset, layout->grpOffset - layout->bodyOffset);
+    }
+    MEMCPY(data, header, headerLen);
+
+    uint8_t *entry = data + layout->grpOffset + headerGrowth;
+    entry[0] = FIXSTR_0 + sizeof(grpKey);
+    MEMCPY(entry + 1, grpKey, sizeof(grpKey));
+    entry[4] = BIN8;
+    entry[5] = GROUP_ID_LEN;
+    MEMCPY(entry + 6, groupId, GROUP_ID_LEN);
+
+    txn->len += headerGrowth + GROUP_GRP_ENTRY_LEN;
+    return parser_ok;
+}
+
+parser_error_t group_build(group_txn_t *txns, uint8_t count,
+                           uint8_t (*txnIds)[GROUP_ID_LEN], uint8_t *groupId)
+{
+    if (txns == NULL || groupId == NULL) {
+        return parser_unexpected_value;
+    }
+    if (count == 0 || count > GROUP_MAX_TXNS) {
+        return parser_unexpected_number_items;
+    }
+
+    group_txn_layout_t layouts[GROUP_MAX_TXNS];
+    uint8_t ids[GROUP_MAX_TXNS][GROUP_ID_LEN];
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256_CTX sha;
+
+    for (uint8_t i = 0; i < count; i++) {
+        group_txn_layout_t *layout = &layouts[i];
+        const group_txn_t *txn = &txns[i];
+        if (txn->data == NULL) {
+            return parser_no_data;
+        }
+        CHECK_ERROR(group_txnLayout(txn->data, txn->len, layout))
+        if (group_txnGroupedLen(txn->len, layout) > txn->capacity) {
+            return parser_buffer_too_small;
+        }
+
+        // Same bytes group_txnIdMessage writes, hashed where they are
+        const uint16_t tailOffset = layout->grpOffset + layout->grpLen;
+        SHA512_256_Init(&sha);
+        SHA512_256_Update(&sha, (const uint8_t *) "TX", 2);
+        SHA512_256_Update(&sha, layout->header, layout->headerLen);
+        SHA512_256_Update(&sha, txn->data + layout->bodyOffset, layout->grpOffset - layout->bodyOffset);
+        SHA512_256_Update(&sha, txn->data + tailOffset, txn->len - tailOffset);
+        SHA512_256_Final(&sha, digest);
+        MEMCPY(ids[i], digest, GROUP_ID_LEN);
+    }
+
+    uint8_t message[GROUP_ID_MESSAGE_MAX];
+    const uint32_t messageLen = group_idMessage((const uint8_t (*)[GROUP_ID_LEN]) ids, count, message, sizeof(message));
+    SHA512_256_Init(&sha);
+    SHA512_256_Update(&sha, message, messageLen);
+    SHA512_256_Final(&sha, digest);
+    MEMCPY(groupId, digest, GROUP_ID_LEN);
+
+    for (uint8_t i = 0; i < count; i++) {
+        CHECK_ERROR(group_txnSetGroup(&txns[i], &layouts[i], groupId))
+    }
+    if (txnIds != NULL) {
+        MEMCPY(txnIds, ids, sizeof(ids[0]) * count);
+    }
+    return parser_ok;
+}
+
+#endif
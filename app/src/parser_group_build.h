@@ -0,0 +1,85 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "parser_common.h"
+#include "parser_group.h"
+#include <stdint.h>
+
+// Host-side assembly of atomic groups: the txid of every member (its grp left out),
+// the group ID over them, and grp written back into each member. Members must be
+// canonical msgpack, the encoding is only touched at the map header and grp entry.
+#if !defined(TARGET_NANOS) && !defined(TARGET_NANOS2) && !defined(TARGET_NANOX) && !defined(TARGET_STAX)
+
+// a3 "grp" c4 20 <group ID>
+#define GROUP_GRP_ENTRY_LEN     (1 + 3 + 2 + GROUP_ID_LEN)
+// Extra room a member may need: the grp entry, and a fixmap header growing into a map16
+#define GROUP_BUILD_MAX_GROWTH  (GROUP_GRP_ENTRY_LEN + 2)
+// "TG" || {"txlist": [bin8 txid] x GROUP_MAX_TXNS}
+#define GROUP_ID_MESSAGE_MAX    (2 + 8 + 3 + GROUP_MAX_TXNS * (2 + GROUP_ID_LEN))
+
+typedef struct {
+    uint8_t *data;          // Canonical msgpack transaction, grp is written in place
+    uint16_t len;           // Updated when grp is inserted
+    uint16_t capacity;      // Bytes available at data
+} group_txn_t;
+
+// Where grp sits in a member, from group_txnLayout
+typedef struct {
+    uint16_t bodyOffset;    // First key, right after the map header
+    uint16_t grpOffset;     // Start of the grp entry, or where it goes when there is none
+    uint16_t grpLen;        // 0 or GROUP_GRP_ENTRY_LEN
+    uint16_t numKeys;       // Keys other than grp
+    uint8_t header[3];      // Map header for numKeys
+    uint8_t headerLen;
+} group_txn_layout_t;
+
+/// Indexes a member and locates its grp entry
+/// \return parser_msgpack_unexpected_key if keys are not sorted, parser_unexpected_characters
+///         if bytes follow the map
+parser_error_t group_txnLayout(const uint8_t *data, uint16_t len, group_txn_layout_t *layout);
+
+/// Writes "TX" || member without grp, the message hashed into its txid
+/// \return message length, 0 if it does not fit outLen
+uint32_t group_txnIdMessage(const uint8_t *data, uint16_t len, const group_txn_layout_t *layout,
+                            uint8_t *out, uint32_t outLen);
+
+/// Writes "TG" || msgpack {"txlist": txnIds}, the message hashed into the group ID
+/// \return message length, 0 if count or outLen are out of range
+uint32_t group_idMessage(const uint8_t (*txnIds)[GROUP_ID_LEN], uint8_t count,
+                         uint8_t *out, uint32_t outLen);
+
+/// Length of a member of len bytes once grp is set
+uint32_t group_txnGroupedLen(uint16_t len, const group_txn_layout_t *layout);
+
+/// Sets grp to groupId, in place when the member has one and inserted in key order otherwise.
+/// layout is stale afterwards.
+parser_error_t group_txnSetGroup(group_txn_t *txn, const group_txn_layout_t *layout, const uint8_t *groupId);
+
+/// Builds one group: txnIds (optional) gets the member IDs the group ID covers, groupId the
+/// group ID, and grp is set in every member. No member is modified if any of them fails.
+parser_error_t group_build(group_txn_t *txns, uint8_t count,
+                           uint8_t (*txnIds)[GROUP_ID_LEN], uint8_t *groupId);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,28 +16,22 @@
 
 #include "parser_impl.h"
 #include "msgpack.h"
-
-static uint8_t num_items;
-static uint8_t common_num_items;
-static uint8_t tx_num_items;
+#include "parser_keys.h"
 
 #define MAX_PARAM_SIZE 12
-#define MAX_ITEM_ARRAY 50
-static uint8_t itemArray[MAX_ITEM_ARRAY] = {0};
-static uint8_t itemIndex = 0;
 
 DEC_READFIX_UNSIGNED(8);
 DEC_READFIX_UNSIGNED(16);
 DEC_READFIX_UNSIGNED(32);
 DEC_READFIX_UNSIGNED(64);
 
-static parser_error_t addItem(uint8_t displayIdx);
-static parser_error_t _findKey(parser_context_t *c, const char *key);
+static parser_error_t addItem(parser_context_t *c, uint8_t displayIdx);
+static parser_error_t _findKey(parser_context_t *c, parser_key_id_e keyId);
 
 #define DISPLAY_ITEM(type, len, counter)        \
     for(uint8_t j = 0; j < len; j++) {          \
-        CHECK_ERROR(addItem(type))              \
-        counter++;                              \
+        CHECK_ERROR(addItem(c, type))           \
+        c->display.counter++;                   \
     }
 
 parser_error_t parser_init_context(parser_context_t *ctx,
@@ -50,9 +44,13 @@ parser_error_t parser_init_context(parser_context_t *ctx,
     ctx->offset = 0;
     ctx->buffer = NULL;
     ctx->bufferLen = 0;
-    num_items = 0;
-    common_num_items = 0;
-    tx_num_items = 0;
+    ctx->numKeys = 0;
+    ctx->keyMask = 0;
+    ctx->bytesScanned = 0;
+    ctx->display.num_items = 0;
+    ctx->display.common_num_items = 0;
+    ctx->display.tx_num_items = 0;
+    ctx->display.itemIndex = 0;
 
     ctx->buffer = buffer;
     ctx->bufferLen = bufferSize;
@@ -64,44 +62,119 @@ parser_error_t parser_init(parser_context_t *ctx, const uint8_t *buffer, uint16_
     return parser_ok;
 }
 
-static parser_error_t initializeItemArray()
+static parser_error_t initializeItemArray(parser_context_t *c)
 {
     for(uint8_t i = 0; i < MAX_ITEM_ARRAY; i++) {
-        itemArray[i] = 0xFF;
+        c->display.itemArray[i] = 0xFF;
     }
-    itemIndex = 0;
+    c->display.itemIndex = 0;
     return parser_ok;
 }
 
-parser_error_t addItem(uint8_t displayIdx)
+parser_error_t addItem(parser_context_t *c, uint8_t displayIdx)
 {
-    if(itemIndex >= MAX_ITEM_ARRAY) {
+    if(c->display.itemIndex >= MAX_ITEM_ARRAY) {
         return parser_unexpected_buffer_end;
     }
-    itemArray[itemIndex] = displayIdx;
-    itemIndex++;
+    c->display.itemArray[c->display.itemIndex] = displayIdx;
+    c->display.itemIndex++;
 
     return parser_ok;
 }
 
-parser_error_t getItem(uint8_t index, uint8_t* displayIdx)
+parser_error_t getItem(const parser_context_t *ctx, uint8_t index, uint8_t* displayIdx)
 {
-    if(index >= itemIndex) {
+    if (ctx == NULL || displayIdx == NULL) {
+        return parser_unexpected_value;
+    }
+    if(index >= ctx->display.itemIndex) {
         return parser_display_page_out_of_range;
     }
-    *displayIdx = itemArray[index];
+    *displayIdx = ctx->display.itemArray[index];
     return parser_ok;
 }
 
-static uint8_t getMsgPackType(uint8_t byte)
-{
-    if (byte >= FIXMAP_0 && byte <= FIXARR_15) {
-        return FIXMAP_0;
-    } else if (byte >= FIXSTR_0 && byte <= FIXSTR_31) {
-        return FIXSTR_0;
-    }
-    return byte;
-}
+#define T_NONE   MSGPACK_CLASS_INVALID
+#define T_FINT   (MSGPACK_CLASS_UINT | MSGPACK_FIELD_INLINE)
+#define T_UINT8  (MSGPACK_CLASS_UINT | 1)
+#define T_UINT16 (MSGPACK_CLASS_UINT | 2)
+#define T_UINT32 (MSGPACK_CLASS_UINT | 4)
+#define T_UINT64 (MSGPACK_CLASS_UINT | 8)
+#define T_FMAP   (MSGPACK_CLASS_MAP | MSGPACK_FIELD_INLINE)
+#define T_MAP16  (MSGPACK_CLASS_MAP | 2)
+#define T_MAP32  (MSGPACK_CLASS_MAP | 4)
+#define T_FARR   (MSGPACK_CLASS_ARRAY | MSGPACK_FIELD_INLINE)
+#define T_ARR16  (MSGPACK_CLASS_ARRAY | 2)
+#define T_ARR32  (MSGPACK_CLASS_ARRAY | 4)
+#define T_FSTR   (MSGPACK_CLASS_STR | MSGPACK_FIELD_INLINE)
+#define T_STR8   (MSGPACK_CLASS_STR | 1)
+#define T_STR16  (MSGPACK_CLASS_STR | 2)
+#define T_STR32  (MSGPACK_CLASS_STR | 4)
+#define T_BIN8   (MSGPACK_CLASS_BIN | 1)
+#define T_BIN16  (MSGPACK_CLASS_BIN | 2)
+#define T_BIN32  (MSGPACK_CLASS_BIN | 4)
+#define T_BOOL   (MSGPACK_CLASS_BOOL | 0)
+
+// Class and length-field size of every msgpack type byte, shared by the readers and the value skipper.
+// nil, floats, signed ints and ext types are not used by Algorand transactions and are rejected.
+static const uint8_t msgpackTypeTable[256] = {
+    /* 0x00 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x08 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x10 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x18 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x20 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x28 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x30 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x38 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x40 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x48 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x50 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x58 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x60 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x68 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x70 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x78 */ T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,   T_FINT,
+    /* 0x80 */ T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,
+    /* 0x88 */ T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,   T_FMAP,
+    /* 0x90 */ T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,
+    /* 0x98 */ T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,   T_FARR,
+    /* 0xa0 */ T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,
+    /* 0xa8 */ T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,
+    /* 0xb0 */ T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,
+    /* 0xb8 */ T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,   T_FSTR,
+    /* 0xc0 */ T_NONE,   T_NONE,   T_BOOL,   T_BOOL,   T_BIN8,   T_BIN16,  T_BIN32,  T_NONE,
+    /* 0xc8 */ T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_UINT8,  T_UINT16, T_UINT32, T_UINT64,
+    /* 0xd0 */ T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,
+    /* 0xd8 */ T_NONE,   T_STR8,   T_STR16,  T_STR32,  T_ARR16,  T_ARR32,  T_MAP16,  T_MAP32,
+    /* 0xe0 */ T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,
+    /* 0xe8 */ T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,
+    /* 0xf0 */ T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,
+    /* 0xf8 */ T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE,   T_NONE
+};
+
+#undef T_NONE
+#undef T_FINT
+#undef T_UINT8
+#undef T_UINT16
+#undef T_UINT32
+#undef T_UINT64
+#undef T_FMAP
+#undef T_MAP16
+#undef T_MAP32
+#undef T_FARR
+#undef T_ARR16
+#undef T_ARR32
+#undef T_FSTR
+#undef T_STR8
+#undef T_STR16
+#undef T_STR32
+#undef T_BIN8
+#undef T_BIN16
+#undef T_BIN32
+#undef T_BOOL
+
+#define MSGPACK_CLASS(byte)      (msgpackTypeTable[(byte)] & MSGPACK_CLASS_MASK)
+#define MSGPACK_FIELD_SIZE(byte) (msgpackTypeTable[(byte)] & MSGPACK_FIELD_MASK)
 
 parser_error_t _readMapSize(parser_context_t *c, uint16_t *mapItems)
 {
@@ -112,21 +185,21 @@ parser_error_t _readMapSize(parser_context_t *c, uint16_t *mapItems)
     uint8_t byte = 0;
     CHECK_ERROR(_readUInt8(c, &byte))
 
-    switch (getMsgPackType(byte)) {
-        case FIXMAP_0:
+    if (MSGPACK_CLASS(byte) != MSGPACK_CLASS_MAP) {
+        return parser_msgpack_unexpected_type;
+    }
+
+    switch (MSGPACK_FIELD_SIZE(byte)) {
+        case MSGPACK_FIELD_INLINE:
             *mapItems = (uint16_t) byte - FIXMAP_0;
         break;
 
-        case MAP16:
+        case 2:
             CHECK_ERROR(_readUInt16(c, mapItems))
         break;
 
-        case MAP32:
-            return parser_msgpack_map_type_not_supported;
-        break;
-
         default:
-            return parser_msgpack_unexpected_type;
+            return parser_msgpack_map_type_not_supported;
     }
     return parser_ok;
 }
@@ -136,12 +209,15 @@ parser_error_t _readArraySize(parser_context_t *c, uint8_t *arrayItems)
     uint8_t byte = 0;
     CHECK_ERROR(_readUInt8(c, &byte))
 
-    if (byte >= FIXARR_0 && byte <= FIXARR_15) {
-        *arrayItems = byte - FIXARR_0;
-        return parser_ok;
+    if (MSGPACK_CLASS(byte) != MSGPACK_CLASS_ARRAY) {
+        return parser_msgpack_unexpected_type;
     }
-    switch (byte) {
-        case ARR16: {
+
+    switch (MSGPACK_FIELD_SIZE(byte)) {
+        case MSGPACK_FIELD_INLINE:
+            *arrayItems = byte - FIXARR_0;
+            return parser_ok;
+        case 2: {
             uint16_t tmpItems = 0;
             CHECK_ERROR(_readUInt16(c, &tmpItems))
             if(tmpItems > UINT8_MAX) {
@@ -150,8 +226,8 @@ parser_error_t _readArraySize(parser_context_t *c, uint8_t *arrayItems)
             *arrayItems = (uint8_t) tmpItems;
             return parser_ok;
         }
-        case ARR32:
-            // Not supported
+        default:
+            // ARR32 not supported
             break;
     }
 
@@ -181,34 +257,36 @@ parser_error_t _readBytes(parser_context_t *c, uint8_t *buff, uint16_t buffLen)
     return parser_ok;
 }
 
-parser_error_t _readString(parser_context_t *c, uint8_t *buff, uint16_t buffLen)
+static parser_error_t _readStrSize(parser_context_t *c, uint8_t *strLen)
 {
     uint8_t byte = 0;
-    uint8_t strLen = 0;
     CHECK_ERROR(_readUInt8(c, &byte))
-    memset(buff, 0, buffLen);
-
-    switch (getMsgPackType(byte)) {
-    case FIXSTR_0:
-        strLen = byte - FIXSTR_0;
-        break;
 
-    case STR8:
-        CHECK_ERROR(_readUInt8(c, &strLen))
-        break;
+    if (MSGPACK_CLASS(byte) != MSGPACK_CLASS_STR) {
+        return parser_msgpack_str_type_expected;
+    }
 
-    case STR16:
-        return parser_msgpack_str_type_not_supported;
+    switch (MSGPACK_FIELD_SIZE(byte)) {
+    case MSGPACK_FIELD_INLINE:
+        *strLen = byte - FIXSTR_0;
         break;
 
-    case STR32:
-        return parser_msgpack_str_type_not_supported;
+    case 1:
+        CHECK_ERROR(_readUInt8(c, strLen))
         break;
 
     default:
-        return parser_msgpack_str_type_expected;
-        break;
+        // STR16 and STR32
+        return parser_msgpack_str_type_not_supported;
     }
+    return parser_ok;
+}
+
+parser_error_t _readString(parser_context_t *c, uint8_t *buff, uint16_t buffLen)
+{
+    uint8_t strLen = 0;
+    memset(buff, 0, buffLen);
+    CHECK_ERROR(_readStrSize(c, &strLen))
 
     if (strLen >= buffLen) {
         return parser_msgpack_str_too_big;
@@ -217,131 +295,151 @@ parser_error_t _readString(parser_context_t *c, uint8_t *buff, uint16_t buffLen)
     return parser_ok;
 }
 
+// Classifies a key through the generated perfect hash (see parser_keys.h)
+static uint8_t _lookupKeyId(const uint8_t *key, uint8_t keyLen)
+{
+    if (keyLen == 0 || keyLen > PARSER_KEY_MAX_PACKED_LEN) {
+        return KEYID_UNKNOWN;
+    }
+
+    uint64_t packed = (uint64_t)keyLen << 56;
+    for (uint8_t i = 0; i < keyLen; i++) {
+        packed |= (uint64_t)key[i] << (8 * i);
+    }
+
+    const uint8_t keyId = parserKeyHashTable[PARSER_KEY_HASH(packed)];
+    if (keyId == KEYID_UNKNOWN || parserKeyPacked[keyId] != packed) {
+        return KEYID_UNKNOWN;
+    }
+    return keyId;
+}
+
+// Reads a string and returns its key id without copying it
+static parser_error_t _readKeyId(parser_context_t *c, uint8_t *keyId)
+{
+    uint8_t keyLen = 0;
+    const uint8_t *key = NULL;
+    CHECK_ERROR(_readStrSize(c, &keyLen))
+    CHECK_ERROR(_getPointerBytes(c, &key, keyLen))
+    *keyId = _lookupKeyId(key, keyLen);
+    return parser_ok;
+}
+
+static parser_error_t _getPointerString(parser_context_t *c, const uint8_t **buff, uint8_t *strLen, uint8_t maxLen)
+{
+    CHECK_ERROR(_readStrSize(c, strLen))
+
+    if (*strLen > maxLen) {
+        return parser_msgpack_str_too_big;
+    }
+    CHECK_ERROR(_getPointerBytes(c, buff, *strLen))
+    return parser_ok;
+}
+
 parser_error_t _readInteger(parser_context_t *c, uint64_t* value)
 {
     uint8_t intType = 0;
     CHECK_ERROR(_readBytes(c, &intType, 1))
 
-    if (intType >= FIXINT_0 && intType <= FIXINT_127) {
-        *value = intType - FIXINT_0;
-        return parser_ok;
+    if (MSGPACK_CLASS(intType) != MSGPACK_CLASS_UINT) {
+        return parser_msgpack_int_type_expected;
     }
 
-    switch (intType)
+    switch (MSGPACK_FIELD_SIZE(intType))
     {
-    case UINT8: {
+    case MSGPACK_FIELD_INLINE:
+        *value = intType - FIXINT_0;
+        break;
+    case 1: {
         uint8_t tmp = 0;
         CHECK_ERROR(_readUInt8(c, &tmp))
         *value = (uint64_t)tmp;
         break;
     }
-    case UINT16: {
+    case 2: {
         uint16_t tmp = 0;
         CHECK_ERROR(_readUInt16(c, &tmp))
         *value = (uint64_t)tmp;
         break;
     }
-    case UINT32: {
+    case 4: {
         uint32_t tmp = 0;
         CHECK_ERROR(_readUInt32(c, &tmp))
         *value = (uint64_t)tmp;
         break;
     }
-    case UINT64: {
+    default: {
         CHECK_ERROR(_readUInt64(c, value))
         break;
     }
-    default:
-        return parser_msgpack_int_type_expected;
-        break;
     }
 
     return parser_ok;
 }
 
-parser_error_t _readBinFixed(parser_context_t *c, uint8_t *buff, uint16_t bufferLen)
+static parser_error_t _readBinSize(parser_context_t *c, uint16_t *binSize)
 {
     uint8_t binType = 0;
-    uint8_t binLen = 0;
     CHECK_ERROR(_readUInt8(c, &binType))
-    switch (binType)
-    {
-        case BIN8: {
-            CHECK_ERROR(_readUInt8(c, &binLen))
-            break;
-        }
-        case BIN16:
-        case BIN32: {
-            return parser_msgpack_bin_type_not_supported;
-            break;
-        }
-        default: {
-            return parser_msgpack_bin_type_expected;
-            break;
-        }
-    }
 
-    if(binLen != bufferLen) {
-        return parser_msgpack_bin_unexpected_size;
+    if (MSGPACK_CLASS(binType) != MSGPACK_CLASS_BIN) {
+        return parser_msgpack_bin_type_expected;
     }
-    CHECK_ERROR(_readBytes(c, buff, bufferLen))
-    return parser_ok;
-}
 
-static parser_error_t _readBinSize(parser_context_t *c, uint16_t *binSize)
-{
-    uint8_t binType = 0;
-    CHECK_ERROR(_readUInt8(c, &binType))
-    switch (binType)
+    switch (MSGPACK_FIELD_SIZE(binType))
     {
-        case BIN8: {
+        case 1: {
             uint8_t tmp = 0;
             CHECK_ERROR(_readUInt8(c, &tmp))
             *binSize = (uint16_t)tmp;
             break;
         }
-        case BIN16: {
+        case 2: {
             CHECK_ERROR(_readUInt16(c, binSize))
             break;
         }
-        case BIN32: {
-            return parser_msgpack_bin_type_not_supported;
-            break;
-        }
         default: {
-            return parser_msgpack_bin_type_expected;
-            break;
+            // BIN32 not supported
+            return parser_msgpack_bin_type_not_supported;
         }
     }
     return parser_ok;
 }
 
-static parser_error_t _verifyBin(parser_context_t *c, uint16_t *buffer_len, uint16_t max_buffer_len)
+static parser_error_t _getPointerBinFixed(parser_context_t *c, const uint8_t **buff, uint16_t bufferLen)
 {
     uint8_t binType = 0;
-    uint16_t binLen = 0;
+    uint8_t binLen = 0;
     CHECK_ERROR(_readUInt8(c, &binType))
-    switch (binType)
-    {
-        case BIN8: {
-            uint8_t tmp = 0;
-            CHECK_ERROR(_readUInt8(c, &tmp))
-            binLen = (uint16_t)tmp;
-            break;
-        }
-        case BIN16: {
-            CHECK_ERROR(_readUInt16(c, &binLen))
-            break;
-        }
-        case BIN32: {
-            return parser_msgpack_bin_type_not_supported;
-            break;
-        }
-        default: {
-            return parser_msgpack_bin_type_expected;
-            break;
-        }
+
+    if (MSGPACK_CLASS(binType) != MSGPACK_CLASS_BIN) {
+        return parser_msgpack_bin_type_expected;
+    }
+    // Fixed size fields are always encoded as BIN8
+    if (binType != BIN8) {
+        return parser_msgpack_bin_type_not_supported;
     }
+    CHECK_ERROR(_readUInt8(c, &binLen))
+
+    if(binLen != bufferLen) {
+        return parser_msgpack_bin_unexpected_size;
+    }
+    CHECK_ERROR(_getPointerBytes(c, buff, bufferLen))
+    return parser_ok;
+}
+
+parser_error_t _readBinFixed(parser_context_t *c, uint8_t *buff, uint16_t bufferLen)
+{
+    const uint8_t *tmp = NULL;
+    CHECK_ERROR(_getPointerBinFixed(c, &tmp, bufferLen))
+    MEMCPY(buff, tmp, bufferLen);
+    return parser_ok;
+}
+
+static parser_error_t _verifyBin(parser_context_t *c, uint16_t *buffer_len, uint16_t max_buffer_len)
+{
+    uint16_t binLen = 0;
+    CHECK_ERROR(_readBinSize(c, &binLen))
 
     if(binLen > max_buffer_len) {
         return parser_msgpack_bin_unexpected_size;
@@ -354,30 +452,8 @@ static parser_error_t _verifyBin(parser_context_t *c, uint16_t *buffer_len, uint
 
 static parser_error_t _readBin(parser_context_t *c, uint8_t *buff, uint16_t *bufferLen, uint16_t bufferMaxSize)
 {
-    uint8_t binType = 0;
     uint16_t binLen = 0;
-    CHECK_ERROR(_readUInt8(c, &binType))
-    switch (binType)
-    {
-        case BIN8: {
-            uint8_t tmp = 0;
-            CHECK_ERROR(_readUInt8(c, &tmp))
-            binLen = (uint16_t)tmp;
-            break;
-        }
-        case BIN16: {
-            CHECK_ERROR(_readUInt16(c, &binLen))
-            break;
-        }
-        case BIN32: {
-            return parser_msgpack_bin_type_not_supported;
-            break;
-        }
-        default: {
-            return parser_msgpack_bin_type_expected;
-            break;
-        }
-    }
+    CHECK_ERROR(_readBinSize(c, &binLen))
 
     if(binLen > bufferMaxSize) {
         return parser_msgpack_bin_unexpected_size;
@@ -388,43 +464,13 @@ static parser_error_t _readBin(parser_context_t *c, uint8_t *buff, uint16_t *buf
     return parser_ok;
 }
 
-
 static parser_error_t _getPointerBin(parser_context_t *c, const uint8_t **buff, uint16_t *bufferLen)
 {
-    uint8_t binType = 0;
-    uint16_t binLen = 0;
-    CHECK_ERROR(_readUInt8(c, &binType))
-    switch (binType)
-    {
-        case BIN8: {
-            uint8_t tmp = 0;
-            CHECK_ERROR(_readUInt8(c, &tmp))
-            binLen = (uint16_t)tmp;
-            break;
-        }
-        case BIN16: {
-            CHECK_ERROR(_readUInt16(c, &binLen))
-            break;
-        }
-        case BIN32: {
-            return parser_msgpack_bin_type_not_supported;
-            break;
-        }
-        default: {
-            return parser_msgpack_bin_type_expected;
-            break;
-        }
-    }
-
-    *bufferLen = binLen;
-
+    CHECK_ERROR(_readBinSize(c, bufferLen))
     CHECK_ERROR(_getPointerBytes(c, buff, *bufferLen));
-
-
     return parser_ok;
 }
 
-
 parser_error_t _readBool(parser_context_t *c, uint8_t *value)
 {
     uint8_t tmp = 0;
@@ -452,6 +498,7 @@ static parser_error_t _readAssetParams(parser_context_t *c, txn_asset_config *as
 {
     uint8_t available_params[MAX_PARAM_SIZE];
     memset(available_params, 0xFF, MAX_PARAM_SIZE);
+    MEMZERO(&asset_config->params, sizeof(asset_config->params));
 
     uint16_t paramsSize = 0;
     CHECK_ERROR(_readMapSize(c, &paramsSize))
@@ -460,77 +507,68 @@ static parser_error_t _readAssetParams(parser_context_t *c, txn_asset_config *as
         return parser_unexpected_number_items;
     }
 
-    uint8_t key[10] = {0};
+    uint8_t keyId = KEYID_UNKNOWN;
     for(uint16_t i = 0; i < paramsSize; i++) {
-        CHECK_ERROR(_readString(c, key, sizeof(key)))
-
-        if (strncmp((char*)key, KEY_APARAMS_TOTAL, strlen(KEY_APARAMS_TOTAL)) == 0) {
-            CHECK_ERROR(_readInteger(c, &asset_config->params.total))
-            available_params[IDX_CONFIG_TOTAL_UNITS] = IDX_CONFIG_TOTAL_UNITS;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_DEF_FROZEN, strlen(KEY_APARAMS_DEF_FROZEN)) == 0) {
-            CHECK_ERROR(_readBool(c, &asset_config->params.default_frozen))
-            available_params[IDX_CONFIG_FROZEN] = IDX_CONFIG_FROZEN;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_UNIT_NAME, strlen(KEY_APARAMS_UNIT_NAME)) == 0) {
-            memset(asset_config->params.unitname, 0, sizeof(asset_config->params.unitname));
-            CHECK_ERROR(_readString(c, (uint8_t*)asset_config->params.unitname, sizeof(asset_config->params.unitname)))
-            available_params[IDX_CONFIG_UNIT_NAME] = IDX_CONFIG_UNIT_NAME;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_DECIMALS, strlen(KEY_APARAMS_DECIMALS)) == 0) {
-            CHECK_ERROR(_readInteger(c, &asset_config->params.decimals))
-            available_params[IDX_CONFIG_DECIMALS] = IDX_CONFIG_DECIMALS;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_ASSET_NAME, strlen(KEY_APARAMS_ASSET_NAME)) == 0) {
-            memset(asset_config->params.assetname, 0, sizeof(asset_config->params.assetname));
-            CHECK_ERROR(_readString(c, (uint8_t*)asset_config->params.assetname, sizeof(asset_config->params.assetname)))
-            available_params[IDX_CONFIG_ASSET_NAME] = IDX_CONFIG_ASSET_NAME;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_URL, strlen(KEY_APARAMS_URL)) == 0) {
-            memset(asset_config->params.url, 0, sizeof(asset_config->params.url));
-            CHECK_ERROR(_readString(c, (uint8_t*)asset_config->params.url, sizeof(asset_config->params.url)))
-            available_params[IDX_CONFIG_URL] = IDX_CONFIG_URL;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_METADATA_HASH, strlen(KEY_APARAMS_METADATA_HASH)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.metadata_hash, sizeof(asset_config->params.metadata_hash)))
-            available_params[IDX_CONFIG_METADATA_HASH] = IDX_CONFIG_METADATA_HASH;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_MANAGER, strlen(KEY_APARAMS_MANAGER)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.manager, sizeof(asset_config->params.manager)))
-            available_params[IDX_CONFIG_MANAGER] = IDX_CONFIG_MANAGER;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_RESERVE, strlen(KEY_APARAMS_RESERVE)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.reserve, sizeof(asset_config->params.reserve)))
-            available_params[IDX_CONFIG_RESERVE] = IDX_CONFIG_RESERVE;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_FREEZE, strlen(KEY_APARAMS_FREEZE)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.freeze, sizeof(asset_config->params.freeze)))
-            available_params[IDX_CONFIG_FREEZER] = IDX_CONFIG_FREEZER;
-            continue;
-        }
-
-        if (strncmp((char*)key, KEY_APARAMS_CLAWBACK, strlen(KEY_APARAMS_CLAWBACK)) == 0) {
-            CHECK_ERROR(_readBinFixed(c, asset_config->params.clawback, sizeof(asset_config->params.clawback)))
-            available_params[IDX_CONFIG_CLAWBACK] = IDX_CONFIG_CLAWBACK;
-            continue;
+        CHECK_ERROR(_readKeyId(c, &keyId))
+
+        switch (keyId) {
+            case KEYID_APARAMS_TOTAL:
+                CHECK_ERROR(_readInteger(c, &asset_config->params.total))
+                available_params[IDX_CONFIG_TOTAL_UNITS] = IDX_CONFIG_TOTAL_UNITS;
+                break;
+
+            case KEYID_APARAMS_DEF_FROZEN:
+                CHECK_ERROR(_readBool(c, &asset_config->params.default_frozen))
+                available_params[IDX_CONFIG_FROZEN] = IDX_CONFIG_FROZEN;
+                break;
+
+            case KEYID_APARAMS_UNIT_NAME:
+                CHECK_ERROR(_getPointerString(c, &asset_config->params.unitname, &asset_config->params.unitname_len, ASA_UNIT_NAME_MAX_LENGTH))
+                available_params[IDX_CONFIG_UNIT_NAME] = IDX_CONFIG_UNIT_NAME;
+                break;
+
+            case KEYID_APARAMS_DECIMALS:
+                CHECK_ERROR(_readInteger(c, &asset_config->params.decimals))
+                available_params[IDX_CONFIG_DECIMALS] = IDX_CONFIG_DECIMALS;
+                break;
+
+            case KEYID_APARAMS_ASSET_NAME:
+                CHECK_ERROR(_getPointerString(c, &asset_config->params.assetname, &asset_config->params.assetname_len, ASA_NAME_MAX_LENGTH))
+                available_params[IDX_CONFIG_ASSET_NAME] = IDX_CONFIG_ASSET_NAME;
+                break;
+
+            case KEYID_APARAMS_URL:
+                CHECK_ERROR(_getPointerString(c, &asset_config->params.url, &asset_config->params.url_len, ASA_URL_MAX_LENGTH))
+                available_params[IDX_CONFIG_URL] = IDX_CONFIG_URL;
+                break;
+
+            case KEYID_APARAMS_METADATA_HASH:
+                CHECK_ERROR(_getPointerBinFixed(c, &asset_config->params.metadata_hash, HASH_SIZE))
+                available_params[IDX_CONFIG_METADATA_HASH] = IDX_CONFIG_METADATA_HASH;
+                break;
+
+            case KEYID_APARAMS_MANAGER:
+                CHECK_ERROR(_getPointerBinFixed(c, &asset_config->params.manager, ACCT_SIZE))
+                available_params[IDX_CONFIG_MANAGER] = IDX_CONFIG_MANAGER;
+                break;
+
+            case KEYID_APARAMS_RESERVE:
+                CHECK_ERROR(_getPointerBinFixed(c, &asset_config->params.reserve, ACCT_SIZE))
+                available_params[IDX_CONFIG_RESERVE] = IDX_CONFIG_RESERVE;
+                break;
+
+            case KEYID_APARAMS_FREEZE:
+                CHECK_ERROR(_getPointerBinFixed(c, &asset_config->params.freeze, ACCT_SIZE))
+                available_params[IDX_CONFIG_FREEZER] = IDX_CONFIG_FREEZER;
+                break;
+
+            case KEYID_APARAMS_CLAWBACK:
+                CHECK_ERROR(_getPointerBinFixed(c, &asset_config->params.clawback, ACCT_SIZE))
+                available_params[IDX_CONFIG_CLAWBACK] = IDX_CONFIG_CLAWBACK;
+                break;
+
+            default:
+                return parser_msgpack_unexpected_key;
         }
     }
 
@@ -580,7 +618,7 @@ static parser_error_t _readAssetParams(parser_context_t *c, txn_asset_config *as
     return parser_ok;
 }
 
-parser_error_t _verifyAppArgs(parser_context_t *c, uint16_t args_len[], uint8_t *args_array_len, size_t max_array_len)
+parser_error_t _verifyAppArgs(parser_context_t *c, const uint8_t *args[], uint16_t args_len[], uint8_t *args_array_len, size_t max_array_len)
 {
     CHECK_ERROR(_readArraySize(c, args_array_len))
     if (*args_array_len > max_array_len) {
@@ -589,32 +627,12 @@ parser_error_t _verifyAppArgs(parser_context_t *c, uint16_t args_len[], uint8_t
 
     for (uint8_t i = 0; i < *args_array_len; i++) {
         CHECK_ERROR(_verifyBin(c, &args_len[i], MAX_ARGLEN))
+        args[i] = c->buffer + c->offset - args_len[i];
     }
 
     return parser_ok;
 }
 
-parser_error_t _getAppArg(parser_context_t *c, uint8_t **args, uint16_t* args_len, uint8_t args_idx, uint16_t max_args_len, uint8_t max_array_len)
-{
-    uint8_t tmp_array_len = 0;
-    CHECK_ERROR(_findKey(c, KEY_APP_ARGS))
-    CHECK_ERROR(_readArraySize(c, &tmp_array_len))
-
-    if(tmp_array_len > max_array_len || args_idx >= tmp_array_len) {
-        return parser_unexpected_number_items;
-    }
-
-    for(uint8_t i = 0; i < args_idx + 1; i++) {
-        CHECK_ERROR(_verifyBin(c, args_len, max_args_len))
-    }
-
-    if (c->offset < *args_len) {
-        return parser_unexpected_value;
-    }
-    (*args) = (uint8_t*)(c->buffer + c->offset - *args_len);
-    return parser_ok;
-}
-
 parser_error_t _readAppArgs(parser_context_t *c, uint8_t args[][MAX_ARGLEN], size_t args_len[], size_t *argsSize, size_t maxArgs)
 {
     uint8_t tmpFIX = 0;
@@ -641,27 +659,11 @@ parser_error_t _readAccountsSize(parser_context_t *c, uint8_t *numAccounts, uint
     return parser_ok;
 }
 
-parser_error_t _getAccount(parser_context_t *c, uint8_t* account, uint8_t account_idx, uint8_t num_accounts)
+parser_error_t _verifyAccounts(parser_context_t *c, const uint8_t *accounts[], uint8_t* num_accounts, uint8_t maxNumAccounts)
 {
-    uint8_t tmp_num_accounts = 0;
-    CHECK_ERROR(_findKey(c, KEY_APP_ACCOUNTS))
-    CHECK_ERROR(_readAccountsSize(c, &tmp_num_accounts, num_accounts))
-    if(tmp_num_accounts != num_accounts || account_idx >= num_accounts) {
-        return parser_unexpected_number_items;
-    }
-    // Read until we get the right account index
-    for (uint8_t i = 0; i < account_idx + 1; i++) {
-        CHECK_ERROR(_readBinFixed(c, account, ACCT_SIZE))
-    }
-    return parser_ok;
-}
-
-parser_error_t _verifyAccounts(parser_context_t *c, uint8_t* num_accounts, uint8_t maxNumAccounts)
-{
-    uint8_t tmpBuf[ACCT_SIZE] = {0};
     CHECK_ERROR(_readAccountsSize(c, num_accounts, maxNumAccounts))
     for (uint8_t i = 0; i < *num_accounts; i++) {
-        CHECK_ERROR(_readBinFixed(c, tmpBuf, sizeof(tmpBuf)))
+        CHECK_ERROR(_getPointerBinFixed(c, &accounts[i], ACCT_SIZE))
     }
     return parser_ok;
 }
@@ -670,15 +672,18 @@ parser_error_t _readStateSchema(parser_context_t *c, state_schema *schema)
 {
     uint16_t mapSize = 0;
     CHECK_ERROR(_readMapSize(c, &mapSize))
-    uint8_t key[32];
+    uint8_t keyId = KEYID_UNKNOWN;
     for (uint16_t i = 0; i < mapSize; i++) {
-        CHECK_ERROR(_readString(c, key, sizeof(key)))
-        if (strncmp((char*)key, KEY_SCHEMA_NUI, sizeof(KEY_SCHEMA_NUI)) == 0) {
-            CHECK_ERROR(_readInteger(c, &schema->num_uint))
-        } else if (strncmp((char*)key, KEY_SCHEMA_NBS, sizeof(KEY_SCHEMA_NBS)) == 0) {
-            CHECK_ERROR(_readInteger(c, &schema->num_byteslice))
-        } else {
-            return parser_msgpack_unexpected_key;
+        CHECK_ERROR(_readKeyId(c, &keyId))
+        switch (keyId) {
+            case KEYID_SCHEMA_NUI:
+                CHECK_ERROR(_readInteger(c, &schema->num_uint))
+                break;
+            case KEYID_SCHEMA_NBS:
+                CHECK_ERROR(_readInteger(c, &schema->num_byteslice))
+                break;
+            default:
+                return parser_msgpack_unexpected_key;
         }
     }
     return parser_ok;
@@ -699,7 +704,7 @@ parser_error_t _readArrayU64(parser_context_t *c, uint64_t elements[], uint8_t *
 
 __Z_INLINE parser_error_t _readBoxElement(parser_context_t *c, box *box) {
 
-    uint8_t key[2] = {0};
+    uint8_t keyId = KEYID_UNKNOWN;
     uint16_t mapSize = 0;
     CHECK_ERROR(_readMapSize(c, &mapSize))
     box->i = 0;
@@ -707,18 +712,21 @@ __Z_INLINE parser_error_t _readBoxElement(parser_context_t *c, box *box) {
     box->n = NULL;
 
     for (uint16_t index = 0; index < mapSize; index++) {
-        CHECK_ERROR(_readString(c, key, sizeof(key)))
-        if (strncmp((char*)key, KEY_APP_BOX_INDEX, sizeof(KEY_APP_BOX_INDEX)) == 0) {
-            CHECK_ERROR(_readUInt8(c, &box->i))
-
-        } else if (strncmp((char*)key, KEY_APP_BOX_NAME, sizeof(KEY_APP_BOX_NAME)) == 0) {
-            CHECK_ERROR(_getPointerBin(c, &box->n, &box->n_len))
-
-            if (box->n_len > BOX_NAME_MAX_LENGTH) {
-                return parser_value_out_of_range;
-            }
-        } else {
-            return parser_unexpected_error;
+        CHECK_ERROR(_readKeyId(c, &keyId))
+        switch (keyId) {
+            case KEYID_APP_BOX_INDEX:
+                CHECK_ERROR(_readUInt8(c, &box->i))
+                break;
+
+            case KEYID_APP_BOX_NAME:
+                CHECK_ERROR(_getPointerBin(c, &box->n, &box->n_len))
+                if (box->n_len > BOX_NAME_MAX_LENGTH) {
+                    return parser_value_out_of_range;
+                }
+                break;
+
+            default:
+                return parser_unexpected_error;
         }
     }
 
@@ -741,25 +749,32 @@ parser_error_t _readBoxes(parser_context_t *c, box boxes[], uint8_t *num_element
 
 static parser_error_t _readTxType(parser_context_t *c, parser_tx_t *v)
 {
-    char typeStr[10] = {0};
-    CHECK_ERROR(_findKey(c, KEY_COMMON_TYPE))
-    CHECK_ERROR(_readString(c, (uint8_t*) typeStr, sizeof(typeStr)))
-
-    if (strncmp(typeStr, KEY_TX_PAY, sizeof(KEY_TX_PAY)) == 0) {
-        v->type = TX_PAYMENT;
-    } else if (strncmp(typeStr, KEY_TX_KEYREG, sizeof(KEY_TX_KEYREG)) == 0) {
-        v->type = TX_KEYREG;
-    } else if (strncmp(typeStr, KEY_TX_ASSET_XFER, sizeof(KEY_TX_ASSET_XFER)) == 0) {
-        v->type = TX_ASSET_XFER;
-    } else if (strncmp(typeStr, KEY_TX_ASSET_FREEZE, sizeof(KEY_TX_ASSET_FREEZE)) == 0) {
-        v->type = TX_ASSET_FREEZE;
-    } else if (strncmp(typeStr, KEY_TX_ASSET_CONFIG, sizeof(KEY_TX_ASSET_CONFIG)) == 0) {
-        v->type = TX_ASSET_CONFIG;
-    } else if (strncmp(typeStr, KEY_TX_APPLICATION, sizeof(KEY_TX_APPLICATION)) == 0) {
-        v->type = TX_APPLICATION;
-    } else {
-        v->type = TX_UNKNOWN;
-        return parser_no_data;
+    uint8_t typeId = KEYID_UNKNOWN;
+    CHECK_ERROR(_findKey(c, KEYID_COMMON_TYPE))
+    CHECK_ERROR(_readKeyId(c, &typeId))
+
+    switch (typeId) {
+        case KEYID_TX_PAY:
+            v->type = TX_PAYMENT;
+            break;
+        case KEYID_TX_KEYREG:
+            v->type = TX_KEYREG;
+            break;
+        case KEYID_TX_ASSET_XFER:
+            v->type = TX_ASSET_XFER;
+            break;
+        case KEYID_TX_ASSET_FREEZE:
+            v->type = TX_ASSET_FREEZE;
+            break;
+        case KEYID_TX_ASSET_CONFIG:
+            v->type = TX_ASSET_CONFIG;
+            break;
+        case KEYID_TX_APPLICATION:
+            v->type = TX_APPLICATION;
+            break;
+        default:
+            v->type = TX_UNKNOWN;
+            return parser_no_data;
     }
 
     return parser_ok;
@@ -767,45 +782,47 @@ static parser_error_t _readTxType(parser_context_t *c, parser_tx_t *v)
 
 static parser_error_t _readTxCommonParams(parser_context_t *c, parser_tx_t *v)
 {
-    common_num_items = 0;
+    c->display.common_num_items = 0;
 
-    MEMZERO(v->rekey, sizeof(v->rekey));
+    v->rekey = NULL;
+    v->lease = NULL;
+    v->groupID = NULL;
 
-    CHECK_ERROR(_findKey(c, KEY_COMMON_SENDER))
-    CHECK_ERROR(_readBinFixed(c, v->sender, sizeof(v->sender)))
+    CHECK_ERROR(_findKey(c, KEYID_COMMON_SENDER))
+    CHECK_ERROR(_getPointerBinFixed(c, &v->sender, ACCT_SIZE))
     DISPLAY_ITEM(IDX_COMMON_SENDER, 1, common_num_items)
 
-    if (_findKey(c, KEY_COMMON_LEASE) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->lease, sizeof(v->lease)))
+    if (_findKey(c, KEYID_COMMON_LEASE) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->lease, LEASE_SIZE))
         DISPLAY_ITEM(IDX_COMMON_LEASE, 1, common_num_items)
     }
 
-    if (_findKey(c, KEY_COMMON_REKEY) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->rekey, sizeof(v->rekey)))
+    if (_findKey(c, KEYID_COMMON_REKEY) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->rekey, ACCT_SIZE))
         DISPLAY_ITEM(IDX_COMMON_REKEY_TO, 1, common_num_items)
     }
 
     v->fee = 0;
-    if (_findKey(c, KEY_COMMON_FEE) == parser_ok) {
+    if (_findKey(c, KEYID_COMMON_FEE) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &v->fee))
     }
     DISPLAY_ITEM(IDX_COMMON_FEE, 1, common_num_items)
 
-    if (_findKey(c, KEY_COMMON_GEN_ID) == parser_ok) {
+    if (_findKey(c, KEYID_COMMON_GEN_ID) == parser_ok) {
         CHECK_ERROR(_readString(c, (uint8_t*)v->genesisID, sizeof(v->genesisID)))
         DISPLAY_ITEM(IDX_COMMON_GEN_ID, 1, common_num_items)
     }
 
-    CHECK_ERROR(_findKey(c, KEY_COMMON_GEN_HASH))
-    CHECK_ERROR(_readBinFixed(c, v->genesisHash, sizeof(v->genesisHash)))
+    CHECK_ERROR(_findKey(c, KEYID_COMMON_GEN_HASH))
+    CHECK_ERROR(_getPointerBinFixed(c, &v->genesisHash, HASH_SIZE))
     DISPLAY_ITEM(IDX_COMMON_GEN_HASH, 1, common_num_items)
 
-    if (_findKey(c, KEY_COMMON_GROUP_ID) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->groupID, sizeof(v->groupID)))
+    if (_findKey(c, KEYID_COMMON_GROUP_ID) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->groupID, HASH_SIZE))
         DISPLAY_ITEM(IDX_COMMON_GROUP_ID, 1, common_num_items)
     }
 
-    if (_findKey(c, KEY_COMMON_NOTE) == parser_ok) {
+    if (_findKey(c, KEYID_COMMON_NOTE) == parser_ok) {
         CHECK_ERROR(_readBinSize(c, &v->note_len))
         if(v->note_len > MAX_NOTE_LEN) {
             return parser_unexpected_value;
@@ -814,88 +831,194 @@ static parser_error_t _readTxCommonParams(parser_context_t *c, parser_tx_t *v)
     }
 
     // First and Last valid won't be display --> don't count them
-    CHECK_ERROR(_findKey(c, KEY_COMMON_FIRST_VALID))
+    CHECK_ERROR(_findKey(c, KEYID_COMMON_FIRST_VALID))
     CHECK_ERROR(_readInteger(c, &v->firstValid))
 
-    CHECK_ERROR(_findKey(c, KEY_COMMON_LAST_VALID))
+    CHECK_ERROR(_findKey(c, KEYID_COMMON_LAST_VALID))
     CHECK_ERROR(_readInteger(c, &v->lastValid))
 
     return parser_ok;
 }
 
+// Skips over one msgpack value without recursion: every open container pushes the
+// number of values still pending at the outer level on a stack bounded by MSGPACK_MAX_DEPTH
 static parser_error_t _verifyValue(parser_context_t *c) {
     if (c == NULL) return parser_unexpected_error;
 
     CHECK_APP_CANARY()
 
-    union {
-        uint8_t u8_number;
-        uint16_t u16_number;
-        uint64_t u64_number;
-    } tmp;
-
-    uint8_t valueType = 0;
-    CHECK_ERROR(_readUInt8(c, &valueType))
-
-    // Point to where value type is defined
-    c->offset--;
-
-    if (valueType <= FIXINT_127 || (valueType >= UINT8 && valueType <= UINT64)) {
-        CHECK_ERROR(_readInteger(c, &tmp.u64_number))
-
-    } else if (valueType <= FIXMAP_15 || valueType == MAP16) {
-        CHECK_ERROR(_readMapSize(c, &tmp.u16_number))
-        const uint16_t mapLen = tmp.u16_number;
-        for (uint16_t i = 0; i < mapLen; i++) {
-            // Check key
-            CHECK_ERROR(_verifyValue(c))
-            // Check value
-            CHECK_ERROR(_verifyValue(c))
+    uint32_t pending[MSGPACK_MAX_DEPTH];
+    uint8_t depth = 0;
+    uint32_t remaining = 1;
+
+    for (;;) {
+        while (remaining == 0) {
+            if (depth == 0) {
+                return parser_ok;
+            }
+            depth--;
+            remaining = pending[depth];
         }
+        remaining--;
+
+        uint8_t valueType = 0;
+        CHECK_ERROR(_readUInt8(c, &valueType))
+        const uint8_t fieldSize = MSGPACK_FIELD_SIZE(valueType);
+
+        uint32_t items = 0;
+        switch (MSGPACK_CLASS(valueType)) {
+            case MSGPACK_CLASS_UINT:
+            case MSGPACK_CLASS_BOOL:
+                if (fieldSize != MSGPACK_FIELD_INLINE) {
+                    CHECK_ERROR(_verifyBytes(c, fieldSize))
+                }
+                break;
+
+            case MSGPACK_CLASS_STR: {
+                uint8_t strLen = 0;
+                if (fieldSize == MSGPACK_FIELD_INLINE) {
+                    strLen = valueType - FIXSTR_0;
+                } else if (fieldSize == 1) {
+                    CHECK_ERROR(_readUInt8(c, &strLen))
+                } else {
+                    return parser_unexpected_value;
+                }
+                CHECK_ERROR(_verifyBytes(c, strLen))
+                break;
+            }
+
+            case MSGPACK_CLASS_BIN: {
+                uint16_t binLen = 0;
+                if (fieldSize == 1) {
+                    uint8_t tmp = 0;
+                    CHECK_ERROR(_readUInt8(c, &tmp))
+                    binLen = tmp;
+                } else if (fieldSize == 2) {
+                    CHECK_ERROR(_readUInt16(c, &binLen))
+                } else {
+                    return parser_unexpected_value;
+                }
+                CHECK_ERROR(_verifyBytes(c, binLen))
+                break;
+            }
+
+            case MSGPACK_CLASS_MAP: {
+                uint16_t mapLen = 0;
+                if (fieldSize == MSGPACK_FIELD_INLINE) {
+                    mapLen = valueType - FIXMAP_0;
+                } else if (fieldSize == 2) {
+                    CHECK_ERROR(_readUInt16(c, &mapLen))
+                } else {
+                    return parser_unexpected_value;
+                }
+                // Key and value
+                items = 2 * (uint32_t) mapLen;
+                break;
+            }
+
+            case MSGPACK_CLASS_ARRAY: {
+                uint16_t arrLen = 0;
+                if (fieldSize == MSGPACK_FIELD_INLINE) {
+                    arrLen = valueType - FIXARR_0;
+                } else if (fieldSize == 2) {
+                    CHECK_ERROR(_readUInt16(c, &arrLen))
+                    if (arrLen > UINT8_MAX) {
+                        return parser_unexpected_number_items;
+                    }
+                } else {
+                    return parser_unexpected_value;
+                }
+                items = arrLen;
+                break;
+            }
 
-    } else if (valueType <= FIXARR_15 || valueType == ARR16) {
-        CHECK_ERROR(_readArraySize(c, &tmp.u8_number))
-        const uint8_t arrLen = tmp.u8_number;
-        for (uint8_t i = 0; i < arrLen; i++) {
-            CHECK_ERROR(_verifyValue(c))
+            default:
+                return parser_unexpected_value;
         }
 
-    } else if (valueType <= FIXSTR_31) {
-        c->offset++;
-        const uint8_t strLen = valueType - FIXSTR_0;
-        CHECK_ERROR(_verifyBytes(c, strLen))
+        if (items > 0) {
+            if (depth >= MSGPACK_MAX_DEPTH) {
+                return parser_msgpack_depth_exceeded;
+            }
+            pending[depth] = remaining;
+            depth++;
+            remaining = items;
+        }
+    }
+}
 
-    } else if (valueType == STR8) {
-        c->offset++;
-        uint8_t strLen = 0;
-        CHECK_ERROR(_readUInt8(c, &strLen))
-        CHECK_ERROR(_verifyBytes(c, strLen))
+static parser_error_t _readKey(parser_context_t *c, uint16_t *keyOffset, uint8_t *keyLen)
+{
+    CHECK_ERROR(_readStrSize(c, keyLen))
 
-    } else if (valueType == BOOL_FALSE || valueType == BOOL_TRUE) {
-        CHECK_ERROR(_readBool(c, &tmp.u8_number))
+    if (*keyLen >= MAX_KEY_LEN) {
+        return parser_msgpack_str_too_big;
+    }
+    *keyOffset = c->offset;
+    CHECK_ERROR(_verifyBytes(c, *keyLen))
+    return parser_ok;
+}
 
-    } else if (valueType == BIN8 || valueType == BIN16) {
-        CHECK_ERROR(_verifyBin(c, &tmp.u16_number, UINT16_MAX))
+// Classifies key idx of the index and rejects it if it was already seen
+static parser_error_t _indexKey(parser_context_t *c, const uint8_t *buffer, uint8_t idx)
+{
+    parser_key_entry_t *entry = &c->keys[idx];
+    entry->keyId = _lookupKeyId(buffer + entry->keyOffset, entry->keyLen);
 
-    } else {
-        return parser_unexpected_value;
+    if (entry->keyId != KEYID_UNKNOWN) {
+        const uint64_t keyBit = (uint64_t)1 << entry->keyId;
+        if (c->keyMask & keyBit) {
+            return parser_duplicated_field;
+        }
+        c->keyMask |= keyBit;
+        return parser_ok;
     }
 
+    // Keys we do not use still have to be unique
+    for (uint8_t j = 0; j < idx; j++) {
+        if (c->keys[j].keyId == KEYID_UNKNOWN && c->keys[j].keyLen == entry->keyLen &&
+            memcmp(buffer + c->keys[j].keyOffset, buffer + entry->keyOffset, entry->keyLen) == 0) {
+            return parser_duplicated_field;
+        }
+    }
     return parser_ok;
 }
-parser_error_t _findKey(parser_context_t *c, const char *key) {
-    uint8_t tmpKey[20] = {0};
 
-    // Process buffer from start
-    c->offset = 0;
+parser_error_t _buildKeyIndex(parser_context_t *c)
+{
+    c->numKeys = 0;
+    c->keyMask = 0;
+
     uint16_t keysLen = 0;
     CHECK_ERROR(_readMapSize(c, &keysLen))
+    if (keysLen > MAX_TOP_LEVEL_KEYS) {
+        return parser_unexpected_number_items;
+    }
+
     for (uint16_t i = 0; i < keysLen; i++) {
-        CHECK_ERROR(_readString(c, tmpKey, sizeof(tmpKey)))
-        if (strncmp((char*)tmpKey, key, strlen(key)) == 0) {
+        parser_key_entry_t *entry = &c->keys[i];
+        CHECK_ERROR(_readKey(c, &entry->keyOffset, &entry->keyLen))
+        CHECK_ERROR(_indexKey(c, c->buffer, (uint8_t) i))
+
+        CHECK_ERROR(_verifyValue(c))
+        entry->valueLen = c->offset - KEY_VALUE_OFFSET(entry);
+        c->numKeys++;
+    }
+
+    return parser_ok;
+}
+
+// Positions the context at the value of a top-level key (requires the key index built by _read)
+parser_error_t _findKey(parser_context_t *c, parser_key_id_e keyId) {
+    if ((c->keyMask & ((uint64_t)1 << keyId)) == 0) {
+        return parser_no_data;
+    }
+
+    for (uint8_t i = 0; i < c->numKeys; i++) {
+        if (c->keys[i].keyId == keyId) {
+            c->offset = KEY_VALUE_OFFSET(&c->keys[i]);
             return parser_ok;
         }
-        CHECK_ERROR(_verifyValue(c))
     }
 
     return parser_no_data;
@@ -903,21 +1026,21 @@ parser_error_t _findKey(parser_context_t *c, const char *key) {
 
 static parser_error_t _readTxPayment(parser_context_t *c, parser_tx_t *v)
 {
-    tx_num_items = 0;
-    MEMZERO(v->payment.close, sizeof(v->payment.close));
+    c->display.tx_num_items = 0;
+    v->payment.close = NULL;
 
-    CHECK_ERROR(_findKey(c, KEY_PAY_RECEIVER))
-    CHECK_ERROR(_readBinFixed(c, v->payment.receiver, sizeof(v->payment.receiver)))
+    CHECK_ERROR(_findKey(c, KEYID_PAY_RECEIVER))
+    CHECK_ERROR(_getPointerBinFixed(c, &v->payment.receiver, ACCT_SIZE))
     DISPLAY_ITEM(IDX_PAYMENT_RECEIVER, 1, tx_num_items)
 
     v->payment.amount = 0;
-    if (_findKey(c, KEY_PAY_AMOUNT) == parser_ok) {
+    if (_findKey(c, KEYID_PAY_AMOUNT) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &v->payment.amount))
     }
     DISPLAY_ITEM(IDX_PAYMENT_AMOUNT, 1, tx_num_items)
 
-    if (_findKey(c, KEY_PAY_CLOSE) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->payment.close, sizeof(v->payment.close)))
+    if (_findKey(c, KEYID_PAY_CLOSE) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->payment.close, ACCT_SIZE))
         DISPLAY_ITEM(IDX_PAYMENT_CLOSE_TO, 1, tx_num_items)
     }
 
@@ -926,37 +1049,41 @@ static parser_error_t _readTxPayment(parser_context_t *c, parser_tx_t *v)
 
 static parser_error_t _readTxKeyreg(parser_context_t *c, parser_tx_t *v)
 {
-    tx_num_items = 0;
-    if (_findKey(c, KEY_VOTE_PK) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->keyreg.votepk, sizeof(v->keyreg.votepk)))
+    c->display.tx_num_items = 0;
+    v->keyreg.votepk = NULL;
+    v->keyreg.vrfpk = NULL;
+    v->keyreg.sprfkey = NULL;
+
+    if (_findKey(c, KEYID_VOTE_PK) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->keyreg.votepk, VOTE_PK_SIZE))
         DISPLAY_ITEM(IDX_KEYREG_VOTE_PK, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_VRF_PK) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->keyreg.vrfpk, sizeof(v->keyreg.vrfpk)))
+    if (_findKey(c, KEYID_VRF_PK) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->keyreg.vrfpk, VRF_PK_SIZE))
         DISPLAY_ITEM(IDX_KEYREG_VRF_PK, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_SPRF_PK) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->keyreg.sprfkey, sizeof(v->keyreg.sprfkey)))
+    if (_findKey(c, KEYID_SPRF_PK) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->keyreg.sprfkey, SPRF_PK_SIZE))
         DISPLAY_ITEM(IDX_KEYREG_SPRF_PK, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_VOTE_FIRST) == parser_ok) {
+    if (_findKey(c, KEYID_VOTE_FIRST) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &v->keyreg.voteFirst))
         DISPLAY_ITEM(IDX_KEYREG_VOTE_FIRST, 1, tx_num_items)
 
-        CHECK_ERROR(_findKey(c, KEY_VOTE_LAST))
+        CHECK_ERROR(_findKey(c, KEYID_VOTE_LAST))
         CHECK_ERROR(_readInteger(c, &v->keyreg.voteLast))
         DISPLAY_ITEM(IDX_KEYREG_VOTE_LAST, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_VOTE_KEY_DILUTION) == parser_ok) {
+    if (_findKey(c, KEYID_VOTE_KEY_DILUTION) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &v->keyreg.keyDilution))
         DISPLAY_ITEM(IDX_KEYREG_KEY_DILUTION, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_VOTE_NON_PART_FLAG) == parser_ok) {
+    if (_findKey(c, KEYID_VOTE_NON_PART_FLAG) == parser_ok) {
         CHECK_ERROR(_readBool(c, &v->keyreg.nonpartFlag))
     }
     DISPLAY_ITEM(IDX_KEYREG_PARTICIPATION, 1, tx_num_items)
@@ -966,30 +1093,34 @@ static parser_error_t _readTxKeyreg(parser_context_t *c, parser_tx_t *v)
 
 static parser_error_t _readTxAssetXfer(parser_context_t *c, parser_tx_t *v)
 {
-    tx_num_items = 0;
-    MEMZERO(v->asset_xfer.close, sizeof(v->asset_xfer.close));
+    c->display.tx_num_items = 0;
+    v->asset_xfer.sender = NULL;
+    v->asset_xfer.close = NULL;
 
-    CHECK_ERROR(_findKey(c, KEY_XFER_ID))
+    CHECK_ERROR(_findKey(c, KEYID_XFER_ID))
     CHECK_ERROR(_readInteger(c, &v->asset_xfer.id))
+    if (!algo_asa_get(v->asset_xfer.id, &v->asset_xfer.asa)) {
+        v->asset_xfer.asa.name = NULL;
+    }
     DISPLAY_ITEM(IDX_XFER_ASSET_ID, 1, tx_num_items)
 
     v->asset_xfer.amount = 0;
-    if (_findKey(c, KEY_XFER_AMOUNT) == parser_ok) {
+    if (_findKey(c, KEYID_XFER_AMOUNT) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &v->asset_xfer.amount))
     }
     DISPLAY_ITEM(IDX_XFER_AMOUNT, 1, tx_num_items)
 
-    CHECK_ERROR(_findKey(c, KEY_XFER_RECEIVER))
-    CHECK_ERROR(_readBinFixed(c, v->asset_xfer.receiver, sizeof(v->asset_xfer.receiver)))
+    CHECK_ERROR(_findKey(c, KEYID_XFER_RECEIVER))
+    CHECK_ERROR(_getPointerBinFixed(c, &v->asset_xfer.receiver, ACCT_SIZE))
     DISPLAY_ITEM(IDX_XFER_DESTINATION, 1, tx_num_items)
 
-    if (_findKey(c, KEY_XFER_SENDER) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->asset_xfer.sender, sizeof(v->asset_xfer.sender)))
+    if (_findKey(c, KEYID_XFER_SENDER) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->asset_xfer.sender, ACCT_SIZE))
         DISPLAY_ITEM(IDX_XFER_SOURCE, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_XFER_CLOSE) == parser_ok) {
-        CHECK_ERROR(_readBinFixed(c, v->asset_xfer.close, sizeof(v->asset_xfer.close)))
+    if (_findKey(c, KEYID_XFER_CLOSE) == parser_ok) {
+        CHECK_ERROR(_getPointerBinFixed(c, &v->asset_xfer.close, ACCT_SIZE))
         DISPLAY_ITEM(IDX_XFER_CLOSE, 1, tx_num_items)
     }
 
@@ -998,16 +1129,16 @@ static parser_error_t _readTxAssetXfer(parser_context_t *c, parser_tx_t *v)
 
 static parser_error_t _readTxAssetFreeze(parser_context_t *c, parser_tx_t *v)
 {
-    tx_num_items = 0;
-    CHECK_ERROR(_findKey(c, KEY_FREEZE_ID))
+    c->display.tx_num_items = 0;
+    CHECK_ERROR(_findKey(c, KEYID_FREEZE_ID))
     CHECK_ERROR(_readInteger(c, &v->asset_freeze.id))
     DISPLAY_ITEM(IDX_FREEZE_ASSET_ID, 1, tx_num_items)
 
-    CHECK_ERROR(_findKey(c, KEY_FREEZE_ACCOUNT))
-    CHECK_ERROR(_readBinFixed(c, v->asset_freeze.account, sizeof(v->asset_freeze.account)))
+    CHECK_ERROR(_findKey(c, KEYID_FREEZE_ACCOUNT))
+    CHECK_ERROR(_getPointerBinFixed(c, &v->asset_freeze.account, ACCT_SIZE))
     DISPLAY_ITEM(IDX_FREEZE_ACCOUNT, 1, tx_num_items)
 
-    if (_findKey(c, KEY_FREEZE_FLAG) == parser_ok) {
+    if (_findKey(c, KEYID_FREEZE_FLAG) == parser_ok) {
         if (_readBool(c, &v->asset_freeze.flag) != parser_ok) {
             v->asset_freeze.flag = 0x00;
         }
@@ -1019,13 +1150,13 @@ static parser_error_t _readTxAssetFreeze(parser_context_t *c, parser_tx_t *v)
 
 static parser_error_t _readTxAssetConfig(parser_context_t *c, parser_tx_t *v)
 {
-    tx_num_items = 0;
-    if (_findKey(c, KEY_CONFIG_ID) == parser_ok) {
+    c->display.tx_num_items = 0;
+    if (_findKey(c, KEYID_CONFIG_ID) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &v->asset_config.id))
         DISPLAY_ITEM(IDX_CONFIG_ASSET_ID, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_CONFIG_PARAMS) == parser_ok) {
+    if (_findKey(c, KEYID_CONFIG_PARAMS) == parser_ok) {
         CHECK_ERROR(_readAssetParams(c, &v->asset_config))
     }
 
@@ -1034,7 +1165,7 @@ static parser_error_t _readTxAssetConfig(parser_context_t *c, parser_tx_t *v)
 
 static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
 {
-    tx_num_items = 0;
+    c->display.tx_num_items = 0;
     txn_application *application = &v->application;
     application->num_boxes = 0;
     application->num_foreign_apps = 0;
@@ -1046,33 +1177,33 @@ static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
     application->aprog_len = 0;
     application->cprog_len = 0;
 
-    if (_findKey(c, KEY_APP_ID) == parser_ok) {
+    if (_findKey(c, KEYID_APP_ID) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &application->id))
     }
     DISPLAY_ITEM(IDX_APP_ID, 1, tx_num_items)
 
-    if (_findKey(c, KEY_APP_ONCOMPLETION) == parser_ok) {
+    if (_findKey(c, KEYID_APP_ONCOMPLETION) == parser_ok) {
         CHECK_ERROR(_readInteger(c, &application->oncompletion))
     }
     DISPLAY_ITEM(IDX_ON_COMPLETION, 1, tx_num_items)
 
-    if (_findKey(c, KEY_APP_BOXES) == parser_ok) {
+    if (_findKey(c, KEYID_APP_BOXES) == parser_ok) {
         CHECK_ERROR(_readBoxes(c, application->boxes, &application->num_boxes))
         DISPLAY_ITEM(IDX_BOXES, application->num_boxes, tx_num_items)
     }
 
-    if (_findKey(c, KEY_APP_FOREIGN_APPS) == parser_ok) {
+    if (_findKey(c, KEYID_APP_FOREIGN_APPS) == parser_ok) {
         CHECK_ERROR(_readArrayU64(c, application->foreign_apps, &application->num_foreign_apps, MAX_FOREIGN_APPS))
         DISPLAY_ITEM(IDX_FOREIGN_APP, application->num_foreign_apps, tx_num_items)
     }
 
-    if (_findKey(c, KEY_APP_FOREIGN_ASSETS) == parser_ok) {
+    if (_findKey(c, KEYID_APP_FOREIGN_ASSETS) == parser_ok) {
         CHECK_ERROR(_readArrayU64(c, application->foreign_assets, &application->num_foreign_assets, MAX_FOREIGN_ASSETS))
         DISPLAY_ITEM(IDX_FOREIGN_ASSET, application->num_foreign_assets, tx_num_items)
     }
 
-    if (_findKey(c, KEY_APP_ACCOUNTS) == parser_ok) {
-        CHECK_ERROR(_verifyAccounts(c, &application->num_accounts, MAX_ACCT))
+    if (_findKey(c, KEYID_APP_ACCOUNTS) == parser_ok) {
+        CHECK_ERROR(_verifyAccounts(c, application->accounts, &application->num_accounts, MAX_ACCT))
         DISPLAY_ITEM(IDX_ACCOUNTS, application->num_accounts, tx_num_items)
     }
 
@@ -1080,8 +1211,8 @@ static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
         return parser_unexpected_number_items;
     }
 
-    if (_findKey(c, KEY_APP_ARGS) == parser_ok) {
-        CHECK_ERROR(_verifyAppArgs(c, application->app_args_len, &application->num_app_args, MAX_ARG))
+    if (_findKey(c, KEYID_APP_ARGS) == parser_ok) {
+        CHECK_ERROR(_verifyAppArgs(c, application->app_args, application->app_args_len, &application->num_app_args, MAX_ARG))
         DISPLAY_ITEM(IDX_APP_ARGS, application->num_app_args, tx_num_items)
     }
 
@@ -1093,17 +1224,17 @@ static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
         }
     }
 
-    if (_findKey(c, KEY_APP_GLOBAL_SCHEMA) == parser_ok) {
+    if (_findKey(c, KEYID_APP_GLOBAL_SCHEMA) == parser_ok) {
         CHECK_ERROR(_readStateSchema(c, &application->global_schema))
         DISPLAY_ITEM(IDX_GLOBAL_SCHEMA, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_APP_LOCAL_SCHEMA) == parser_ok) {
+    if (_findKey(c, KEYID_APP_LOCAL_SCHEMA) == parser_ok) {
         CHECK_ERROR(_readStateSchema(c, &application->local_schema))
         DISPLAY_ITEM(IDX_LOCAL_SCHEMA, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_APP_EXTRA_PAGES) == parser_ok) {
+    if (_findKey(c, KEYID_APP_EXTRA_PAGES) == parser_ok) {
         CHECK_ERROR(_readUInt8(c, &application->extra_pages))
         if (application->extra_pages > 3){
             return parser_too_many_extra_pages;
@@ -1111,12 +1242,12 @@ static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
         DISPLAY_ITEM(IDX_EXTRA_PAGES, 1, tx_num_items)
     }
 
-    if (_findKey(c, KEY_APP_APROG_LEN) == parser_ok) {
+    if (_findKey(c, KEYID_APP_APROG_LEN) == parser_ok) {
         CHECK_ERROR(_getPointerBin(c, &application->aprog, &application->aprog_len))
         DISPLAY_ITEM(IDX_APPROVE, 1, tx_num_items)
     }
 
-   if (_findKey(c, KEY_APP_CPROG_LEN) == parser_ok) {
+   if (_findKey(c, KEYID_APP_CPROG_LEN) == parser_ok) {
        CHECK_ERROR(_getPointerBin(c, &application->cprog, &application->cprog_len))
        DISPLAY_ITEM(IDX_CLEAR, 1, tx_num_items)
    }
@@ -1129,15 +1260,17 @@ static parser_error_t _readTxApplication(parser_context_t *c, parser_tx_t *v)
     return parser_ok;
 }
 
-parser_error_t _read(parser_context_t *c, parser_tx_t *v)
+// Reads the transaction fields through a key index that is already built
+static parser_error_t _readIndexed(parser_context_t *c, parser_tx_t *v)
 {
-    uint16_t keyLen = 0;
-    CHECK_ERROR(initializeItemArray())
-
-    CHECK_ERROR(_readMapSize(c, &keyLen))
-    if(keyLen > UINT8_MAX) {
-        return parser_unexpected_number_items;
-    }
+    CHECK_ERROR(initializeItemArray(c))
+#if defined(PARSER_RENDER_CACHE)
+    c->addresses.count = 0;
+    c->addresses.next = 0;
+    c->digests.count = 0;
+    c->digests.next = 0;
+    c->rendered.state = RENDER_NONE;
+#endif
 
     // Read Tx type
     CHECK_ERROR(_readTxType(c, v))
@@ -1170,23 +1303,337 @@ parser_error_t _read(parser_context_t *c, parser_tx_t *v)
         break;
     }
 
-    num_items = common_num_items + tx_num_items + 1;
+    c->display.num_items = c->display.common_num_items + c->display.tx_num_items + 1;
+    return parser_ok;
+}
+
+parser_error_t _read(parser_context_t *c, parser_tx_t *v)
+{
+    // Walk the top-level map once; every field reader resolves through this index
+    CHECK_ERROR(_buildKeyIndex(c))
+    // Bytes after the map would be signed without being shown
+    if (c->offset != c->bufferLen) {
+        return parser_unexpected_characters;
+    }
+    return _readIndexed(c, v);
+}
+
+#define STREAM_MAP_HEADER       0
+#define STREAM_KEY_HEADER       1
+#define STREAM_VALUE_HEADER     2
+#define STREAM_FIELD            3
+#define STREAM_PAYLOAD          4
+#define STREAM_DONE             5
+
+parser_error_t _streamInit(parser_stream_t *s, parser_context_t *c)
+{
+    if (s == NULL || c == NULL) {
+        return parser_unexpected_value;
+    }
+
+    MEMZERO(s, sizeof(parser_stream_t));
+    s->ctx = c;
+    s->state = STREAM_MAP_HEADER;
+    s->error = parser_ok;
+
+    c->numKeys = 0;
+    c->keyMask = 0;
+    c->bytesScanned = 0;
+    return parser_ok;
+}
+
+static parser_error_t _streamMapSize(parser_stream_t *s, uint16_t mapItems)
+{
+    if (mapItems > MAX_TOP_LEVEL_KEYS) {
+        return parser_unexpected_number_items;
+    }
+    s->keysLeft = mapItems;
+    s->state = (mapItems == 0) ? STREAM_DONE : STREAM_KEY_HEADER;
+    return parser_ok;
+}
+
+static parser_error_t _streamKeyDone(parser_stream_t *s, const uint8_t *buffer)
+{
+    parser_context_t *c = s->ctx;
+    CHECK_ERROR(_indexKey(c, buffer, c->numKeys))
+
+    s->depth = 0;
+    s->remaining = 1;
+    s->state = STREAM_VALUE_HEADER;
     return parser_ok;
 }
 
-uint8_t _getNumItems()
+static parser_error_t _streamValueDone(parser_stream_t *s)
+{
+    parser_context_t *c = s->ctx;
+    parser_key_entry_t *entry = &c->keys[c->numKeys];
+    entry->valueLen = s->offset - KEY_VALUE_OFFSET(entry);
+    c->numKeys++;
+
+    s->keysLeft--;
+    s->state = (s->keysLeft == 0) ? STREAM_DONE : STREAM_KEY_HEADER;
+    return parser_ok;
+}
+
+// Same nesting rules as _verifyValue
+static parser_error_t _streamTokenDone(parser_stream_t *s, const uint8_t *buffer, uint32_t items)
+{
+    if (s->token == STREAM_KEY_HEADER) {
+        return _streamKeyDone(s, buffer);
+    }
+
+    if (items > 0) {
+        if (s->depth >= MSGPACK_MAX_DEPTH) {
+            return parser_msgpack_depth_exceeded;
+        }
+        s->pending[s->depth] = s->remaining;
+        s->depth++;
+        s->remaining = items;
+    }
+
+    while (s->remaining == 0) {
+        if (s->depth == 0) {
+            return _streamValueDone(s);
+        }
+        s->depth--;
+        s->remaining = s->pending[s->depth];
+    }
+    s->state = STREAM_VALUE_HEADER;
+    return parser_ok;
+}
+
+static parser_error_t _streamPayload(parser_stream_t *s, const uint8_t *buffer, uint32_t len)
+{
+    if (len == 0) {
+        return _streamTokenDone(s, buffer, 0);
+    }
+    s->skipLeft = len;
+    s->state = STREAM_PAYLOAD;
+    return parser_ok;
+}
+
+static parser_error_t _streamField(parser_stream_t *s, uint8_t len)
+{
+    s->fieldValue = 0;
+    s->fieldLeft = len;
+    s->state = STREAM_FIELD;
+    return parser_ok;
+}
+
+static parser_error_t _streamKeySize(parser_stream_t *s, const uint8_t *buffer, uint8_t keyLen)
+{
+    if (keyLen >= MAX_KEY_LEN) {
+        return parser_msgpack_str_too_big;
+    }
+    parser_key_entry_t *entry = &s->ctx->keys[s->ctx->numKeys];
+    entry->keyOffset = s->offset;
+    entry->keyLen = keyLen;
+    return _streamPayload(s, buffer, keyLen);
+}
+
+// Length field of the current token is complete
+static parser_error_t _streamFieldDone(parser_stream_t *s, const uint8_t *buffer)
+{
+    switch (s->token) {
+        case STREAM_MAP_HEADER:
+            return _streamMapSize(s, s->fieldValue);
+
+        case STREAM_KEY_HEADER:
+            return _streamKeySize(s, buffer, (uint8_t) s->fieldValue);
+
+        default:
+            break;
+    }
+
+    switch (MSGPACK_CLASS(s->header)) {
+        case MSGPACK_CLASS_STR:
+        case MSGPACK_CLASS_BIN:
+            return _streamPayload(s, buffer, s->fieldValue);
+
+        case MSGPACK_CLASS_MAP:
+            return _streamTokenDone(s, buffer, 2 * (uint32_t) s->fieldValue);
+
+        case MSGPACK_CLASS_ARRAY:
+            if (s->fieldValue > UINT8_MAX) {
+                return parser_unexpected_number_items;
+            }
+            return _streamTokenDone(s, buffer, s->fieldValue);
+
+        default:
+            return parser_unexpected_value;
+    }
+}
+
+static parser_error_t _streamHeader(parser_stream_t *s, const uint8_t *buffer, uint8_t byte)
+{
+    const uint8_t fieldSize = MSGPACK_FIELD_SIZE(byte);
+    s->token = s->state;
+    s->header = byte;
+
+    switch (s->state) {
+        case STREAM_MAP_HEADER:
+            // Same as _readMapSize
+            if (MSGPACK_CLASS(byte) != MSGPACK_CLASS_MAP) {
+                return parser_msgpack_unexpected_type;
+            }
+            if (fieldSize == MSGPACK_FIELD_INLINE) {
+                return _streamMapSize(s, byte - FIXMAP_0);
+            }
+            if (fieldSize == 2) {
+                return _streamField(s, fieldSize);
+            }
+            return parser_msgpack_map_type_not_supported;
+
+        case STREAM_KEY_HEADER:
+            // Same as _readKey
+            if (MSGPACK_CLASS(byte) != MSGPACK_CLASS_STR) {
+                return parser_msgpack_str_type_expected;
+            }
+            if (fieldSize == MSGPACK_FIELD_INLINE) {
+                return _streamKeySize(s, buffer, byte - FIXSTR_0);
+            }
+            if (fieldSize == 1) {
+                return _streamField(s, fieldSize);
+            }
+            return parser_msgpack_str_type_not_supported;
+
+        default:
+            break;
+    }
+
+    // Same as _verifyValue
+    s->remaining--;
+    switch (MSGPACK_CLASS(byte)) {
+        case MSGPACK_CLASS_UINT:
+        case MSGPACK_CLASS_BOOL:
+            return _streamPayload(s, buffer, (fieldSize == MSGPACK_FIELD_INLINE) ? 0 : fieldSize);
+
+        case MSGPACK_CLASS_STR:
+            if (fieldSize == MSGPACK_FIELD_INLINE) {
+                return _streamPayload(s, buffer, byte - FIXSTR_0);
+            }
+            if (fieldSize == 1) {
+                return _streamField(s, fieldSize);
+            }
+            return parser_unexpected_value;
+
+        case MSGPACK_CLASS_BIN:
+            if (fieldSize == 1 || fieldSize == 2) {
+                return _streamField(s, fieldSize);
+            }
+            return parser_unexpected_value;
+
+        case MSGPACK_CLASS_MAP:
+            if (fieldSize == MSGPACK_FIELD_INLINE) {
+                return _streamTokenDone(s, buffer, 2 * (uint32_t) (byte - FIXMAP_0));
+            }
+            if (fieldSize == 2) {
+                return _streamField(s, fieldSize);
+            }
+            return parser_unexpected_value;
+
+        case MSGPACK_CLASS_ARRAY:
+            if (fieldSize == MSGPACK_FIELD_INLINE) {
+                return _streamTokenDone(s, buffer, byte - FIXARR_0);
+            }
+            if (fieldSize == 2) {
+                return _streamField(s, fieldSize);
+            }
+            return parser_unexpected_value;
+
+        default:
+            return parser_unexpected_value;
+    }
+}
+
+// Scans buffer from where the previous call stopped. buffer holds everything received so far
+// and may move between calls; key bytes are read back from it once complete.
+parser_error_t _streamAppend(parser_stream_t *s, const uint8_t *buffer, uint16_t bufferLen)
+{
+    if (s == NULL || s->ctx == NULL || buffer == NULL || bufferLen < s->offset) {
+        return parser_unexpected_value;
+    }
+    if (s->error != parser_ok) {
+        return s->error;
+    }
+
+    const uint16_t start = s->offset;
+    parser_error_t err = parser_ok;
+
+    // Bytes after the top-level map are ignored, as _read does
+    while (s->offset < bufferLen && s->state != STREAM_DONE && err == parser_ok) {
+        if (s->state == STREAM_PAYLOAD) {
+            const uint16_t avail = bufferLen - s->offset;
+            const uint16_t step = (s->skipLeft < avail) ? (uint16_t) s->skipLeft : avail;
+            s->offset += step;
+            s->skipLeft -= step;
+            if (s->skipLeft == 0) {
+                err = _streamTokenDone(s, buffer, 0);
+            }
+            continue;
+        }
+
+        const uint8_t byte = buffer[s->offset];
+        s->offset++;
+
+        if (s->state == STREAM_FIELD) {
+            s->fieldValue = (uint16_t) ((s->fieldValue << 8) | byte);
+            s->fieldLeft--;
+            if (s->fieldLeft == 0) {
+                err = _streamFieldDone(s, buffer);
+            }
+        } else {
+            err = _streamHeader(s, buffer, byte);
+        }
+    }
+
+    s->ctx->bytesScanned += (uint32_t) (s->offset - start);
+    s->error = err;
+    return err;
+}
+
+parser_error_t _readStreamed(parser_context_t *c, const parser_stream_t *s,
+                             const uint8_t *buffer, uint16_t bufferLen, parser_tx_t *v)
+{
+    if (c == NULL || s == NULL || s->ctx != c) {
+        return parser_unexpected_value;
+    }
+    if (s->error != parser_ok) {
+        return s->error;
+    }
+    if (buffer == NULL || bufferLen == 0) {
+        return parser_init_context_empty;
+    }
+    if (s->state != STREAM_DONE || s->offset > bufferLen) {
+        return parser_unexpected_buffer_end;
+    }
+    // Bytes after the map would be signed without being shown
+    if (s->offset != bufferLen) {
+        return parser_unexpected_characters;
+    }
+
+    c->buffer = buffer;
+    c->bufferLen = bufferLen;
+    c->offset = s->offset;
+    MEMZERO(&c->display, sizeof(c->display));
+    c->parser_tx_obj = v;
+
+    return _readIndexed(c, v);
+}
+
+uint8_t _getNumItems(const parser_context_t *c)
 {
-    return num_items;
+    return c->display.num_items;
 }
 
-uint8_t _getCommonNumItems()
+uint8_t _getCommonNumItems(const parser_context_t *c)
 {
-    return common_num_items;
+    return c->display.common_num_items;
 }
 
-uint8_t _getTxNumItems()
+uint8_t _getTxNumItems(const parser_context_t *c)
 {
-    return tx_num_items;
+    return c->display.tx_num_items;
 }
 
 const char *parser_getErrorDescription(parser_error_t err) {
@@ -1272,6 +1719,10 @@ const char *parser_getErrorDescription(parser_error_t err) {
             return "msgpack_array_too_big";
         case parser_msgpack_array_type_expected:
             return "Msgpack array type expected";
+        case parser_msgpack_depth_exceeded:
+            return "Msgpack nesting too deep";
+        case parser_group_id_mismatch:
+            return "Group ID mismatch";
         default:
             return "Unrecognized error code";
     }
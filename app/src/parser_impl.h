@@ -30,7 +30,8 @@ extern "C" {
 
 #define CTX_CHECK_AND_ADVANCE(CTX, SIZE) \
     CTX_CHECK_AVAIL((CTX), (SIZE))   \
-    (CTX)->offset += (SIZE);
+    (CTX)->offset += (SIZE);         \
+    (CTX)->bytesScanned += (SIZE);
 
 #define DEF_READARRAY(SIZE) \
     v->_ptr = c->buffer + c->offset; \
@@ -42,7 +43,7 @@ extern "C" {
 {                                                                                           \
     if (value == NULL)  return parser_no_data;                                              \
     *value = 0u;                                                                            \
-    for(uint8_t i=0u; i < (BITS##u>>3u); i++, ctx->offset++) {                              \
+    for(uint8_t i=0u; i < (BITS##u>>3u); i++, ctx->offset++, ctx->bytesScanned++) {        \
         if (ctx->offset >= ctx->bufferLen) return parser_unexpected_buffer_end;             \
         *value = (*value << 8) | (uint ## BITS ##_t) *(ctx->buffer + ctx->offset);          \
     }                                                                                       \
@@ -55,11 +56,18 @@ parser_error_t parser_init(parser_context_t *ctx,
                            const uint8_t *buffer,
                            uint16_t bufferSize);
 
-uint8_t _getNumItems();
-uint8_t _getCommonNumItems();
-uint8_t _getTxNumItems();
+uint8_t _getNumItems(const parser_context_t *c);
+uint8_t _getCommonNumItems(const parser_context_t *c);
+uint8_t _getTxNumItems(const parser_context_t *c);
 
 parser_error_t _read(parser_context_t *c, parser_tx_t *v);
+// Indexes the top-level map in ctx->keys without reading any field
+parser_error_t _buildKeyIndex(parser_context_t *c);
+
+parser_error_t _streamInit(parser_stream_t *s, parser_context_t *c);
+parser_error_t _streamAppend(parser_stream_t *s, const uint8_t *buffer, uint16_t bufferLen);
+parser_error_t _readStreamed(parser_context_t *c, const parser_stream_t *s,
+                             const uint8_t *buffer, uint16_t bufferLen, parser_tx_t *v);
 
 parser_error_t _readMapSize(parser_context_t *c, uint16_t *mapItems);
 parser_error_t _readArraySize(parser_context_t *c, uint8_t *mapItems);
@@ -68,9 +76,6 @@ parser_error_t _readInteger(parser_context_t *c, uint64_t* value);
 parser_error_t _readBool(parser_context_t *c, uint8_t *value);
 parser_error_t _readBinFixed(parser_context_t *c, uint8_t *buff, uint16_t bufferLen);
 
-parser_error_t _getAccount(parser_context_t *c, uint8_t* account, uint8_t account_idx, uint8_t num_accounts);
-parser_error_t _getAppArg(parser_context_t *c, uint8_t **args, uint16_t* args_len, uint8_t args_idx, uint16_t max_args_len, uint8_t max_array_len);
-
 DEF_READFIX_UNSIGNED(8);
 DEF_READFIX_UNSIGNED(16);
 DEF_READFIX_UNSIGNED(32);
@@ -0,0 +1,180 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+// Generated by app/scripts/gen_parser_keys.py from parser_txdef.h - DO NOT EDIT
+
+#pragma once
+
+#include <stdint.h>
+
+#define PARSER_KEY_MAX_PACKED_LEN 7
+#define PARSER_KEY_HASH_BITS      8
+#define PARSER_KEY_HASH_MULT      0x9CEAFFE1U
+#define PARSER_KEY_HASH(packed)   ((uint32_t)(((uint32_t)(packed) ^ (uint32_t)((packed) >> 32)) * PARSER_KEY_HASH_MULT) >> (32 - PARSER_KEY_HASH_BITS))
+
+typedef enum {
+    KEYID_COMMON_TYPE            =  0,  // "type"
+    KEYID_TX_PAY                 =  1,  // "pay"
+    KEYID_TX_KEYREG              =  2,  // "keyreg"
+    KEYID_TX_ASSET_XFER          =  3,  // "axfer"
+    KEYID_TX_ASSET_FREEZE        =  4,  // "afrz"
+    KEYID_TX_ASSET_CONFIG        =  5,  // "acfg"
+    KEYID_TX_APPLICATION         =  6,  // "appl"
+    KEYID_COMMON_SENDER          =  7,  // "snd"
+    KEYID_COMMON_LEASE           =  8,  // "lx"
+    KEYID_COMMON_REKEY           =  9,  // "rekey"
+    KEYID_COMMON_FEE             = 10,  // "fee"
+    KEYID_COMMON_FIRST_VALID     = 11,  // "fv"
+    KEYID_COMMON_LAST_VALID      = 12,  // "lv"
+    KEYID_COMMON_GEN_ID          = 13,  // "gen"
+    KEYID_COMMON_GEN_HASH        = 14,  // "gh"
+    KEYID_COMMON_GROUP_ID        = 15,  // "grp"
+    KEYID_COMMON_NOTE            = 16,  // "note"
+    KEYID_PAY_AMOUNT             = 17,  // "amt"
+    KEYID_PAY_RECEIVER           = 18,  // "rcv"
+    KEYID_PAY_CLOSE              = 19,  // "close"
+    KEYID_VRF_PK                 = 20,  // "selkey"
+    KEYID_SPRF_PK                = 21,  // "sprfkey"
+    KEYID_VOTE_PK                = 22,  // "votekey"
+    KEYID_VOTE_FIRST             = 23,  // "votefst"
+    KEYID_VOTE_LAST              = 24,  // "votelst"
+    KEYID_VOTE_KEY_DILUTION      = 25,  // "votekd"
+    KEYID_VOTE_NON_PART_FLAG     = 26,  // "nonpart"
+    KEYID_XFER_AMOUNT            = 27,  // "aamt"
+    KEYID_XFER_CLOSE             = 28,  // "aclose"
+    KEYID_XFER_RECEIVER          = 29,  // "arcv"
+    KEYID_XFER_SENDER            = 30,  // "asnd"
+    KEYID_XFER_ID                = 31,  // "xaid"
+    KEYID_FREEZE_ID              = 32,  // "faid"
+    KEYID_FREEZE_ACCOUNT         = 33,  // "fadd"
+    KEYID_CONFIG_ID              = 34,  // "caid"
+    KEYID_CONFIG_PARAMS          = 35,  // "apar"
+    KEYID_APP_ID                 = 36,  // "apid"
+    KEYID_APP_ARGS               = 37,  // "apaa"
+    KEYID_APP_EXTRA_PAGES        = 38,  // "apep"
+    KEYID_APP_APROG_LEN          = 39,  // "apap"
+    KEYID_APP_CPROG_LEN          = 40,  // "apsu"
+    KEYID_APP_ONCOMPLETION       = 41,  // "apan"
+    KEYID_APP_ACCOUNTS           = 42,  // "apat"
+    KEYID_APP_LOCAL_SCHEMA       = 43,  // "apls"
+    KEYID_APP_GLOBAL_SCHEMA      = 44,  // "apgs"
+    KEYID_APP_FOREIGN_APPS       = 45,  // "apfa"
+    KEYID_APP_FOREIGN_ASSETS     = 46,  // "apas"
+    KEYID_APP_BOXES              = 47,  // "apbx"
+    KEYID_APP_BOX_INDEX          = 48,  // "i"
+    KEYID_APP_BOX_NAME           = 49,  // "n"
+    KEYID_APARAMS_TOTAL          = 50,  // "t"
+    KEYID_APARAMS_DECIMALS       = 51,  // "dc"
+    KEYID_APARAMS_DEF_FROZEN     = 52,  // "df"
+    KEYID_APARAMS_UNIT_NAME      = 53,  // "un"
+    KEYID_APARAMS_ASSET_NAME     = 54,  // "an"
+    KEYID_APARAMS_URL            = 55,  // "au"
+    KEYID_APARAMS_METADATA_HASH  = 56,  // "am"
+    KEYID_APARAMS_MANAGER        = 57,  // "m"
+    KEYID_APARAMS_RESERVE        = 58,  // "r"
+    KEYID_APARAMS_FREEZE         = 59,  // "f"
+    KEYID_APARAMS_CLAWBACK       = 60,  // "c"
+    KEYID_SCHEMA_NUI             = 61,  // "nui"
+    KEYID_SCHEMA_NBS             = 62,  // "nbs"
+    KEYID_COUNT                  = 63,
+    KEYID_UNKNOWN                = 0xFF,
+} parser_key_id_e;
+
+#define KEYID_FREEZE_FLAG           KEYID_TX_ASSET_FREEZE
+
+static const uint64_t parserKeyPacked[KEYID_COUNT] = {
+    0x0400000065707974ULL,  // COMMON_TYPE
+    0x0300000000796170ULL,  // TX_PAY
+    0x060067657279656BULL,  // TX_KEYREG
+    0x0500007265667861ULL,  // TX_ASSET_XFER
+    0x040000007A726661ULL,  // TX_ASSET_FREEZE
+    0x0400000067666361ULL,  // TX_ASSET_CONFIG
+    0x040000006C707061ULL,  // TX_APPLICATION
+    0x0300000000646E73ULL,  // COMMON_SENDER
+    0x020000000000786CULL,  // COMMON_LEASE
+    0x05000079656B6572ULL,  // COMMON_REKEY
+    0x0300000000656566ULL,  // COMMON_FEE
+    0x0200000000007666ULL,  // COMMON_FIRST_VALID
+    0x020000000000766CULL,  // COMMON_LAST_VALID
+    0x03000000006E6567ULL,  // COMMON_GEN_ID
+    0x0200000000006867ULL,  // COMMON_GEN_HASH
+    0x0300000000707267ULL,  // COMMON_GROUP_ID
+    0x0400000065746F6EULL,  // COMMON_NOTE
+    0x0300000000746D61ULL,  // PAY_AMOUNT
+    0x0300000000766372ULL,  // PAY_RECEIVER
+    0x05000065736F6C63ULL,  // PAY_CLOSE
+    0x060079656B6C6573ULL,  // VRF_PK
+    0x0779656B66727073ULL,  // SPRF_PK
+    0x0779656B65746F76ULL,  // VOTE_PK
+    0x0774736665746F76ULL,  // VOTE_FIRST
+    0x0774736C65746F76ULL,  // VOTE_LAST
+    0x0600646B65746F76ULL,  // VOTE_KEY_DILUTION
+    0x07747261706E6F6EULL,  // VOTE_NON_PART_FLAG
+    0x04000000746D6161ULL,  // XFER_AMOUNT
+    0x060065736F6C6361ULL,  // XFER_CLOSE
+    0x0400000076637261ULL,  // XFER_RECEIVER
+    0x04000000646E7361ULL,  // XFER_SENDER
+    0x0400000064696178ULL,  // XFER_ID
+    0x0400000064696166ULL,  // FREEZE_ID
+    0x0400000064646166ULL,  // FREEZE_ACCOUNT
+    0x0400000064696163ULL,  // CONFIG_ID
+    0x0400000072617061ULL,  // CONFIG_PARAMS
+    0x0400000064697061ULL,  // APP_ID
+    0x0400000061617061ULL,  // APP_ARGS
+    0x0400000070657061ULL,  // APP_EXTRA_PAGES
+    0x0400000070617061ULL,  // APP_APROG_LEN
+    0x0400000075737061ULL,  // APP_CPROG_LEN
+    0x040000006E617061ULL,  // APP_ONCOMPLETION
+    0x0400000074617061ULL,  // APP_ACCOUNTS
+    0x04000000736C7061ULL,  // APP_LOCAL_SCHEMA
+    0x0400000073677061ULL,  // APP_GLOBAL_SCHEMA
+    0x0400000061667061ULL,  // APP_FOREIGN_APPS
+    0x0400000073617061ULL,  // APP_FOREIGN_ASSETS
+    0x0400000078627061ULL,  // APP_BOXES
+    0x0100000000000069ULL,  // APP_BOX_INDEX
+    0x010000000000006EULL,  // APP_BOX_NAME
+    0x0100000000000074ULL,  // APARAMS_TOTAL
+    0x0200000000006364ULL,  // APARAMS_DECIMALS
+    0x0200000000006664ULL,  // APARAMS_DEF_FROZEN
+    0x0200000000006E75ULL,  // APARAMS_UNIT_NAME
+    0x0200000000006E61ULL,  // APARAMS_ASSET_NAME
+    0x0200000000007561ULL,  // APARAMS_URL
+    0x0200000000006D61ULL,  // APARAMS_METADATA_HASH
+    0x010000000000006DULL,  // APARAMS_MANAGER
+    0x0100000000000072ULL,  // APARAMS_RESERVE
+    0x0100000000000066ULL,  // APARAMS_FREEZE
+    0x0100000000000063ULL,  // APARAMS_CLAWBACK
+    0x030000000069756EULL,  // SCHEMA_NUI
+    0x030000000073626EULL,  // SCHEMA_NBS
+};
+
+static const uint8_t parserKeyHashTable[1 << PARSER_KEY_HASH_BITS] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x22, 0x07, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x16, 0xFF, 0xFF, 0x11, 0xFF, 0xFF, 0xFF, 0xFF, 0x08, 0xFF, 0xFF,
+    0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x26, 0x27, 0xFF, 0xFF,
+    0x36, 0xFF, 0xFF, 0xFF, 0xFF, 0x2F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x15, 0x30, 0xFF, 0xFF,
+    0xFF, 0x1D, 0xFF, 0xFF, 0xFF, 0x38, 0x01, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x05, 0x31, 0xFF, 0xFF,
+    0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x12, 0xFF, 0x1E, 0xFF, 0xFF, 0xFF, 0x0E, 0x0F, 0xFF, 0xFF,
+    0x00, 0xFF, 0xFF, 0x29, 0x1A, 0xFF, 0x3B, 0xFF, 0xFF, 0xFF, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0x0D,
+    0xFF, 0xFF, 0xFF, 0x35, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x13, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0xFF, 0xFF, 0xFF, 0x28, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3C,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x24, 0x0B, 0xFF, 0xFF, 0xFF, 0x37, 0xFF, 0x06,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x17, 0xFF, 0xFF, 0xFF, 0xFF, 0x2A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x34,
+    0xFF, 0x39, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x3A, 0xFF, 0xFF, 0xFF, 0x18, 0x1C, 0x04, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x2B, 0x2C,
+    0x2E, 0xFF, 0xFF, 0x0A, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x1B, 0x20, 0x21, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0xFF, 0x33, 0x23,
+    0x14, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0x32, 0xFF, 0x2D, 0x25, 0xFF,
+};
@@ -21,6 +21,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include "algo_asa.h"
 
 typedef enum tx_type_e {
   TX_UNKNOWN,
@@ -109,6 +110,17 @@ typedef enum tx_type_e {
 
 #define BOX_NAME_MAX_LENGTH       64
 
+#define ASA_UNIT_NAME_MAX_LENGTH  8
+#define ASA_NAME_MAX_LENGTH       32
+#define ASA_URL_MAX_LENGTH        96
+
+// Fixed size binary fields
+#define HASH_SIZE                 32
+#define LEASE_SIZE                32
+#define VOTE_PK_SIZE              32
+#define VRF_PK_SIZE               32
+#define SPRF_PK_SIZE              64
+
 
 typedef enum oncompletion {
   NOOPOC       = 0,
@@ -123,14 +135,18 @@ typedef struct {
   uint64_t total;
   uint64_t decimals;
   uint8_t default_frozen;
-  char unitname[9];
-  char assetname[33];
-  char url[97];
-  uint8_t metadata_hash[32];
-  uint8_t manager[32];
-  uint8_t reserve[32];
-  uint8_t freeze[32];
-  uint8_t clawback[32];
+  // Views into the parsed buffer, only valid while it is alive
+  const uint8_t *unitname;
+  uint8_t unitname_len;
+  const uint8_t *assetname;
+  uint8_t assetname_len;
+  const uint8_t *url;
+  uint8_t url_len;
+  const uint8_t *metadata_hash;
+  const uint8_t *manager;
+  const uint8_t *reserve;
+  const uint8_t *freeze;
+  const uint8_t *clawback;
 } asset_params;
 
 typedef struct {
@@ -151,16 +167,17 @@ typedef struct {
 #define MAX_CLEAR_LEN 32
 
 // TXs structs
+// Address and key fields below point into the parsed buffer (same as aprog/cprog and box names)
 typedef struct {
-  uint8_t receiver[32];
+  const uint8_t *receiver;
   uint64_t amount;
-  uint8_t close[32];
+  const uint8_t *close;
 } txn_payment;
 
 typedef struct {
-  uint8_t votepk[32];
-  uint8_t vrfpk[32];
-  uint8_t sprfkey[64];
+  const uint8_t *votepk;
+  const uint8_t *vrfpk;
+  const uint8_t *sprfkey;
   uint64_t voteFirst;
   uint64_t voteLast;
   uint64_t keyDilution;
@@ -170,9 +187,10 @@ typedef struct {
 typedef struct {
   uint64_t id;
   uint64_t amount;
-  uint8_t sender[32];
-  uint8_t receiver[32];
-  uint8_t close[32];
+  algo_asset_t asa;               // Verified asset with this id, name is NULL if unknown
+  const uint8_t *sender;
+  const uint8_t *receiver;
+  const uint8_t *close;
 } txn_asset_xfer;
 
 typedef struct {
@@ -183,7 +201,7 @@ typedef struct {
 
 typedef struct {
   uint64_t id;
-  uint8_t account[32];
+  const uint8_t *account;
   uint8_t flag;
 } txn_asset_freeze;
 
@@ -208,6 +226,9 @@ typedef struct {
 
   const uint8_t* aprog;
   const uint8_t* cprog;
+  // Recorded while the arrays are verified, so items are shown without rescanning
+  const uint8_t *accounts[MAX_ACCT];
+  const uint8_t *app_args[MAX_ARG];
   uint16_t app_args_len[MAX_ARG];
 
   uint64_t foreign_apps[MAX_FOREIGN_APPS];
@@ -230,15 +251,15 @@ typedef struct{
   tx_type_e type;
   uint32_t accountId;
 
-  uint8_t sender[32];
-  uint8_t rekey[32];
+  const uint8_t *sender;
+  const uint8_t *rekey;
   uint64_t fee;
   uint64_t firstValid;
   uint64_t lastValid;
   char genesisID[32];
-  uint8_t genesisHash[32];
-  uint8_t groupID[32];
-  uint8_t lease[32];
+  const uint8_t *genesisHash;
+  const uint8_t *groupID;
+  const uint8_t *lease;
 
   uint16_t note_len;
 } parser_tx_t;
@@ -0,0 +1,88 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <string>
+#include <vector>
+#include "address_batch.h"
+#include "parser_encoding.h"
+#include "sha512_xn.h"
+
+namespace {
+
+std::vector<std::array<uint8_t, PK_LEN_25519>> publicKeys(size_t count) {
+    std::vector<std::array<uint8_t, PK_LEN_25519>> keys(count);
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < PK_LEN_25519; j++) {
+            keys[i][j] = static_cast<uint8_t>(i * 131 + j * 7);
+        }
+    }
+    return keys;
+}
+
+std::vector<std::string> addresses(size_t count) {
+    std::vector<std::string> out;
+    for (const auto &key : publicKeys(count)) {
+        uint8_t buffer[ADDRESS_BUFFER_LEN];
+        const uint32_t len = encodePubKey(buffer, sizeof(buffer), key.data());
+        out.emplace_back(reinterpret_cast<const char *>(buffer), len);
+    }
+    return out;
+}
+
+void BM_DecodeAddress(benchmark::State &state) {
+    const auto encoded = addresses(static_cast<size_t>(state.range(0)));
+    uint8_t key[PK_LEN_25519];
+
+    for (auto _ : state) {
+        for (const auto &address : encoded) {
+            benchmark::DoNotOptimize(decodeAddress(address.data(), address.size(), key));
+            benchmark::DoNotOptimize(key);
+        }
+    }
+    state.counters["addresses_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * encoded.size()), benchmark::Counter::kIsRate);
+}
+
+void BM_DecodeAddressBatch(benchmark::State &state) {
+    const auto encoded = addresses(static_cast<size_t>(state.range(0)));
+    std::vector<const char *> in;
+    for (const auto &address : encoded) {
+        in.push_back(address.c_str());
+    }
+    std::vector<std::array<uint8_t, PK_LEN_25519>> keys(encoded.size());
+    std::vector<parser_error_t> errors(encoded.size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decodeAddressBatch(in.data(), in.size(),
+                                                    reinterpret_cast<uint8_t (*)[PK_LEN_25519]>(keys.data()),
+                                                    errors.data()));
+        benchmark::DoNotOptimize(keys.data());
+    }
+    state.counters["addresses_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * encoded.size()), benchmark::Counter::kIsRate);
+    state.SetLabel(SHA512_256_xN_kernel());
+}
+
+}  // namespace
+
+BENCHMARK(BM_DecodeAddress)->Arg(1)->Arg(1024);
+BENCHMARK(BM_DecodeAddressBatch)->Arg(1)->Arg(1024);
+
+BENCHMARK_MAIN();
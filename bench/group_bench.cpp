@@ -0,0 +1,116 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <hexutils.h>
+#include "group_batch.h"
+#include "parser_group_build.h"
+#include "sha512_xn.h"
+
+namespace {
+
+// Groups built per benchmark iteration
+constexpr size_t kGroupsPerIteration = 1000000;
+// Groups kept in memory, the iteration cycles over them
+constexpr size_t kPoolGroups = 4096;
+
+// Payment without grp, the receiver is varied per member
+const char *kPayment =
+    "89a3616d74ce000f4240a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4"
+    "b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3726376c4204142434445464748494a4b"
+    "4c4d4e4f505152535455565758595a5b5c5d5e5f60a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718"
+    "191a1b1c1d1e1f20a474797065a3706179";
+// Offset of the receiver address in kPayment
+constexpr size_t kReceiverOffset = 89;
+
+struct GroupPool {
+    std::vector<uint8_t> storage;
+    std::vector<group_txn_t> txns;
+    std::vector<group_batch_t> groups;
+
+    explicit GroupPool(size_t groupSize) {
+        std::vector<uint8_t> payment(strlen(kPayment) / 2);
+        parseHexString(payment.data(), payment.size(), kPayment);
+        const size_t stride = payment.size() + GROUP_BUILD_MAX_GROWTH;
+
+        const size_t numTxns = kPoolGroups * groupSize;
+        storage.resize(numTxns * stride);
+        txns.resize(numTxns);
+        for (size_t i = 0; i < numTxns; i++) {
+            uint8_t *data = storage.data() + i * stride;
+            memcpy(data, payment.data(), payment.size());
+            memcpy(data + kReceiverOffset, &i, sizeof(i));
+            txns[i] = {data, static_cast<uint16_t>(payment.size()), static_cast<uint16_t>(stride)};
+        }
+        groups.resize(kPoolGroups);
+        for (size_t g = 0; g < kPoolGroups; g++) {
+            groups[g] = {};
+            groups[g].txns = &txns[g * groupSize];
+            groups[g].count = static_cast<uint8_t>(groupSize);
+        }
+    }
+};
+
+void setCounters(benchmark::State &state) {
+    state.counters["groups_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * kGroupsPerIteration), benchmark::Counter::kIsRate);
+}
+
+// After the first pass members already carry grp and it is rewritten in place,
+// hashing is the same as for members that have none
+void BM_GroupBuild(benchmark::State &state) {
+    GroupPool pool(static_cast<size_t>(state.range(0)));
+    uint8_t groupId[GROUP_ID_LEN];
+
+    for (auto _ : state) {
+        for (size_t done = 0; done < kGroupsPerIteration; done++) {
+            group_batch_t &g = pool.groups[done % kPoolGroups];
+            benchmark::DoNotOptimize(group_build(g.txns, g.count, nullptr, groupId));
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state);
+}
+
+void BM_GroupBuildBatch(benchmark::State &state) {
+    GroupPool pool(static_cast<size_t>(state.range(0)));
+    const uint32_t threads = static_cast<uint32_t>(state.range(1));
+
+    for (auto _ : state) {
+        for (size_t done = 0; done < kGroupsPerIteration; done += kPoolGroups) {
+            const size_t count = std::min(kPoolGroups, kGroupsPerIteration - done);
+            benchmark::DoNotOptimize(group_build_batch(pool.groups.data(), count, threads));
+        }
+        benchmark::ClobberMemory();
+    }
+    setCounters(state);
+    state.SetLabel(SHA512_256_xN_kernel());
+}
+
+}  // namespace
+
+// Group size
+BENCHMARK(BM_GroupBuild)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+// Group size, worker threads (0: one per hardware thread)
+BENCHMARK(BM_GroupBuildBatch)->Args({4, 1})->Args({16, 1})->Args({4, 0})->Args({16, 0})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
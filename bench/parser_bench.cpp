@@ -0,0 +1,632 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <json/json.h>
+#include <hexutils.h>
+#include <parser_txdef.h>
+#include "algo_asa.h"
+#include "asset_store.h"
+#include "parser.h"
+#include "parser_encoding.h"
+#include "utils/common.h"
+
+namespace {
+
+typedef struct {
+    std::string name;
+    std::vector<uint8_t> blob;
+} bench_vector_t;
+
+// Same transactions used by the zemu tests (tests_zemu/tests/common.ts)
+const char *kTxVectors[][2] = {
+    {"txAssetFreeze",
+     "88a466616464c4204b2a4ad9d4d900ea16f9dcee534b9c0189daa1acbccace73d794bf168b8a73e3a466616964cd04d2"
+     "a3666565cd08caa26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e509"
+     "3a22a26c76cd07d0a3736e64c4201ea2c56986a264df3c01f1da50e389bcd0695dd9b7cd79086fc2d5359b8fd06ba474"
+     "797065a46166727a"},
+    {"txAssetXfer",
+     "89a461616d740aa461726376c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a366"
+     "6565cd0910a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22"
+     "a26c76cd07d0a3736e64c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a4747970"
+     "65a56178666572a478616964cd04d2"},
+    {"txAssetConfig",
+     "88a46170617284a163c420546b182d119ce30f63b237b89cd9a468e82bb4ffd7357b55db971ca98020af40a166c42043"
+     "b7c58a06dac0e907e8bf6d7432757c6e5d3f6a74e1e5666586c9a21ab6944ea16dc420c844ffa90d4bf89da6a44a1c8c"
+     "be6d2d5a7e65a032a480b11b713f22d61bad3aa172c42022775c2ba5ab7997f2f396a32b37ca956e8a201fb5b6481db9"
+     "083f4a3a65cf51a463616964cd04d2a3666565cd0d20a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081"
+     "cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3736e64c4209fc49dcc6e5a09152e2c1dae9c4d0591cbb9f5"
+     "e7b8b12c8a2be896c7bfa1ed67a474797065a461636667"},
+    {"txKeyreg",
+     "8ca3666565cd0e42a26676cd03e7a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5"
+     "093a22a26c76cd0d80a673656c6b6579c420771ef5ecbdee38821bfe3afd388ca5b35979122d343458116b7f34c3b4e7"
+     "3ebea3736e64c420bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfa7737072666b6579"
+     "c44099847419510e6cc4d235db0a33a470632c0760fa950ea837138245cf164eade1fd354f01fad2b351a9f263c010d7"
+     "8e21113812317edf5d6c2305d1f3e805a4f7a474797065a66b6579726567a7766f746566737401a6766f74656b640aa7"
+     "766f74656b6579c420f66af5dd18bcac57a9c4dde084852b64dba2e8baaa339844cc1e3946b8b99645a7766f74656c73"
+     "74cd07d0"},
+    {"txKeyreg_offline",
+     "86a3666565cd0708a26676cd03e7a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5"
+     "093a22a26c76cd0d80a3736e64c420bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfa4"
+     "74797065a66b6579726567"},
+    {"txKeyreg_nonparticipation",
+     "87a3666565cd0762a26676cd03e7a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5"
+     "093a22a26c76cd0d80a76e6f6e70617274c3a3736e64c420bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc"
+     "10c5462db0f330dfa474797065a66b6579726567"},
+    {"txPayment", kPaymentHex},
+    {"txApplication",
+     "de0011a46170616192c40100c4020102a46170616e01a461706170c4050120010122a4617061739106a46170617492c4"
+     "20bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfc420a089aa6922e3b998fadff6cd48"
+     "08ddf9e021e4944e389ea3d5c638786689197ea4617066619103a46170677382a36e627302a36e756901a461706c7382"
+     "a36e627304a36e756903a461707375c4050220010122a3666565cd03e8a26676ce0004ec0fa367656eac746573746e65"
+     "742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76ce00"
+     "04eff7a46e6f7465c40a6e6f74652076616c7565a3736e64c42009fbd2762c08f86c5ae6bf6dd7a7a901de6675d750e0"
+     "7e8c5c7698647db6e1fda474797065a46170706c"},
+    {"txApplicationLong",
+     "de0011a46170616198c4fa9fdd8fe9420e5d401d02050d78f5d13ea9f209d0a101e382f70d13d4dced8f5425a96ace5c"
+     "8858b8654b2a3904cf175b1f9cee6069d765f1fe42fa23151dd9baa382f709a1681267b8ee9f47f7964c0e7e9ab3cf42"
+     "6964433ec29a17150ac82bce2b5044512412d0522586f2d52338584173242117110426cfbf22fb416a298bcdbfc02018"
+     "dc8689d773f564516bd40eec2831147cc56729d92b743cfa3b585b1bc7c9383735cf5c6459efce18bc773a5014d1f700"
+     "0011e671f05ad740cc4349e365f700fb73f06dc4da14c46bbb47e1b920d9b2b5c7506bc2e3af13a561f065d54c3ca633"
+     "3078e803f12b12d6b1e6276b76e8ce5c95a8930607c4fa1a79a6c371f3bdb6ecaef12c98118b51e64cc6190a362a521c"
+     "4feff89f3ac9b6ea2804e52ee1a09601a3dd4d6da599052238ef69b14da54fac103081ac627d0c9cd6196103e2798427"
+     "f999c6737ef0e770f8096a97100ed05b5127d1bc686c1d2f634fc87f569792de426e496e6f2d36e586961c1babeca1f9"
+     "122fdea0be1ac6f3bd89eae5ced97066983c30a41bd946265083aef7cab65394586a0226e9fb9f9caf65ef7e9ac69a71"
+     "1b483e21b60f501aea434af068985547a8065eb1a8db313e83e5551e2535be7cc6f05b48920b2cb2a2d84be39f8cfb3f"
+     "20ea66adda16bd4396f7703827ad77edab3f1b3953f12e193367e994f9943972afc4fa69f8e9851b4e31fcd4c7980552"
+     "a273ad0a982685b50e9b2e2481131a4901b5d9ecc8595c6f3d29a6f4f7a9afe5e3466e7edd1bd811050744cf5ea26f36"
+     "d5e2d82ec4e86a98104da56fd1a20e41e75694f2329d2dc9910cb48dc1927d43926c424c3f012634c7f778fee1483720"
+     "25dccf07af54e01d308a63f5cd0b99eea963a914e1f366bba3fb026e43e6244fa934ce990bb3ba6d8d408e017eb2a7ab"
+     "a1bbb191c5868e044ce2628ec70ee5506efe1f3ae7f326db07438b3ec99b9c64a960078c03f88c77b4ab6a9826c8f739"
+     "9fdfd80008c9da7622886805bc1b0b9fef2b3a9fddd94b8f7852bc24d2f8d081003a5e7bd54b40df125cf3d639c4fa6b"
+     "f2401f9bbf4550cf056c47d1b5b18fd11e2f1b6a910650a7bc161b38bf8c18a97de0909ec1d42154f07530fa15f65848"
+     "4e1403f4bbbb836e106837b56977f43ce72e1cf6c8222c5726dc9ab61261c59c0308d0caec0e79f629fea21c4d5e3765"
+     "7d350f2bed1320f4df74f90078c6800779700a1b6f851bd6a4662ee1a2f1965491615cdd484827cfe830fe4e7c482f95"
+     "6431f8cef99614cc367165ddc3e75877ecbca5223c73c8e7a9aadc7a007c7f40a69ae9f97469f08bf2cd1d62f1aea883"
+     "3b5e063ce743c6a7670e6ad82c802563d217efc9e461b4b503fec0c8c28ab5ee4ab55bcf5789cff1aabed964b7fbe642"
+     "ad0a4584d31e66d1c9c4fa4badbbfe681e82d4fcc34edcfb176fc16221a9271086bc5933e43ea47be65d75aa3e225b1b"
+     "223a8376dd7a7751cc0c825b032da8d202f251f19b58a7313ea10bd791d59b942937bfd24d4d7f781cce8c58ba9350fa"
+     "3adefca37b1fb070c9c4fa6eb7f1cc6ed99a7a98d8d8f00279ca68a1885393131be65d330ca93dd76f99297c48a2ed5c"
+     "853aefe61a0758aa359d61b9e1aefb1106303a05fc4ba843662be86d97f70b01241dd0693d5f01aa0f2938da6b2c47b0"
+     "d96042a21470b03fee201a97f4b2070743250c3a640e2647c36920c40c63348c037acdd4d9f6e4b86a7d5cf87f1b1d8c"
+     "cbf6f7cedcf9cfe9c2105ca300d0e074cf5c5b9c0bc4fae111faa1ce7b4cbd47f528fb5327c3badec3db5698695af695"
+     "d7c9db8210f924c1220801769ad2b65ea72bd518b46f351a1804b3e93496d1e9834e3546abe76493481992e24fc4573f"
+     "457e4aea0084cbea1eb91caee15da54452b41858da726e9ac10b4232f107908c9f2b936865a19377890aaad5b2f158d8"
+     "8cc53df26bdf4d51b3a0b1b94d4441de1a0c0a8c517de54538c647290dbb4db054699989f206dbd1299a63b2d5672059"
+     "cada5134e0cd0478e17989c5ea55f1b298984ba5728f7c79bc84e79083f83853a9f09bbe0560da7e6cfe3c7657578d19"
+     "94b824eb7c25b4c0803f9768040aa522d4e9fba8531800498bd12785f7d9d28753c4fa388cdf4dee8b9874da3c94bf4c"
+     "edd8b8b5bd9a5ce3eb407224fc3b19e422c9455e090b6052cedc4d1107d8613578a775b058b91af5b0450836e0d768fa"
+     "d6fdbfcb9686ec326719d86d8ffdd5c91ceb6fe05e0e2fc84f477a43435b2112807b6858a590cc6bbfc22630dee70732"
+     "bc44b1278ec540a8828575f4d1c1ce5f67d1a3c56adec705b7079441f8263b6a0b6e4cf88196e56ec1ec3e21162d4bc1"
+     "d5d73552eb5870172932e3ef4899e8ded2f2ee203466afa87a48dbad2c7f90a8924ced012ace8b03fbee69dcc01c6169"
+     "1261da545973c2c41e1f4af7cd2c97c3068f6bd32bb1efcded16cae7c0698269efda034aaae5651eeb3fc58280c4fa9c"
+     "97c887a9136dbcfb6b496bbe84b32448d8e3e4be62f3db55b702b8e950b351dcd9593297aa1e890e82511caa3aec28c9"
+     "da8204aca8cb1fbd5389a9de3f653bacf053d8b875ca08080fe7ed5dac2dfc77745416e5a30a51535d473939bd167cc4"
+     "c687047c44f9fa6bcd6f978b7005a135c6b0b8c0416d9e17ea3ba8a5089089c39151b6a27e1e1fa07fe3c8daabec26c8"
+     "65767882e0e6ef7201f3b4865514843000b6ad84817f2c08916bba9ba5f4195a2c9c6e3b0b80426620f8cd206932a89e"
+     "6e8e82d4fbb77b9a2c584e02252619d7478768ab43390251a4d7577063516d18fc62c299fe62b0bfc8cd79a133f2a797"
+     "6132e1ac1d8fcf16f0a46170616e04a461706170c480c0721b691b335da47a695a7246492eb3fb88c3b3463024439091"
+     "287154a3c409d4f0389bb7d9a9ab49237b671cfe5b293141039e91555f76bab6cd5adedc5489c207e20070c47eb6d7cc"
+     "12330c4fb4f048f28fe24f1ab69e7a58e29b51753b33146e8c32a3bdc716e5956572281d63c27d7e7b59e1fd5d42feed"
+     "b568ada19c5ea46170617392cd1b70cd1d4ea46170617494c42033627e03aaa4c34b2e3ae7aa2d049a776afdf3d8beeb"
+     "de452f27e60837febc32c420eb3b7a3800eae990c379c60c3ab0f571225954f7be5190435810332d695ac82ac42044d2"
+     "11e4acc09eb27d59773c62e5e9e8a8fbc76d460bd2c542ea618eb63f03dcc420931468e76ebfb4b466ab82edfb5b0c39"
+     "5f05f7d70c0ea970c8d96b01c43d2841a46170666192cd0137cd079ea46170677382a36e6273ce17c2f571a36e7569ce"
+     "35326631a461706c7382a36e6273ce039892fca36e7569ce42f762faa461707375c4201be56dfbb007190ed78a890b9a"
+     "613c0e8b6656bee4e874f53f6d6dae9e54df14a3666565cd03e8a26676ce000dc8cda367656eac746573746e65742d76"
+     "312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76ce0017c94c"
+     "a46e6f7465c504007475727069732065676573746173207072657469756d2061656e65616e207068617265747261206d"
+     "61676e6120616320706c61636572617420766573746962756c756d206c6563747573206d617572697320756c74726963"
+     "65732065726f7320696e2063757273757320747572706973206d617373612074696e636964756e742064756920757420"
+     "6f726e617265206c65637475732073697420616d65742065737420706c61636572617420696e20656765737461732065"
+     "72617420696d706572646965742073656420657569736d6f64206e69736920706f727461206c6f72656d206d6f6c6c69"
+     "7320616c697175616d20757420706f72747469746f72206c656f2061206469616d20736f6c6c696369747564696e2074"
+     "656d706f72206964206575206e69736c206e756e63206d6920697073756d20666175636962757320766974616520616c"
+     "6971756574206e656320756c6c616d636f727065722073697420616d6574207269737573206e756c6c616d2065676574"
+     "2066656c69732065676574206e756e63206c6f626f72746973206d617474697320616c697175616d2066617563696275"
+     "7320707572757320696e206d617373612074656d706f72206e65632066657567696174206e69736c207072657469756d"
+     "2066757363652069642076656c697420757420746f72746f72207072657469756d20766976657272612073757370656e"
+     "646973736520706f74656e7469206e756c6c616d20616320746f72746f72207669746165207075727573206661756369"
+     "627573206f726e6172652073757370656e646973736520736564206e697369206c616375732073656420746f72746f72"
+     "207669746165207075727573206661756369627573206f726e6172652073757370656e646973736520736564206e6973"
+     "69206c616375732073656420746f72746f72207669746165207075727573206661756369627573206f726e6172652073"
+     "757370656e646973736520736564206e697369206c616375732073656420746f72746f72207669746165207075727573"
+     "206661756369627573206f726e6172652073757370656e646973736520736564206e697369206c616375732073656420"
+     "746f72746f72207669746165207075727573206661756369627573206f726e6172652073757370656e64697373652073"
+     "6564206e697369206c616375732073656420746f72746f72207669746165207075727573206661756369627573206f72"
+     "6e6172652073757370656e646973736520736564206e697369206c616375732073656420746f72746f72207669746165"
+     "207075727573206661756369627573206f726e6172652073757370656e646973736520736564206e697369206c616375"
+     "732073656420746f72746f72207669746165207075727573a3736e64c420626def77f13c1e0ec9ec64d9bc10a4f3111b"
+     "4986a01dd15e4e11a36af98b3d2da474797065a46170706c"},
+};
+
+// Minimal msgpack writer used to build the synthetic worst cases
+class MsgpackWriter {
+public:
+    MsgpackWriter &map(size_t items) { return header(0x80, 0xde, items); }
+
+    MsgpackWriter &array(size_t items) { return header(0x90, 0xdc, items); }
+
+    MsgpackWriter &str(const char *s) {
+        const size_t len = strlen(s);
+        buffer.push_back(static_cast<uint8_t>(0xa0 | len));
+        buffer.insert(buffer.end(), s, s + len);
+        return *this;
+    }
+
+    MsgpackWriter &bin(size_t len, uint8_t fill) {
+        if (len <= UINT8_MAX) {
+            buffer.push_back(0xc4);
+            buffer.push_back(static_cast<uint8_t>(len));
+        } else {
+            buffer.push_back(0xc5);
+            buffer.push_back(static_cast<uint8_t>(len >> 8));
+            buffer.push_back(static_cast<uint8_t>(len));
+        }
+        buffer.insert(buffer.end(), len, fill);
+        return *this;
+    }
+
+    MsgpackWriter &uint(uint64_t value) {
+        if (value < 0x80) {
+            buffer.push_back(static_cast<uint8_t>(value));
+            return *this;
+        }
+        buffer.push_back(0xcf);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            buffer.push_back(static_cast<uint8_t>(value >> shift));
+        }
+        return *this;
+    }
+
+    std::vector<uint8_t> buffer;
+
+private:
+    MsgpackWriter &header(uint8_t fixType, uint8_t type16, size_t items) {
+        if (items < 16) {
+            buffer.push_back(static_cast<uint8_t>(fixType | items));
+        } else {
+            buffer.push_back(type16);
+            buffer.push_back(static_cast<uint8_t>(items >> 8));
+            buffer.push_back(static_cast<uint8_t>(items));
+        }
+        return *this;
+    }
+};
+
+void writeCommonFields(MsgpackWriter &w, const char *type) {
+    w.str("type").str(type);
+    w.str("snd").bin(32, 0x11);
+    w.str("lx").bin(32, 0x22);
+    w.str("rekey").bin(32, 0x33);
+    w.str("fee").uint(1000000);
+    w.str("gen").str("mainnet-v1.0");
+    w.str("gh").bin(32, 0x44);
+    w.str("grp").bin(32, 0x55);
+    w.str("note").bin(MAX_NOTE_LEN, 'n');
+    w.str("fv").uint(1000);
+    w.str("lv").uint(2000);
+}
+
+// Payment with every optional common field and the largest accepted note
+std::vector<uint8_t> worstCasePayment() {
+    MsgpackWriter w;
+    w.map(14);
+    writeCommonFields(w, "pay");
+    w.str("amt").uint(UINT64_MAX);
+    w.str("rcv").bin(32, 0x66);
+    w.str("close").bin(32, 0x77);
+    return w.buffer;
+}
+
+// Payment carrying an unknown field full of nested values the key index has to skip over
+std::vector<uint8_t> skipHeavyPayment() {
+    const size_t numEntries = 200;
+
+    MsgpackWriter w;
+    w.map(15);
+    writeCommonFields(w, "pay");
+    w.str("amt").uint(1000);
+    w.str("rcv").bin(32, 0x66);
+    w.str("close").bin(32, 0x77);
+
+    w.str("xtra").array(numEntries);
+    for (size_t i = 0; i < numEntries; i++) {
+        w.map(3);
+        w.str("a").array(4).uint(1).uint(2).uint(300).uint(70000);
+        w.str("b").bin(16, static_cast<uint8_t>(i));
+        w.str("c").map(1).str("d").array(2).uint(i).str("e");
+    }
+    return w.buffer;
+}
+
+// Application creation with every array at its limit and the largest programs
+std::vector<uint8_t> worstCaseApplication() {
+    const size_t numArgs = MAX_ARG;
+    const size_t numAccounts = MAX_ACCT;
+    const size_t numForeign = (ACCT_FOREIGN_LIMIT - MAX_ACCT) / 2;
+    const size_t numBoxes = 4;
+
+    MsgpackWriter w;
+    w.map(23);
+    writeCommonFields(w, "appl");
+    w.str("apid").uint(0);
+    w.str("apan").uint(0);
+
+    w.str("apbx").array(numBoxes);
+    for (size_t i = 0; i < numBoxes; i++) {
+        w.map(2).str("i").uint(i).str("n").bin(BOX_NAME_MAX_LENGTH, 'b');
+    }
+
+    w.str("apfa").array(numForeign);
+    for (size_t i = 0; i < numForeign; i++) {
+        w.uint(UINT64_MAX - i);
+    }
+
+    w.str("apas").array(numForeign);
+    for (size_t i = 0; i < numForeign; i++) {
+        w.uint(UINT64_MAX - i);
+    }
+
+    w.str("apat").array(numAccounts);
+    for (size_t i = 0; i < numAccounts; i++) {
+        w.bin(32, static_cast<uint8_t>(0x80 + i));
+    }
+
+    w.str("apaa").array(numArgs);
+    for (size_t i = 0; i < numArgs; i++) {
+        w.bin(MAX_ARGLEN / numArgs, static_cast<uint8_t>('a' + i));
+    }
+
+    w.str("apgs").map(2).str("nbs").uint(64).str("nui").uint(64);
+    w.str("apls").map(2).str("nbs").uint(16).str("nui").uint(16);
+    w.str("apep").uint(3);
+    w.str("apap").bin(3 * PAGE_LEN, 0x01);
+    w.str("apsu").bin(PAGE_LEN, 0x02);
+    return w.buffer;
+}
+
+// NoOp call with the most app args, accounts and boxes that are shown item by item
+std::vector<uint8_t> maxApplicationCall() {
+    const size_t numArgs = MAX_ARG;
+    const size_t numAccounts = MAX_ACCT;
+    const size_t numBoxes = MAX_FOREIGN_APPS;
+
+    MsgpackWriter w;
+    w.map(16);
+    writeCommonFields(w, "appl");
+    w.str("apid").uint(UINT64_MAX);
+    w.str("apan").uint(NOOPOC);
+
+    w.str("apbx").array(numBoxes);
+    for (size_t i = 0; i < numBoxes; i++) {
+        w.map(2).str("i").uint(0).str("n").bin(BOX_NAME_MAX_LENGTH, static_cast<uint8_t>('0' + i));
+    }
+
+    w.str("apat").array(numAccounts);
+    for (size_t i = 0; i < numAccounts; i++) {
+        w.bin(32, static_cast<uint8_t>(0x80 + i));
+    }
+
+    w.str("apaa").array(numArgs);
+    for (size_t i = 0; i < numArgs; i++) {
+        w.bin(MAX_ARGLEN / numArgs, static_cast<uint8_t>('a' + i));
+    }
+    return w.buffer;
+}
+
+// Optional json corpora shared with the UI tests
+void loadJsonCorpus(const std::string &jsonFile, std::vector<bench_vector_t> &corpus) {
+    std::ifstream inFile(std::string(TESTVECTORS_DIR) + jsonFile);
+    if (!inFile.is_open()) {
+        return;
+    }
+
+    Json::CharReaderBuilder builder;
+    Json::Value obj;
+    JSONCPP_STRING errs;
+    if (!Json::parseFromStream(builder, inFile, &obj, &errs)) {
+        return;
+    }
+
+    for (Json::ArrayIndex i = 0; i < obj.size(); i++) {
+        const std::string hex = obj[i]["blob"].asString();
+        bench_vector_t v;
+        v.name = "json/" + obj[i]["name"].asString();
+        v.blob.resize(hex.size() / 2);
+        if (parseHexString(v.blob.data(), v.blob.size(), hex.c_str()) != v.blob.size()) {
+            continue;
+        }
+        corpus.push_back(v);
+    }
+}
+
+std::vector<bench_vector_t> buildCorpus() {
+    std::vector<bench_vector_t> corpus;
+
+    for (const auto &entry : kTxVectors) {
+        bench_vector_t v;
+        v.name = entry[0];
+        v.blob.resize(strlen(entry[1]) / 2);
+        parseHexString(v.blob.data(), v.blob.size(), entry[1]);
+        corpus.push_back(v);
+    }
+
+    loadJsonCorpus("testcases.json", corpus);
+    loadJsonCorpus("testcases_big_transactions.json", corpus);
+
+    corpus.push_back({"worstCasePayment", worstCasePayment()});
+    corpus.push_back({"worstCaseApplication", worstCaseApplication()});
+    corpus.push_back({"maxApplicationCall", maxApplicationCall()});
+    corpus.push_back({"skipHeavyPayment", skipHeavyPayment()});
+    return corpus;
+}
+
+// Parses the vector once outside the timed loop; phases after parsing reuse this context.
+// bytesScanned is sampled here because rendering keeps reading through the same context.
+bool prepare(benchmark::State &state, const bench_vector_t &v, parser_context_t *ctx, parser_tx_t *tx_obj) {
+    memset(tx_obj, 0, sizeof(*tx_obj));
+    const parser_error_t err = parser_parse(ctx, v.blob.data(), v.blob.size(), tx_obj);
+    if (err != parser_ok) {
+        state.SkipWithError(parser_getErrorDescription(err));
+        return false;
+    }
+    state.counters["tx_bytes"] = static_cast<double>(v.blob.size());
+    state.counters["bytes_scanned"] = static_cast<double>(ctx->bytesScanned);
+    return true;
+}
+
+void setBytesProcessed(benchmark::State &state, const bench_vector_t &v) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * v.blob.size()));
+}
+
+void BM_ParserParse(benchmark::State &state, const bench_vector_t &v) {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    if (!prepare(state, v, &ctx, &tx_obj)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        parser_error_t err = parser_parse(&ctx, v.blob.data(), v.blob.size(), &tx_obj);
+        benchmark::DoNotOptimize(err);
+        benchmark::ClobberMemory();
+    }
+    setBytesProcessed(state, v);
+}
+
+// Mirrors tx_parse: the transaction object is cleared before every parse
+void BM_TxParse(benchmark::State &state, const bench_vector_t &v) {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    if (!prepare(state, v, &ctx, &tx_obj)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        memset(&tx_obj, 0, sizeof(tx_obj));
+        parser_error_t err = parser_parse(&ctx, v.blob.data(), v.blob.size(), &tx_obj);
+        benchmark::DoNotOptimize(err);
+        benchmark::ClobberMemory();
+    }
+    setBytesProcessed(state, v);
+    state.counters["tx_obj_size"] = static_cast<double>(sizeof(tx_obj));
+}
+
+void BM_ParserValidate(benchmark::State &state, const bench_vector_t &v) {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    if (!prepare(state, v, &ctx, &tx_obj)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        parser_error_t err = parser_validate(&ctx);
+        benchmark::DoNotOptimize(err);
+    }
+    setBytesProcessed(state, v);
+}
+
+void BM_ParserValidateStructure(benchmark::State &state, const bench_vector_t &v) {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    if (!prepare(state, v, &ctx, &tx_obj)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        parser_error_t err = parser_validateStructure(&ctx);
+        benchmark::DoNotOptimize(err);
+    }
+    setBytesProcessed(state, v);
+}
+
+void BM_ParserRender(benchmark::State &state, const bench_vector_t &v) {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    if (!prepare(state, v, &ctx, &tx_obj)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        auto output = dumpUI(&ctx, 40, 40);
+        benchmark::DoNotOptimize(output.data());
+    }
+    setBytesProcessed(state, v);
+}
+
+// One parser_getItem call per page, as the UI requests them while the user scrolls.
+// Cold clears the address cache and the rendered item before every call, which is
+// what each page cost when every request ran the formatters from scratch.
+// scrollBack pages each item to the end and back to its first page.
+// Pages are the width of a Nano S line, where addresses span four of them.
+void BM_ParserRenderPage(benchmark::State &state, const bench_vector_t &v, bool cold, bool scrollBack) {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    if (!prepare(state, v, &ctx, &tx_obj)) {
+        return;
+    }
+
+    uint8_t numItems = 0;
+    parser_getNumItems(&ctx, &numItems);
+    std::vector<std::pair<uint8_t, uint8_t>> pages;
+    char key[20];
+    char value[18];
+    for (uint8_t idx = 0; idx < numItems; idx++) {
+        uint8_t pageCount = 0;
+        parser_getItem(&ctx, idx, key, sizeof(key), value, sizeof(value), 0, &pageCount);
+        for (uint8_t page = 0; page < pageCount; page++) {
+            pages.emplace_back(idx, page);
+        }
+        for (uint8_t page = pageCount - 1; scrollBack && page > 0; page--) {
+            pages.emplace_back(idx, page - 1);
+        }
+    }
+
+    for (auto _ : state) {
+        for (const auto &page : pages) {
+            if (cold) {
+                ctx.addresses.count = 0;
+                ctx.addresses.next = 0;
+                ctx.rendered.state = RENDER_NONE;
+            }
+            uint8_t pageCount = 0;
+            parser_error_t err = parser_getItem(&ctx, page.first, key, sizeof(key), value, sizeof(value),
+                                                page.second, &pageCount);
+            benchmark::DoNotOptimize(err);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.counters["pages"] = static_cast<double>(pages.size());
+    state.counters["time_per_page"] = benchmark::Counter(static_cast<double>(pages.size()),
+                                                         benchmark::Counter::kIsIterationInvariantRate |
+                                                         benchmark::Counter::kInvert);
+}
+
+void BM_EncodePubKey(benchmark::State &state) {
+    uint8_t publicKey[32];
+    char address[65];
+    for (uint8_t i = 0; i < sizeof(publicKey); i++) {
+        publicKey[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+
+    for (auto _ : state) {
+        uint32_t len = encodePubKey(reinterpret_cast<uint8_t *>(address), sizeof(address), publicKey);
+        benchmark::DoNotOptimize(len);
+        publicKey[0]++;
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(publicKey)));
+}
+
+// Verified asset lookup, as _readTxAssetXfer resolves it once per asset transfer
+void BM_AsaLookup(benchmark::State &state, uint64_t id) {
+    for (auto _ : state) {
+        algo_asset_t asa;
+        bool found = algo_asa_get(id, &asa);
+        benchmark::DoNotOptimize(found);
+        benchmark::DoNotOptimize(asa);
+        benchmark::DoNotOptimize(id);
+    }
+}
+
+constexpr size_t kStoreAssets = 1 << 20;
+
+uint64_t storeAssetId(size_t i) {
+    return i * 2654435761ULL % 2000000000ULL * 1024 + i;
+}
+
+// Asset store the size of a full asset registry, ids spread like real asset ids.
+// Built on first use, so runs filtering it out do not pay for it.
+const std::string &assetStorePath() {
+    static const std::string path = [] {
+        const std::string file = "/tmp/parser_bench_assets.bin";
+        std::vector<std::string> names(kStoreAssets);
+        std::vector<asset_store_entry_t> entries(kStoreAssets);
+        for (size_t i = 0; i < kStoreAssets; i++) {
+            names[i] = "Asset " + std::to_string(i);
+            entries[i] = {storeAssetId(i), names[i].c_str(), "UNIT", static_cast<uint8_t>(i % 20)};
+        }
+        return asset_store_write(file.c_str(), entries.data(), entries.size()) ? file : std::string();
+    }();
+    return path;
+}
+
+void BM_AssetStoreOpen(benchmark::State &state) {
+    const std::string &path = assetStorePath();
+    for (auto _ : state) {
+        asset_store_t *store = asset_store_open(path.c_str());
+        benchmark::DoNotOptimize(store);
+        asset_store_close(store);
+    }
+}
+
+// Lookups through the resolver hook, ids of listed and unlisted assets alternate
+void BM_AssetStoreLookup(benchmark::State &state) {
+    asset_store_t *store = asset_store_open(assetStorePath().c_str());
+    if (store == nullptr) {
+        state.SkipWithError("asset store missing");
+        return;
+    }
+    algo_asa_set_resolver(asset_store_resolve, store);
+    size_t i = 0;
+    for (auto _ : state) {
+        const size_t n = (i++ * 40503) % kStoreAssets;
+        uint64_t id = storeAssetId(n) + (i & 1);
+        algo_asset_t asa;
+        bool found = algo_asa_get(id, &asa);
+        benchmark::DoNotOptimize(found);
+        benchmark::DoNotOptimize(asa);
+    }
+    algo_asa_set_resolver(nullptr, nullptr);
+    asset_store_close(store);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    static const std::vector<bench_vector_t> corpus = buildCorpus();
+
+    for (const auto &v : corpus) {
+        benchmark::RegisterBenchmark(("parser_parse/" + v.name).c_str(), BM_ParserParse, v);
+        benchmark::RegisterBenchmark(("tx_parse/" + v.name).c_str(), BM_TxParse, v);
+        benchmark::RegisterBenchmark(("parser_validate/" + v.name).c_str(), BM_ParserValidate, v);
+        benchmark::RegisterBenchmark(("parser_validateStructure/" + v.name).c_str(), BM_ParserValidateStructure, v);
+        benchmark::RegisterBenchmark(("render/" + v.name).c_str(), BM_ParserRender, v);
+        benchmark::RegisterBenchmark(("render_page/cold/" + v.name).c_str(), BM_ParserRenderPage, v, true, false);
+        benchmark::RegisterBenchmark(("render_page/warm/" + v.name).c_str(), BM_ParserRenderPage, v, false, false);
+        benchmark::RegisterBenchmark(("render_scroll/cold/" + v.name).c_str(), BM_ParserRenderPage, v, true, true);
+        benchmark::RegisterBenchmark(("render_scroll/warm/" + v.name).c_str(), BM_ParserRenderPage, v, false, true);
+    }
+    benchmark::RegisterBenchmark("encodePubKey", BM_EncodePubKey);
+    benchmark::RegisterBenchmark("asa_lookup/listed", BM_AsaLookup, 31566704);     // USDC
+    benchmark::RegisterBenchmark("asa_lookup/unlisted", BM_AsaLookup, 31566705);
+    benchmark::RegisterBenchmark("asset_store/open/1M", BM_AssetStoreOpen);
+    benchmark::RegisterBenchmark("asset_store/lookup/1M", BM_AssetStoreLookup);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
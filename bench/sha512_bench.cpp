@@ -0,0 +1,171 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "sha512.h"
+#include "sha512_xn.h"
+#include "address_batch.h"
+#include "parser_encoding.h"
+
+namespace {
+
+// APDU payload size used by the clients (js/src/common.ts CHUNK_SIZE)
+const size_t kApduChunk = 250;
+
+std::vector<uint8_t> message(size_t len) {
+    std::vector<uint8_t> msg(len);
+    for (size_t i = 0; i < len; i++) {
+        msg[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return msg;
+}
+
+void BM_OneShot(benchmark::State &state) {
+    const std::vector<uint8_t> msg = message(static_cast<size_t>(state.range(0)));
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+
+    for (auto _ : state) {
+        SHA512_256(msg.data(), msg.size(), digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * msg.size()));
+}
+
+// range(1) is the size of each Update call, as chunks would arrive over USB/BLE
+void BM_Streaming(benchmark::State &state) {
+    const std::vector<uint8_t> msg = message(static_cast<size_t>(state.range(0)));
+    const size_t chunkLen = static_cast<size_t>(state.range(1));
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+
+    for (auto _ : state) {
+        SHA512_256_CTX ctx;
+        SHA512_256_Init(&ctx);
+        for (size_t offset = 0; offset < msg.size(); offset += chunkLen) {
+            SHA512_256_Update(&ctx, msg.data() + offset, std::min(chunkLen, msg.size() - offset));
+        }
+        SHA512_256_Final(&ctx, digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * msg.size()));
+}
+
+// From a public key up to the largest transaction the device buffers
+const int64_t kSizes[] = {32, 128, 1024, 4096, 16384};
+
+void OneShotArgs(benchmark::internal::Benchmark *b) {
+    for (int64_t size : kSizes) {
+        b->Arg(size);
+    }
+}
+
+void StreamingArgs(benchmark::internal::Benchmark *b) {
+    for (int64_t size : kSizes) {
+        for (int64_t chunk : {static_cast<int64_t>(1), static_cast<int64_t>(128), static_cast<int64_t>(kApduChunk)}) {
+            if (chunk <= size) {
+                b->Args({size, chunk});
+            }
+        }
+    }
+}
+
+std::vector<std::array<uint8_t, PK_LEN_25519>> publicKeys(size_t count) {
+    std::vector<std::array<uint8_t, PK_LEN_25519>> keys(count);
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < PK_LEN_25519; j++) {
+            keys[i][j] = static_cast<uint8_t>(i * 131 + j * 7);
+        }
+    }
+    return keys;
+}
+
+// Address checksum hashing, one key at a time
+void BM_ChecksumScalar(benchmark::State &state) {
+    const auto keys = publicKeys(static_cast<size_t>(state.range(0)));
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+
+    for (auto _ : state) {
+        for (const auto &key : keys) {
+            SHA512_256(key.data(), key.size(), digest);
+            benchmark::DoNotOptimize(digest);
+        }
+    }
+    state.counters["addresses_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * keys.size()), benchmark::Counter::kIsRate);
+}
+
+// Same hashes through the multi-buffer kernel picked at runtime
+void BM_ChecksumMultiBuffer(benchmark::State &state) {
+    const auto keys = publicKeys(static_cast<size_t>(state.range(0)));
+    std::vector<const uint8_t *> in(keys.size());
+    std::vector<size_t> n(keys.size(), PK_LEN_25519);
+    for (size_t i = 0; i < keys.size(); i++) {
+        in[i] = keys[i].data();
+    }
+    std::vector<std::array<uint8_t, SHA512_DIGEST_LENGTH>> digests(keys.size());
+
+    for (auto _ : state) {
+        SHA512_256_xN(in.data(), n.data(), keys.size(),
+                      reinterpret_cast<uint8_t (*)[SHA512_DIGEST_LENGTH]>(digests.data()));
+        benchmark::DoNotOptimize(digests.data());
+    }
+    state.counters["addresses_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * keys.size()), benchmark::Counter::kIsRate);
+    state.SetLabel(SHA512_256_xN_kernel());
+}
+
+// Full public key to base32 address conversion
+void BM_EncodePubKey(benchmark::State &state) {
+    const auto keys = publicKeys(static_cast<size_t>(state.range(0)));
+    uint8_t address[ADDRESS_BUFFER_LEN];
+
+    for (auto _ : state) {
+        for (const auto &key : keys) {
+            encodePubKey(address, sizeof(address), key.data());
+            benchmark::DoNotOptimize(address);
+        }
+    }
+    state.counters["addresses_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * keys.size()), benchmark::Counter::kIsRate);
+}
+
+void BM_EncodePubKeyBatch(benchmark::State &state) {
+    const auto keys = publicKeys(static_cast<size_t>(state.range(0)));
+    std::vector<std::array<char, ADDRESS_BUFFER_LEN>> addresses(keys.size());
+
+    for (auto _ : state) {
+        encodePubKeyBatch(reinterpret_cast<const uint8_t (*)[PK_LEN_25519]>(keys.data()), keys.size(),
+                          reinterpret_cast<char (*)[ADDRESS_BUFFER_LEN]>(addresses.data()));
+        benchmark::DoNotOptimize(addresses.data());
+    }
+    state.counters["addresses_per_second"] =
+        benchmark::Counter(static_cast<double>(state.iterations() * keys.size()), benchmark::Counter::kIsRate);
+    state.SetLabel(SHA512_256_xN_kernel());
+}
+
+}  // namespace
+
+BENCHMARK(BM_ChecksumScalar)->Arg(1024);
+BENCHMARK(BM_ChecksumMultiBuffer)->Arg(1024);
+BENCHMARK(BM_EncodePubKey)->Arg(1024);
+BENCHMARK(BM_EncodePubKeyBatch)->Arg(1024);
+BENCHMARK(BM_OneShot)->Apply(OneShotArgs);
+BENCHMARK(BM_Streaming)->Apply(StreamingArgs);
+
+BENCHMARK_MAIN();
@@ -41,7 +41,8 @@ try:
   while p2 == 0x80:
     thischunk = tosend[:250]
     if len(thischunk) == len(tosend):
-      p2 = 0
+      # Last chunk, with the transaction ID in the reply
+      p2 = 0x01
 
     # CLA
     apdu = "\x80"
@@ -56,16 +57,24 @@ try:
 
     apdu += thischunk
 
-    signature = dongle.exchange(apdu)
+    response = dongle.exchange(apdu)
 
     tosend = tosend[len(thischunk):]
     p1 = 0x80
 
-  if len(signature) > 64:
-    raise Exception("Error: %s" % signature[65:])
+  if len(response) != 96:
+    raise Exception("Error: %s" % response[65:])
+
+  # Signature followed by the transaction ID
+  signature = response[:64]
+  txid = response[64:]
 
   print "signature " + str(signature).encode('hex')
 
+  if str(txid) != sha512_256.new('TX' + txbytes).digest():
+    raise Exception("Error: device returned txid %s" % str(txid).encode('hex'))
+  print "txid " + base64.b32encode(str(txid)).replace("=", "")
+
   ed25519.checkvalid(str(signature), 'TX' + txbytes, str(publicKey))
   print "Verified signature"
 
@@ -65,13 +65,9 @@ void secure_wipe(uint8_t *v, uint32_t n) {
 }
 
 /*
- * SHA-512 context structure
+ * SHA-512 context structure, public as SHA512_256_CTX
  */
-typedef struct {
-    uint64_t total[2];         /*!< number of bytes processed  */
-    uint64_t state[8];         /*!< intermediate digest state  */
-    unsigned char buffer[128]; /*!< data block being processed */
-} mbedtls_sha512_context;
+typedef SHA512_256_CTX mbedtls_sha512_context;
 
 /*
  * 64-bit integer manipulation macros (big endian)
@@ -321,29 +317,39 @@ static void mbedtls_sha512_finish(mbedtls_sha512_context *ctx,
     PUT_UINT64_BE(ctx->state[7], output, 56);
 }
 
+void SHA512_256_Init(SHA512_256_CTX *ctx) {
+    mbedtls_sha512_init(ctx);
+    mbedtls_sha512_starts(ctx);
+}
+
+void SHA512_256_Update(SHA512_256_CTX *ctx, const uint8_t *in, size_t n) {
+    mbedtls_sha512_update(ctx, in, n);
+}
+
+void SHA512_256_Final(SHA512_256_CTX *ctx, uint8_t out[SHA512_DIGEST_LENGTH]) {
+    mbedtls_sha512_finish(ctx, out);
+    secure_wipe((uint8_t *) ctx, sizeof(SHA512_256_CTX));
+}
+
 /*
  * output = SHA-512( input buffer )
  */
 void SHA512_256(const uint8_t *in, size_t n, uint8_t out[SHA512_DIGEST_LENGTH]) {
-    mbedtls_sha512_context ctx;
+    SHA512_256_CTX ctx;
 
-    mbedtls_sha512_init(&ctx);
-    mbedtls_sha512_starts(&ctx);
-    mbedtls_sha512_update(&ctx, in, n);
-    mbedtls_sha512_finish(&ctx, out);
-    secure_wipe((uint8_t *) &ctx, sizeof(ctx));
+    SHA512_256_Init(&ctx);
+    SHA512_256_Update(&ctx, in, n);
+    SHA512_256_Final(&ctx, out);
 }
 
 void SHA512_256_with_context_version(const uint8_t *in_ctx, size_t n_ctx,
                                      uint8_t version,
                                      const uint8_t *in, size_t n, uint8_t out[SHA512_DIGEST_LENGTH]) {
-    mbedtls_sha512_context ctx;
-
-    mbedtls_sha512_init(&ctx);
-    mbedtls_sha512_starts(&ctx);
-    mbedtls_sha512_update(&ctx, in_ctx, n_ctx);
-    mbedtls_sha512_update(&ctx, &version, 1);
-    mbedtls_sha512_update(&ctx, in, n);
-    mbedtls_sha512_finish(&ctx, out);
-    secure_wipe((uint8_t *) &ctx, sizeof(ctx));
+    SHA512_256_CTX ctx;
+
+    SHA512_256_Init(&ctx);
+    SHA512_256_Update(&ctx, in_ctx, n_ctx);
+    SHA512_256_Update(&ctx, &version, 1);
+    SHA512_256_Update(&ctx, in, n);
+    SHA512_256_Final(&ctx, out);
 }
@@ -23,8 +23,28 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define SHA512_DIGEST_LENGTH 64
 
+// Running SHA512/256 state, for input that arrives in pieces.
+// Init, then Update any number of times with any split of the input, then Final.
+// The digest is the same as SHA512_256 over the concatenated input.
+// The context holds no pointers, so it can be copied to fork a running hash.
+typedef struct {
+    uint64_t total[2];         /*!< number of bytes processed  */
+    uint64_t state[8];         /*!< intermediate digest state  */
+    unsigned char buffer[128]; /*!< data block being processed */
+} SHA512_256_CTX;
+
+void SHA512_256_Init(SHA512_256_CTX *ctx);
+void SHA512_256_Update(SHA512_256_CTX *ctx, const uint8_t *in, size_t n);
+// Writes the digest and wipes ctx; call SHA512_256_Init before reusing it
+void SHA512_256_Final(SHA512_256_CTX *ctx, uint8_t out[SHA512_DIGEST_LENGTH]);
+
+// One-shot versions, built on the context API above
 extern void SHA512_256(const uint8_t* in, size_t n,
                        uint8_t out[SHA512_DIGEST_LENGTH]);
 
@@ -35,5 +55,9 @@ void SHA512_256_with_context_version(const uint8_t *in_ctx, size_t n_ctx,
 // Zero the memory pointed to by v; this will not be optimized away.
 extern void secure_wipe(uint8_t* v, uint32_t n);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* SHA512_H */
 
@@ -22,18 +22,46 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
     parser_context_t ctx;
     parser_error_t rc;
 
+    // Byte-by-byte streaming is the worst chunking and must reach the same verdict
+    parser_tx_t txObjStreamed;
+    memset(&txObjStreamed, 0, sizeof(txObjStreamed));
+    parser_context_t ctxStreamed;
+    parser_stream_t stream;
+    parser_error_t rcStreamed = parser_streamInit(&stream, &ctxStreamed);
+    for (size_t received = 1; received <= size && rcStreamed == parser_ok; received++) {
+        rcStreamed = parser_streamAppend(&stream, data, received);
+    }
+    if (rcStreamed == parser_ok) {
+        rcStreamed = parser_parseStreamed(&ctxStreamed, &stream, data, size, &txObjStreamed);
+    }
+
     rc = parser_parse(&ctx, data, size, &txObj);
+    if (size <= UINT16_MAX && rc != rcStreamed) {
+        fprintf(stderr,
+                "parser_parse (%s) and parser_parseStreamed (%s) disagree\n",
+                parser_getErrorDescription(rc),
+                parser_getErrorDescription(rcStreamed));
+        assert(false);
+    }
     if (rc != parser_ok) {
         return 0;
     }
 
     rc = parser_validate(&ctx);
+    const parser_error_t rcStructure = parser_validateStructure(&ctx);
+    if (rc != rcStructure) {
+        fprintf(stderr,
+                "parser_validate (%s) and parser_validateStructure (%s) disagree\n",
+                parser_getErrorDescription(rc),
+                parser_getErrorDescription(rcStructure));
+        assert(false);
+    }
     if (rc != parser_ok) {
         return 0;
     }
 
     uint8_t num_items;
-    rc = parser_getNumItems(&num_items);
+    rc = parser_getNumItems(&ctx, &num_items);
     if (rc != parser_ok) {
         fprintf(stderr,
                 "error in parser_getNumItems: %s\n",
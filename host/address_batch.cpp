@@ -0,0 +1,112 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "address_batch.h"
+#include "base32.h"
+#include "sha512_xn.h"
+
+#include <cstring>
+
+namespace {
+
+// Keys hashed per SHA512_256_xN call, a multiple of every kernel's lane count
+constexpr size_t kGroup = 64;
+
+}  // namespace
+
+size_t encodePubKeyBatch(const uint8_t (*publicKeys)[PK_LEN_25519],
+                         size_t count,
+                         char (*addresses)[ADDRESS_BUFFER_LEN]) {
+    if (publicKeys == nullptr || addresses == nullptr) {
+        return 0;
+    }
+
+    const uint8_t *in[kGroup];
+    size_t n[kGroup];
+    uint8_t digests[kGroup][SHA512_DIGEST_LENGTH];
+
+    for (size_t start = 0; start < count; start += kGroup) {
+        const size_t group = (count - start < kGroup) ? count - start : kGroup;
+        for (size_t i = 0; i < group; i++) {
+            in[i] = publicKeys[start + i];
+            n[i] = PK_LEN_25519;
+        }
+        SHA512_256_xN(in, n, group, digests);
+
+        // Key followed by the last 4 bytes of its SHA512/256, as in encodePubKey
+        for (size_t i = 0; i < group; i++) {
+            uint8_t checksummed[PK_LEN_25519 + 4];
+            memcpy(checksummed, publicKeys[start + i], PK_LEN_25519);
+            memcpy(checksummed + PK_LEN_25519, digests[i] + 28, 4);
+
+            if (base32_encode_address(checksummed, addresses[start + i], ADDRESS_BUFFER_LEN) == 0) {
+                return start + i;
+            }
+        }
+    }
+    return count;
+}
+
+size_t decodeAddressBatch(const char *const *addresses,
+                          size_t count,
+                          uint8_t (*publicKeys)[PK_LEN_25519],
+                          parser_error_t *errors) {
+    if (addresses == nullptr || publicKeys == nullptr || errors == nullptr) {
+        return 0;
+    }
+
+    const uint8_t *in[kGroup];
+    size_t n[kGroup];
+    size_t index[kGroup];
+    uint8_t checksummed[kGroup][BASE32_ADDRESS_INPUT_LEN];
+    uint8_t digests[kGroup][SHA512_DIGEST_LENGTH];
+    size_t valid = 0;
+
+    for (size_t start = 0; start < count; start += kGroup) {
+        const size_t group = (count - start < kGroup) ? count - start : kGroup;
+
+        // Only addresses that decode get hashed
+        size_t lanes = 0;
+        for (size_t i = start; i < start + group; i++) {
+            const char *address = addresses[i];
+            errors[i] = parser_invalid_address;
+            if (address == nullptr) {
+                errors[i] = parser_no_data;
+                continue;
+            }
+            const size_t len = strnlen(address, BASE32_ADDRESS_LEN + 1);
+            if (len != BASE32_ADDRESS_LEN ||
+                base32_decode(address, len, checksummed[lanes], BASE32_ADDRESS_INPUT_LEN) != BASE32_ADDRESS_INPUT_LEN) {
+                continue;
+            }
+            in[lanes] = checksummed[lanes];
+            n[lanes] = PK_LEN_25519;
+            index[lanes] = i;
+            lanes++;
+        }
+        SHA512_256_xN(in, n, lanes, digests);
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            if (memcmp(checksummed[lane] + PK_LEN_25519, digests[lane] + 28, 4) != 0) {
+                continue;
+            }
+            memcpy(publicKeys[index[lane]], checksummed[lane], PK_LEN_25519);
+            errors[index[lane]] = parser_ok;
+            valid++;
+        }
+    }
+    return valid;
+}
@@ -0,0 +1,52 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "coin.h"
+#include "parser_common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Same buffer size encodePubKey asks for
+#define ADDRESS_BUFFER_LEN (2 * PK_LEN_25519 + 1)
+
+/// Encodes public keys as checksummed base32 addresses, same output as encodePubKey.
+/// Checksums are hashed several keys at a time with SHA512_256_xN.
+/// \param publicKeys count keys of PK_LEN_25519 bytes
+/// \param addresses one NUL terminated address per key
+/// \return number of addresses written, count unless an encoding fails
+size_t encodePubKeyBatch(const uint8_t (*publicKeys)[PK_LEN_25519],
+                         size_t count,
+                         char (*addresses)[ADDRESS_BUFFER_LEN]);
+
+/// Validates and decodes addresses, same checks as decodeAddress.
+/// Checksums are hashed several keys at a time with SHA512_256_xN.
+/// \param addresses count NUL terminated addresses
+/// \param publicKeys decoded key per address, left untouched for invalid ones
+/// \param errors parser_ok or the reason each address was rejected
+/// \return number of valid addresses
+size_t decodeAddressBatch(const char *const *addresses,
+                          size_t count,
+                          uint8_t (*publicKeys)[PK_LEN_25519],
+                          parser_error_t *errors);
+
+#ifdef __cplusplus
+}
+#endif
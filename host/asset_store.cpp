@@ -0,0 +1,205 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "asset_store.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(asset_store_header_t) == 40, "asset store header layout changed");
+static_assert(sizeof(asset_store_record_t) == 24, "asset store record layout changed");
+
+struct asset_store_t {
+    void *map;
+    size_t mapSize;
+    const asset_store_record_t *records;
+    uint64_t count;
+    const char *heap;
+    uint64_t heapSize;
+};
+
+namespace {
+
+// Everything a lookup relies on is checked once here, so lookups only bound the
+// string offsets of the record they return
+bool validHeader(const asset_store_header_t *header, size_t fileSize) {
+    if (memcmp(header->magic, ASSET_STORE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != ASSET_STORE_VERSION ||
+        header->recordSize != sizeof(asset_store_record_t)) {
+        return false;
+    }
+    const uint64_t recordsEnd = sizeof(asset_store_header_t);
+    if (header->count > (fileSize - recordsEnd) / sizeof(asset_store_record_t)) {
+        return false;
+    }
+    if (header->heapOffset < recordsEnd + header->count * sizeof(asset_store_record_t) ||
+        header->heapOffset > fileSize ||
+        header->heapSize == 0 ||
+        header->heapSize > fileSize - header->heapOffset) {
+        return false;
+    }
+    // Any offset below heapSize then reads a terminated string
+    const char *heap = reinterpret_cast<const char *>(header) + header->heapOffset;
+    return heap[header->heapSize - 1] == '\0';
+}
+
+}  // namespace
+
+asset_store_t *asset_store_open(const char *path) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(asset_store_header_t))) {
+        close(fd);
+        return nullptr;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const auto *header = static_cast<const asset_store_header_t *>(map);
+    if (!validHeader(header, size)) {
+        munmap(map, size);
+        return nullptr;
+    }
+
+    auto *store = new asset_store_t;
+    store->map = map;
+    store->mapSize = size;
+    store->records = reinterpret_cast<const asset_store_record_t *>(header + 1);
+    store->count = header->count;
+    store->heap = static_cast<const char *>(map) + header->heapOffset;
+    store->heapSize = header->heapSize;
+    return store;
+}
+
+void asset_store_close(asset_store_t *store) {
+    if (store == nullptr) {
+        return;
+    }
+    munmap(store->map, store->mapSize);
+    delete store;
+}
+
+uint64_t asset_store_count(const asset_store_t *store) {
+    return store != nullptr ? store->count : 0;
+}
+
+bool asset_store_get(const asset_store_t *store, uint64_t id, algo_asset_t *asset) {
+    if (store == nullptr || asset == nullptr) {
+        return false;
+    }
+    const asset_store_record_t *end = store->records + store->count;
+    const asset_store_record_t *record = std::lower_bound(store->records, end, id,
+        [](const asset_store_record_t &r, uint64_t key) { return r.id < key; });
+    if (record == end || record->id != id ||
+        record->name >= store->heapSize || record->unit >= store->heapSize) {
+        return false;
+    }
+    asset->name = store->heap + record->name;
+    asset->unit = store->heap + record->unit;
+    asset->decimals = record->decimals;
+    return true;
+}
+
+bool asset_store_resolve(const void *store, uint64_t id, algo_asset_t *asset) {
+    return asset_store_get(static_cast<const asset_store_t *>(store), id, asset);
+}
+
+bool asset_store_write(const char *path, const asset_store_entry_t *entries, size_t count) {
+    if (path == nullptr || (entries == nullptr && count > 0)) {
+        return false;
+    }
+
+    std::vector<const asset_store_entry_t *> sorted(count);
+    for (size_t i = 0; i < count; i++) {
+        const asset_store_entry_t &e = entries[i];
+        if (e.name == nullptr || e.unit == nullptr || e.name[0] == '\0' || e.unit[0] == '\0') {
+            return false;
+        }
+        sorted[i] = &e;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const asset_store_entry_t *a, const asset_store_entry_t *b) { return a->id < b->id; });
+
+    // Names and units repeat a lot across large asset lists, each is stored once
+    std::string heap;
+    std::unordered_map<std::string, uint32_t> offsets;
+    auto intern = [&](std::string s, uint32_t *offset) {
+        auto it = offsets.find(s);
+        if (it == offsets.end()) {
+            if (heap.size() + s.size() + 1 > UINT32_MAX) {
+                return false;
+            }
+            it = offsets.emplace(s, static_cast<uint32_t>(heap.size())).first;
+            heap.append(s);
+            heap.push_back('\0');
+        }
+        *offset = it->second;
+        return true;
+    };
+
+    std::vector<asset_store_record_t> records(count);
+    for (size_t i = 0; i < count; i++) {
+        const asset_store_entry_t &e = *sorted[i];
+        if (i > 0 && e.id == sorted[i - 1]->id) {
+            return false;
+        }
+        asset_store_record_t &r = records[i];
+        memset(&r, 0, sizeof(r));
+        r.id = e.id;
+        r.decimals = e.decimals;
+        // Units are printed as an amount prefix, the separating space is part of it
+        if (!intern(e.name, &r.name) || !intern(std::string(e.unit) + " ", &r.unit)) {
+            return false;
+        }
+    }
+    if (heap.empty()) {
+        heap.push_back('\0');
+    }
+
+    asset_store_header_t header {};
+    memcpy(header.magic, ASSET_STORE_MAGIC, sizeof(ASSET_STORE_MAGIC));
+    header.version = ASSET_STORE_VERSION;
+    header.recordSize = sizeof(asset_store_record_t);
+    header.count = count;
+    header.heapOffset = sizeof(header) + count * sizeof(asset_store_record_t);
+    header.heapSize = heap.size();
+
+    FILE *f = fopen(path, "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = ok && (count == 0 || fwrite(records.data(), sizeof(asset_store_record_t), count, f) == count);
+    ok = ok && fwrite(heap.data(), 1, heap.size(), f) == heap.size();
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+}
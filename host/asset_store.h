@@ -0,0 +1,84 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "algo_asa.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Asset metadata file, used in place of the built-in asset table by host builds.
+// Layout, native little endian:
+//   asset_store_header_t
+//   count asset_store_record_t, sorted by id
+//   string heap: NUL terminated names and units, each stored once
+// Opening maps the file and checks the header, nothing is parsed or copied.
+#define ASSET_STORE_MAGIC       "ALGOASA"
+#define ASSET_STORE_VERSION     1
+
+typedef struct {
+    char magic[8];              // ASSET_STORE_MAGIC
+    uint32_t version;
+    uint32_t recordSize;        // sizeof(asset_store_record_t)
+    uint64_t count;
+    uint64_t heapOffset;        // From the start of the file
+    uint64_t heapSize;
+} asset_store_header_t;
+
+typedef struct {
+    uint64_t id;
+    uint32_t name;              // Offsets into the string heap
+    uint32_t unit;              // Printed before amounts, ends with a space
+    uint8_t decimals;
+    uint8_t reserved[7];
+} asset_store_record_t;
+
+typedef struct asset_store_t asset_store_t;
+
+// Input of asset_store_write, in any order
+typedef struct {
+    uint64_t id;
+    const char *name;
+    const char *unit;           // Without the trailing space, it is added when written
+    uint8_t decimals;
+} asset_store_entry_t;
+
+/// Maps an asset store file
+/// \return NULL if the file can not be mapped or is not a valid store
+asset_store_t *asset_store_open(const char *path);
+
+void asset_store_close(asset_store_t *store);
+
+uint64_t asset_store_count(const asset_store_t *store);
+
+/// Binary search over the mapped records
+/// \return false if id is not in the store
+bool asset_store_get(const asset_store_t *store, uint64_t id, algo_asset_t *asset);
+
+/// algo_asa_resolver_t over a store: algo_asa_set_resolver(asset_store_resolve, store)
+bool asset_store_resolve(const void *store, uint64_t id, algo_asset_t *asset);
+
+/// Sorts entries by id, stores every distinct string once and writes the file
+/// \return false on duplicate ids, empty names or units, or I/O errors
+bool asset_store_write(const char *path, const asset_store_entry_t *entries, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,192 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "group_batch.h"
+#include "sha512_xn.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Groups whose members are hashed in the same SHA512_256_xN calls
+constexpr size_t kWindow = 32;
+
+struct Scratch {
+    std::vector<group_txn_layout_t> layouts;
+    std::vector<uint8_t> messages;
+    std::vector<size_t> offsets;
+    std::vector<const uint8_t *> in;
+    std::vector<size_t> n;
+    std::vector<size_t> owner;      // Group of each message
+    std::vector<std::array<uint8_t, SHA512_DIGEST_LENGTH>> digests;
+    std::vector<std::array<uint8_t, SHA512_DIGEST_LENGTH>> txnDigests;
+    std::vector<size_t> firstTxn;   // Message of the first member of each group
+};
+
+// Queues one message per lane, the buffer is only read once every message is in
+void queue(Scratch &s, size_t group, uint32_t len) {
+    s.offsets.push_back(s.messages.size() - len);
+    s.n.push_back(len);
+    s.owner.push_back(group);
+}
+
+void hashQueued(Scratch &s) {
+    const size_t count = s.n.size();
+    s.in.resize(count);
+    s.digests.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        s.in[i] = s.messages.data() + s.offsets[i];
+    }
+    SHA512_256_xN(s.in.data(), s.n.data(), count,
+                  reinterpret_cast<uint8_t (*)[SHA512_DIGEST_LENGTH]>(s.digests.data()));
+}
+
+void resetQueue(Scratch &s) {
+    s.messages.clear();
+    s.offsets.clear();
+    s.n.clear();
+    s.owner.clear();
+}
+
+// Same checks as group_build, and queues the txid message of every member
+parser_error_t layoutGroup(Scratch &s, group_batch_t &g, size_t index, group_txn_layout_t *layouts) {
+    if (g.txns == nullptr) {
+        return parser_unexpected_value;
+    }
+    if (g.count == 0 || g.count > GROUP_MAX_TXNS) {
+        return parser_unexpected_number_items;
+    }
+    const size_t queued = s.n.size();
+    const size_t bytes = s.messages.size();
+    for (uint8_t i = 0; i < g.count; i++) {
+        const group_txn_t &txn = g.txns[i];
+        parser_error_t err = txn.data == nullptr ? parser_no_data
+                                                 : group_txnLayout(txn.data, txn.len, &layouts[i]);
+        // Checked up front, so a group is either fully updated or left as it was
+        if (err == parser_ok && group_txnGroupedLen(txn.len, &layouts[i]) > txn.capacity) {
+            err = parser_buffer_too_small;
+        }
+        if (err != parser_ok) {
+            s.messages.resize(bytes);
+            s.offsets.resize(queued);
+            s.n.resize(queued);
+            s.owner.resize(queued);
+            return err;
+        }
+
+        const uint32_t maxLen = 2 + 3 + txn.len;
+        const size_t start = s.messages.size();
+        s.messages.resize(start + maxLen);
+        const uint32_t len = group_txnIdMessage(txn.data, txn.len, &layouts[i], s.messages.data() + start, maxLen);
+        s.messages.resize(start + len);
+        queue(s, index, len);
+    }
+    return parser_ok;
+}
+
+size_t buildRange(group_batch_t *groups, size_t begin, size_t end) {
+    Scratch s;
+    s.layouts.resize(kWindow * GROUP_MAX_TXNS);
+    size_t built = 0;
+
+    for (size_t start = begin; start < end; start += kWindow) {
+        const size_t window = std::min(kWindow, end - start);
+
+        // Member txids of the whole window in one pass
+        resetQueue(s);
+        for (size_t w = 0; w < window; w++) {
+            group_batch_t &g = groups[start + w];
+            g.error = layoutGroup(s, g, w, &s.layouts[w * GROUP_MAX_TXNS]);
+        }
+        hashQueued(s);
+
+        // Members of a group are queued together and in order
+        std::swap(s.digests, s.txnDigests);
+        s.firstTxn.assign(window, 0);
+        for (size_t i = s.owner.size(); i-- > 0;) {
+            s.firstTxn[s.owner[i]] = i;
+        }
+
+        // Then the group IDs
+        resetQueue(s);
+        for (size_t w = 0; w < window; w++) {
+            group_batch_t &g = groups[start + w];
+            if (g.error != parser_ok) {
+                continue;
+            }
+            uint8_t ids[GROUP_MAX_TXNS][GROUP_ID_LEN];
+            for (uint8_t i = 0; i < g.count; i++) {
+                memcpy(ids[i], s.txnDigests[s.firstTxn[w] + i].data(), GROUP_ID_LEN);
+            }
+            if (g.txnIds != nullptr) {
+                memcpy(g.txnIds, ids, sizeof(ids[0]) * g.count);
+            }
+            const size_t offset = s.messages.size();
+            s.messages.resize(offset + GROUP_ID_MESSAGE_MAX);
+            const uint32_t len = group_idMessage(ids, g.count, s.messages.data() + offset, GROUP_ID_MESSAGE_MAX);
+            s.messages.resize(offset + len);
+            queue(s, w, len);
+        }
+        hashQueued(s);
+
+        for (size_t i = 0; i < s.owner.size(); i++) {
+            group_batch_t &g = groups[start + s.owner[i]];
+            memcpy(g.groupId, s.digests[i].data(), GROUP_ID_LEN);
+            const group_txn_layout_t *layouts = &s.layouts[s.owner[i] * GROUP_MAX_TXNS];
+            for (uint8_t t = 0; t < g.count && g.error == parser_ok; t++) {
+                g.error = group_txnSetGroup(&g.txns[t], &layouts[t], g.groupId);
+            }
+            built += g.error == parser_ok ? 1 : 0;
+        }
+    }
+    return built;
+}
+
+}  // namespace
+
+size_t group_build_batch(group_batch_t *groups, size_t numGroups, uint32_t numThreads) {
+    if (groups == nullptr || numGroups == 0) {
+        return 0;
+    }
+
+    size_t numWorkers = numThreads != 0 ? numThreads : std::thread::hardware_concurrency();
+    numWorkers = std::max<size_t>(1, std::min(numWorkers, (numGroups + kWindow - 1) / kWindow));
+
+    // Groups cost about the same, contiguous shares of whole windows are enough
+    const size_t windows = (numGroups + kWindow - 1) / kWindow;
+    std::atomic<size_t> built {0};
+    auto worker = [&](size_t id) {
+        const size_t begin = std::min(numGroups, windows * id / numWorkers * kWindow);
+        const size_t end = std::min(numGroups, windows * (id + 1) / numWorkers * kWindow);
+        built += buildRange(groups, begin, end);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numWorkers - 1);
+    for (size_t id = 1; id < numWorkers; id++) {
+        threads.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto &t : threads) {
+        t.join();
+    }
+    return built;
+}
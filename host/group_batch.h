@@ -0,0 +1,45 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "parser_group_build.h"
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct {
+    group_txn_t *txns;
+    uint8_t count;
+    // Optional, count member IDs as covered by the group ID
+    uint8_t (*txnIds)[GROUP_ID_LEN];
+    uint8_t groupId[GROUP_ID_LEN];
+    // Same error group_build would return, members are left untouched unless parser_ok
+    parser_error_t error;
+} group_batch_t;
+
+/// Builds every group, same output as group_build on each of them.
+/// Member txids and group IDs are hashed several at a time with SHA512_256_xN, lanes
+/// taking members of different groups, and the groups are spread over numThreads workers.
+/// \param numThreads worker count, 0 uses the number of hardware threads
+/// \return number of groups built
+size_t group_build_batch(group_batch_t *groups, size_t numGroups, uint32_t numThreads);
+
+#ifdef __cplusplus
+}
+#endif
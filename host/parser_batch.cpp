@@ -0,0 +1,169 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "parser_batch.h"
+#include "parser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Blobs taken by a worker from its own range in one go
+constexpr size_t kLocalChunk = 64;
+
+// Contiguous range of blob indices owned by one worker. The owner consumes it
+// from the front, idle workers steal the back half.
+struct WorkRange {
+    std::mutex lock;
+    size_t begin {0};
+    size_t end {0};
+};
+
+class WorkStealingPool {
+public:
+    WorkStealingPool(size_t numItems, size_t numWorkers) : ranges(numWorkers) {
+        const size_t share = numItems / numWorkers;
+        const size_t extra = numItems % numWorkers;
+        size_t start = 0;
+        for (size_t i = 0; i < numWorkers; i++) {
+            const size_t len = share + (i < extra ? 1 : 0);
+            ranges[i].begin = start;
+            ranges[i].end = start + len;
+            start += len;
+        }
+    }
+
+    // Returns false once there is no work left anywhere
+    bool next(size_t worker, size_t *begin, size_t *end) {
+        if (takeLocal(worker, begin, end)) {
+            return true;
+        }
+        return steal(worker, begin, end);
+    }
+
+private:
+    bool takeLocal(size_t worker, size_t *begin, size_t *end) {
+        WorkRange &own = ranges[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (own.begin >= own.end) {
+            return false;
+        }
+        *begin = own.begin;
+        *end = std::min(own.end, own.begin + kLocalChunk);
+        own.begin = *end;
+        return true;
+    }
+
+    bool steal(size_t worker, size_t *begin, size_t *end) {
+        const size_t numWorkers = ranges.size();
+        for (size_t i = 1; i < numWorkers; i++) {
+            WorkRange &victim = ranges[(worker + i) % numWorkers];
+            size_t stolenBegin = 0;
+            size_t stolenEnd = 0;
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if (victim.begin >= victim.end) {
+                    continue;
+                }
+                const size_t remaining = victim.end - victim.begin;
+                stolenEnd = victim.end;
+                stolenBegin = victim.end - (remaining + 1) / 2;
+                victim.end = stolenBegin;
+            }
+
+            // Keep what was stolen beyond the first chunk so others can steal it from us
+            WorkRange &own = ranges[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+            *begin = stolenBegin;
+            *end = std::min(stolenEnd, stolenBegin + kLocalChunk);
+            own.begin = *end;
+            own.end = stolenEnd;
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<WorkRange> ranges;
+};
+
+void processBlob(const parser_batch_blob_t &blob, parser_batch_result_t *result) {
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    memset(&tx_obj, 0, sizeof(tx_obj));
+
+    result->numItems = 0;
+    if (blob.data == nullptr || blob.dataLen > UINT16_MAX) {
+        // parser contexts address at most 64KB
+        result->error = parser_value_out_of_range;
+        return;
+    }
+
+    result->error = parser_parse(&ctx, blob.data, blob.dataLen, &tx_obj);
+    if (result->error != parser_ok) {
+        return;
+    }
+
+    result->error = parser_validateStructure(&ctx);
+    if (result->error != parser_ok) {
+        return;
+    }
+
+    result->error = parser_getNumItems(&ctx, &result->numItems);
+}
+
+}  // namespace
+
+parser_error_t parser_parse_batch(const parser_batch_blob_t *blobs,
+                                  size_t numBlobs,
+                                  parser_batch_result_t *results,
+                                  uint32_t numThreads) {
+    if (numBlobs == 0) {
+        return parser_ok;
+    }
+    if (blobs == nullptr || results == nullptr) {
+        return parser_unexpected_value;
+    }
+
+    size_t numWorkers = numThreads != 0 ? numThreads : std::thread::hardware_concurrency();
+    numWorkers = std::max<size_t>(1, std::min(numWorkers, numBlobs));
+
+    WorkStealingPool pool(numBlobs, numWorkers);
+    auto worker = [&](size_t id) {
+        size_t begin = 0;
+        size_t end = 0;
+        while (pool.next(id, &begin, &end)) {
+            for (size_t i = begin; i < end; i++) {
+                processBlob(blobs[i], &results[i]);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numWorkers - 1);
+    for (size_t id = 1; id < numWorkers; id++) {
+        threads.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    return parser_ok;
+}
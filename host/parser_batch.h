@@ -0,0 +1,51 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "parser_common.h"
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct {
+    const uint8_t *data;
+    size_t dataLen;
+} parser_batch_blob_t;
+
+typedef struct {
+    // Error returned by parser_parse or parser_validateStructure, parser_ok if the blob is valid
+    parser_error_t error;
+    // Number of display items of a valid blob, 0 otherwise
+    uint8_t numItems;
+} parser_batch_result_t;
+
+/// Parses and validates every blob, spreading the work over numThreads workers
+/// \param blobs msgpack encoded transactions (without the "TX" prefix)
+/// \param numBlobs number of entries in blobs and results
+/// \param results one entry per blob, written in the same order as blobs
+/// \param numThreads worker count, 0 uses the number of hardware threads
+/// \return parser_ok if the batch was processed, an error if the arguments are invalid
+parser_error_t parser_parse_batch(const parser_batch_blob_t *blobs,
+                                  size_t numBlobs,
+                                  parser_batch_result_t *results,
+                                  uint32_t numThreads);
+
+#ifdef __cplusplus
+}
+#endif
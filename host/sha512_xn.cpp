@@ -0,0 +1,77 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "sha512_xn.h"
+#include "sha512_xn_kernel.h"
+
+namespace {
+
+typedef void (*kernel_fn)(const uint8_t *const *in, const size_t *n, size_t count,
+                          uint8_t (*out)[SHA512_DIGEST_LENGTH]);
+
+struct Kernel {
+    const char *name;
+    size_t lanes;
+    kernel_fn fn;
+};
+
+void scalarKernel(const uint8_t *const *in, const size_t *n, size_t count,
+                  uint8_t (*out)[SHA512_DIGEST_LENGTH]) {
+    for (size_t i = 0; i < count; i++) {
+        SHA512_256(in[i], n[i], out[i]);
+    }
+}
+
+Kernel selectKernel() {
+#if defined(SHA512_XN_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {"avx512", 8, sha512_256_x8_avx512};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", 4, sha512_256_x4_avx2};
+    }
+#endif
+    return {"scalar", 1, scalarKernel};
+}
+
+const Kernel &kernel() {
+    static const Kernel selected = selectKernel();
+    return selected;
+}
+
+}  // namespace
+
+void SHA512_256_xN(const uint8_t *const *in, const size_t *n, size_t count,
+                   uint8_t (*out)[SHA512_DIGEST_LENGTH]) {
+    if (in == nullptr || n == nullptr || out == nullptr) {
+        return;
+    }
+
+    const Kernel &k = kernel();
+    for (size_t i = 0; i < count; i += k.lanes) {
+        const size_t lanes = (count - i < k.lanes) ? count - i : k.lanes;
+        k.fn(in + i, n + i, lanes, out + i);
+    }
+}
+
+const char *SHA512_256_xN_kernel(void) {
+    return kernel().name;
+}
+
+size_t SHA512_256_xN_lanes(void) {
+    return kernel().lanes;
+}
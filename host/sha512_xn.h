@@ -0,0 +1,42 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sha512.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/// Hashes independent messages with SHA512/256, several at once on hosts with AVX2 or AVX-512
+/// \param in messages, in[i] holds n[i] bytes
+/// \param n message lengths
+/// \param count number of messages
+/// \param out one digest per message, laid out as SHA512_256 writes it
+void SHA512_256_xN(const uint8_t *const *in, const size_t *n, size_t count,
+                   uint8_t (*out)[SHA512_DIGEST_LENGTH]);
+
+/// Kernel picked for this CPU: "avx512", "avx2" or "scalar"
+const char *SHA512_256_xN_kernel(void);
+
+/// Messages hashed per kernel pass (8, 4 or 1)
+size_t SHA512_256_xN_lanes(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,56 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Built with -mavx2 on x86 hosts (see CMakeLists.txt), only called after a runtime CPU check
+#if defined(SHA512_XN_X86)
+
+#include "sha512_xn_kernel.h"
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2 {
+    static const size_t kLanes = 4;
+    typedef __m256i type;
+
+    static type load(const uint64_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static void store(uint64_t *p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+    static type set1(uint64_t x) { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+    static type add(type a, type b) { return _mm256_add_epi64(a, b); }
+    static type xor3(type a, type b, type c) { return _mm256_xor_si256(_mm256_xor_si256(a, b), c); }
+
+    template<int N>
+    static type shr(type a) { return _mm256_srli_epi64(a, N); }
+
+    // No 64-bit rotate before AVX-512
+    template<int N>
+    static type rotr(type a) { return _mm256_or_si256(_mm256_srli_epi64(a, N), _mm256_slli_epi64(a, 64 - N)); }
+
+    static type ch(type e, type f, type g) { return _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)); }
+    static type maj(type a, type b, type c) {
+        return _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    }
+    static type blend(type mask, type a, type b) { return _mm256_blendv_epi8(b, a, mask); }
+};
+
+}  // namespace
+
+void sha512_256_x4_avx2(const uint8_t *const *in, const size_t *n, size_t count,
+                        uint8_t (*out)[SHA512_DIGEST_LENGTH]) {
+    sha512xn::hashLanes<Avx2>(in, n, count, out);
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Built with -mavx512f on x86 hosts (see CMakeLists.txt), only called after a runtime CPU check
+#if defined(SHA512_XN_X86)
+
+#include "sha512_xn_kernel.h"
+#include <immintrin.h>
+
+namespace {
+
+struct Avx512 {
+    static const size_t kLanes = 8;
+    typedef __m512i type;
+
+    static type load(const uint64_t *p) { return _mm512_loadu_si512(p); }
+    static void store(uint64_t *p, type v) { _mm512_storeu_si512(p, v); }
+    static type set1(uint64_t x) { return _mm512_set1_epi64(static_cast<long long>(x)); }
+    static type add(type a, type b) { return _mm512_add_epi64(a, b); }
+    static type xor3(type a, type b, type c) { return _mm512_ternarylogic_epi64(a, b, c, 0x96); }
+
+    template<int N>
+    static type shr(type a) { return _mm512_srli_epi64(a, N); }
+
+    template<int N>
+    static type rotr(type a) { return _mm512_ror_epi64(a, N); }
+
+    static type ch(type e, type f, type g) { return _mm512_ternarylogic_epi64(e, f, g, 0xCA); }
+    static type maj(type a, type b, type c) { return _mm512_ternarylogic_epi64(a, b, c, 0xE8); }
+    // mask ? a : b, bit by bit
+    static type blend(type mask, type a, type b) { return _mm512_ternarylogic_epi64(mask, a, b, 0xCA); }
+};
+
+}  // namespace
+
+void sha512_256_x8_avx512(const uint8_t *const *in, const size_t *n, size_t count,
+                          uint8_t (*out)[SHA512_DIGEST_LENGTH]) {
+    sha512xn::hashLanes<Avx512>(in, n, count, out);
+}
+
+#endif
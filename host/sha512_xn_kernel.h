@@ -0,0 +1,187 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+// Multi-buffer SHA512/256: lane i of every vector belongs to message i.
+// Only included by the per-ISA translation units, which are built with the matching -m flags.
+
+#include "sha512.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Each kernel hashes up to its lane count of messages per call
+void sha512_256_x4_avx2(const uint8_t *const *in, const size_t *n, size_t count,
+                        uint8_t (*out)[SHA512_DIGEST_LENGTH]);
+void sha512_256_x8_avx512(const uint8_t *const *in, const size_t *n, size_t count,
+                          uint8_t (*out)[SHA512_DIGEST_LENGTH]);
+
+namespace sha512xn {
+
+// Same constants as deps/sha512/sha512.c, which keeps them private
+const uint64_t kIV[8] = {
+        0x22312194fc2bf72cULL, 0x9f555fa3c84c64c2ULL, 0x2393b86b6f53b151ULL, 0x963877195940eabdULL,
+        0x96283ee2a88effe3ULL, 0xbe5e1e2553863992ULL, 0x2b0199fc2c85b8aaULL, 0x0eb72ddc81c52ca2ULL};
+
+const uint64_t kK[80] = {
+        0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL, 0xE9B5DBA58189DBBCULL,
+        0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL, 0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL,
+        0xD807AA98A3030242ULL, 0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+        0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL, 0xC19BF174CF692694ULL,
+        0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL, 0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL,
+        0x2DE92C6F592B0275ULL, 0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+        0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL, 0xBF597FC7BEEF0EE4ULL,
+        0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL, 0x06CA6351E003826FULL, 0x142929670A0E6E70ULL,
+        0x27B70A8546D22FFCULL, 0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+        0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL, 0x92722C851482353BULL,
+        0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL, 0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL,
+        0xD192E819D6EF5218ULL, 0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+        0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL, 0x34B0BCB5E19B48A8ULL,
+        0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL, 0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL,
+        0x748F82EE5DEFB2FCULL, 0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+        0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL, 0xC67178F2E372532BULL,
+        0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL, 0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL,
+        0x06F067AA72176FBAULL, 0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+        0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL, 0x431D67C49C100D4CULL,
+        0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL, 0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL};
+
+inline uint64_t loadBE64(const uint8_t *p) {
+    return ((uint64_t) p[0] << 56) | ((uint64_t) p[1] << 48) | ((uint64_t) p[2] << 40) | ((uint64_t) p[3] << 32) |
+           ((uint64_t) p[4] << 24) | ((uint64_t) p[5] << 16) | ((uint64_t) p[6] << 8) | ((uint64_t) p[7]);
+}
+
+inline void storeBE64(uint8_t *p, uint64_t v) {
+    for (int i = 7; i >= 0; i--) {
+        p[i] = (uint8_t) v;
+        v >>= 8;
+    }
+}
+
+// Gives the 128-byte blocks of one padded message without copying the body
+class PaddedMessage {
+public:
+    void init(const uint8_t *data, size_t len) {
+        this->data = data;
+        fullBlocks = len / 128;
+        const size_t rest = len % 128;
+        // 0x80 and the 16-byte bit length need 17 bytes after the data
+        const size_t tailBlocks = (rest + 17 <= 128) ? 1 : 2;
+        numBlocks = fullBlocks + tailBlocks;
+
+        memset(tail, 0, sizeof(tail));
+        if (rest > 0) {
+            memcpy(tail, data + fullBlocks * 128, rest);
+        }
+        tail[rest] = 0x80;
+        uint8_t *lenField = tail + tailBlocks * 128 - 16;
+        storeBE64(lenField, (uint64_t) (len >> 61));
+        storeBE64(lenField + 8, (uint64_t) len << 3);
+    }
+
+    const uint8_t *block(size_t idx) const {
+        return (idx < fullBlocks) ? data + idx * 128 : tail + (idx - fullBlocks) * 128;
+    }
+
+    size_t numBlocks {0};
+
+private:
+    const uint8_t *data {nullptr};
+    size_t fullBlocks {0};
+    uint8_t tail[256] {};
+};
+
+// V provides the lane count, the vector type and 64-bit lane operations
+template<class V>
+void hashLanes(const uint8_t *const *in, const size_t *n, size_t count, uint8_t (*out)[SHA512_DIGEST_LENGTH]) {
+    typedef typename V::type vec;
+    const size_t L = V::kLanes;
+
+    PaddedMessage msg[V::kLanes];
+    size_t maxBlocks = 0;
+    for (size_t l = 0; l < count; l++) {
+        msg[l].init(in[l], n[l]);
+        if (msg[l].numBlocks > maxBlocks) {
+            maxBlocks = msg[l].numBlocks;
+        }
+    }
+
+    vec state[8];
+    for (int i = 0; i < 8; i++) {
+        state[i] = V::set1(kIV[i]);
+    }
+
+    static const uint8_t kZeroBlock[128] = {0};
+    alignas(64) uint64_t words[16][V::kLanes];
+    alignas(64) uint64_t active[V::kLanes];
+
+    for (size_t b = 0; b < maxBlocks; b++) {
+        // Lanes whose message is already done (or unused) run on zeros and keep their state
+        for (size_t l = 0; l < L; l++) {
+            const bool live = l < count && b < msg[l].numBlocks;
+            const uint8_t *block = live ? msg[l].block(b) : kZeroBlock;
+            active[l] = live ? ~0ULL : 0;
+            for (int t = 0; t < 16; t++) {
+                words[t][l] = loadBE64(block + 8 * t);
+            }
+        }
+
+        vec W[80];
+        for (int t = 0; t < 16; t++) {
+            W[t] = V::load(words[t]);
+        }
+        for (int t = 16; t < 80; t++) {
+            const vec s0 = V::xor3(V::template rotr<1>(W[t - 15]), V::template rotr<8>(W[t - 15]),
+                                   V::template shr<7>(W[t - 15]));
+            const vec s1 = V::xor3(V::template rotr<19>(W[t - 2]), V::template rotr<61>(W[t - 2]),
+                                   V::template shr<6>(W[t - 2]));
+            W[t] = V::add(V::add(s1, W[t - 7]), V::add(s0, W[t - 16]));
+        }
+
+        vec a = state[0], b_ = state[1], c = state[2], d = state[3];
+        vec e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int t = 0; t < 80; t++) {
+            const vec S1 = V::xor3(V::template rotr<14>(e), V::template rotr<18>(e), V::template rotr<41>(e));
+            const vec t1 = V::add(V::add(h, S1), V::add(V::ch(e, f, g), V::add(V::set1(kK[t]), W[t])));
+            const vec S0 = V::xor3(V::template rotr<28>(a), V::template rotr<34>(a), V::template rotr<39>(a));
+            const vec t2 = V::add(S0, V::maj(a, b_, c));
+            h = g;
+            g = f;
+            f = e;
+            e = V::add(d, t1);
+            d = c;
+            c = b_;
+            b_ = a;
+            a = V::add(t1, t2);
+        }
+
+        const vec mask = V::load(active);
+        const vec working[8] = {a, b_, c, d, e, f, g, h};
+        for (int i = 0; i < 8; i++) {
+            const vec next = V::add(state[i], working[i]);
+            state[i] = V::blend(mask, next, state[i]);
+        }
+    }
+
+    alignas(64) uint64_t lanes[V::kLanes];
+    for (int i = 0; i < 8; i++) {
+        V::store(lanes, state[i]);
+        for (size_t l = 0; l < count; l++) {
+            storeBE64(out[l] + 8 * i, lanes[l]);
+        }
+    }
+}
+
+}  // namespace sha512xn
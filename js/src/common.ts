@@ -36,6 +36,7 @@ export const P2_VALUES = {
   DEFAULT: 0x00,
   MSGPACK_ADD: 0x80,
   MSGPACK_LAST: 0x00,
+  MSGPACK_LAST_WITH_TXID: 0x01,
 };
 
 // noinspection JSUnusedGlobalSymbols
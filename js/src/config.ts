@@ -21,3 +21,4 @@ export const INS = {
   SIGN_MSGPACK: 0x08,
 };
 export const PKLEN = 32;
+export const SIGNATURE_LEN = 64;
@@ -26,7 +26,7 @@ import {
   P2_VALUES,
   processErrorResponse,
 } from "./common";
-import {CLA, INS, PKLEN} from "./config";
+import {CLA, INS, PKLEN, SIGNATURE_LEN} from "./config";
 
 export {LedgerError};
 export * from "./types";
@@ -225,7 +225,7 @@ export default class AlgorandApp {
       .then(processGetAddrResponse, processErrorResponse);
   }
 
-  async signSendChunk(chunkIdx: number, chunkNum: number, accountId: number, chunk: Buffer): Promise<ResponseSign> {
+  async signSendChunk(chunkIdx: number, chunkNum: number, accountId: number, chunk: Buffer, withTxid = false): Promise<ResponseSign> {
     let p1 = P1_VALUES.MSGPACK_ADD
     let p2 = P2_VALUES.MSGPACK_ADD
 
@@ -233,7 +233,7 @@ export default class AlgorandApp {
       p1 = (accountId !== 0) ? P1_VALUES.MSGPACK_FIRST_ACCOUNT_ID : P1_VALUES.MSGPACK_FIRST
     }
     if (chunkIdx === chunkNum) {
-      p2 = P2_VALUES.MSGPACK_LAST
+      p2 = withTxid ? P2_VALUES.MSGPACK_LAST_WITH_TXID : P2_VALUES.MSGPACK_LAST
     }
 
     return this.transport
@@ -257,9 +257,12 @@ export default class AlgorandApp {
         }
 
         if (returnCode === LedgerError.NoErrors && response.length > 2) {
-          const signature = response.slice(0, response.length - 2);
+          const signature = response.slice(0, SIGNATURE_LEN);
+          // Only returned when requested with the last chunk
+          const txid = withTxid ? response.slice(SIGNATURE_LEN, response.length - 2) : undefined;
           return {
             signature,
+            txid,
             returnCode: returnCode,
             errorMessage: errorMessage,
             // legacy
@@ -279,12 +282,12 @@ export default class AlgorandApp {
       }, processErrorResponse);
   }
 
-  async sign(accountId = 0, message: string | Buffer) {
+  async sign(accountId = 0, message: string | Buffer, withTxid = false) {
     return this.signGetChunks(accountId, message).then(chunks => {
-      return this.signSendChunk(1, chunks.length, accountId, chunks[0]).then(async result => {
+      return this.signSendChunk(1, chunks.length, accountId, chunks[0], withTxid).then(async result => {
         for (let i = 1; i < chunks.length; i += 1) {
           // eslint-disable-next-line no-await-in-loop,no-param-reassign
-          result = await this.signSendChunk(1 + i, chunks.length, accountId, chunks[i])
+          result = await this.signSendChunk(1 + i, chunks.length, accountId, chunks[i], withTxid)
           if (result.return_code !== ERROR_CODE.NoError) {
             break
           }
@@ -294,6 +297,7 @@ export default class AlgorandApp {
           return_code: result.return_code,
           error_message: result.error_message,
           signature: result.signature,
+          txid: result.txid,
         }
       }, processErrorResponse)
     })
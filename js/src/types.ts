@@ -52,4 +52,5 @@ export interface ResponseDeviceInfo extends ResponseBase {
 
 export interface ResponseSign extends ResponseBase {
   signature: Buffer
+  txid?: Buffer
 }
@@ -0,0 +1,73 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+
+#include "gmock/gmock.h"
+
+#include <cstdint>
+#include <cstring>
+#include "algo_asa.h"
+#include "algo_asa_table.h"
+
+TEST(AlgoAsa, KnownAssets) {
+    algo_asset_t usdc {};
+    ASSERT_TRUE(algo_asa_get(31566704, &usdc));
+    EXPECT_STREQ(usdc.name, "USDC");
+    EXPECT_STREQ(usdc.unit, "USDC ");
+    EXPECT_EQ(usdc.decimals, 6);
+
+    algo_asset_t opul {};
+    ASSERT_TRUE(algo_asa_get(287867876, &opul));
+    EXPECT_STREQ(opul.name, "Opulous");
+    EXPECT_STREQ(opul.unit, "OPUL ");
+    EXPECT_EQ(opul.decimals, 10);
+}
+
+TEST(AlgoAsa, EveryEntryIsFound) {
+    for (uint16_t i = 0; i < ALGO_ASA_COUNT; i++) {
+        if (i > 0) {
+            ASSERT_LT(algoAsaIds[i - 1], algoAsaIds[i]);
+        }
+        // The table is static, so this file holds its own copy of it
+        const algo_asset_info_t &info = algoAsaEntries[i];
+        ASSERT_LT(info.name, ALGO_ASA_STRINGS_LEN);
+        ASSERT_LT(info.unit, ALGO_ASA_STRINGS_LEN);
+
+        algo_asset_t asa {};
+        ASSERT_TRUE(algo_asa_get(algoAsaIds[i], &asa));
+        EXPECT_STREQ(asa.name, algoAsaStrings + info.name);
+        EXPECT_STREQ(asa.unit, algoAsaStrings + info.unit);
+        EXPECT_EQ(asa.decimals, info.decimals);
+        EXPECT_GT(strlen(asa.name), 0u);
+        const size_t unitLen = strlen(asa.unit);
+        ASSERT_GT(unitLen, 1u);
+        EXPECT_EQ(asa.unit[unitLen - 1], ' ');
+    }
+}
+
+TEST(AlgoAsa, UnknownAssets) {
+    algo_asset_t asa {};
+    EXPECT_FALSE(algo_asa_get(0, &asa));
+    EXPECT_FALSE(algo_asa_get(UINT64_MAX, &asa));
+    for (uint16_t i = 0; i < ALGO_ASA_COUNT; i++) {
+        // Neighbours of listed ids, unless they are listed too
+        for (const uint64_t id : {algoAsaIds[i] - 1, algoAsaIds[i] + 1}) {
+            const bool listed = (i > 0 && algoAsaIds[i - 1] == id) ||
+                                (i + 1 < ALGO_ASA_COUNT && algoAsaIds[i + 1] == id);
+            EXPECT_EQ(algo_asa_get(id, &asa), listed) << id;
+        }
+    }
+}
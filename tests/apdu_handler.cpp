@@ -0,0 +1,260 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "apdu_harness.h"
+#include "coin.h"
+#include "cx_standin.h"
+#include "parser.h"
+#include "sdk_standin.h"
+#include "utils/common.h"
+
+using namespace std;
+
+namespace {
+
+// Transaction ID of kGroupUngrouped[0], the payment signed below
+const char *kPaymentTxnId = "581655317aefe706165f675b6ee3cbe263ac43498d38e1c6da005c587d820660";
+
+vector<uint8_t> command(uint8_t ins, uint8_t p1, uint8_t p2, const vector<uint8_t> &data = {}) {
+    vector<uint8_t> apdu = {CLA, ins, p1, p2, static_cast<uint8_t>(data.size())};
+    apdu.insert(apdu.end(), data.begin(), data.end());
+    return apdu;
+}
+
+class ApduHandler : public ::testing::Test {
+protected:
+    ApduHarness harness;
+};
+
+}  // namespace
+
+TEST_F(ApduHandler, GetVersion) {
+    const ApduReply reply = harness.exchange(command(INS_GET_VERSION, 0, 0));
+    EXPECT_EQ(reply.sw, 0x9000);
+    ASSERT_EQ(reply.data.size(), 12u);
+    EXPECT_EQ(reply.data[7], 0);  // UX allowed
+}
+
+TEST_F(ApduHandler, RejectsMalformedCommands) {
+    vector<uint8_t> wrongCla = command(INS_GET_VERSION, 0, 0);
+    wrongCla[0] = 0xE0;
+    EXPECT_EQ(harness.exchange(wrongCla).sw, 0x6E00);
+    EXPECT_EQ(harness.exchange(command(0x7F, 0, 0)).sw, 0x6D00);
+    EXPECT_EQ(harness.exchange({CLA, INS_GET_VERSION, 0, 0}).sw, 0x6700);
+    EXPECT_EQ(harness.exchange({}).sw, 0x6982);
+}
+
+TEST_F(ApduHandler, SignsPaymentInChunks) {
+    const ApduReply uploaded = harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0]), 100);
+    ASSERT_TRUE(uploaded.review);
+    ASSERT_TRUE(harness.reviewPending());
+
+    const ApduReply signature = harness.approve();
+    EXPECT_FALSE(harness.reviewPending());
+    EXPECT_EQ(signature.sw, 0x9000);
+    EXPECT_EQ(signature.data.size(), ED25519_SIGNATURE_SIZE);
+    EXPECT_FALSE(harness.screens().empty());
+
+    // Same account and message, same signature
+    harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0]));
+    EXPECT_EQ(harness.approve().data, signature.data);
+}
+
+TEST_F(ApduHandler, TransactionIdOnRequest) {
+    ASSERT_TRUE(harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0])).review);
+    const ApduReply signature = harness.approve();
+    ASSERT_EQ(signature.data.size(), ED25519_SIGNATURE_SIZE);
+
+    // Asked for with the last chunk, the ID follows the same signature
+    ASSERT_TRUE(harness.exchange(command(INS_SIGN_MSGPACK, P1_FIRST, P2_LAST_WITH_TXID, fromHex(kGroupUngrouped[0]))).review);
+    const ApduReply withTxid = harness.approve();
+    EXPECT_EQ(withTxid.sw, 0x9000);
+    ASSERT_EQ(withTxid.data.size(), ED25519_SIGNATURE_SIZE + TXID_LEN);
+    EXPECT_EQ(vector<uint8_t>(withTxid.data.begin(), withTxid.data.begin() + ED25519_SIGNATURE_SIZE), signature.data);
+    EXPECT_EQ(vector<uint8_t>(withTxid.data.begin() + ED25519_SIGNATURE_SIZE, withTxid.data.end()),
+              fromHex(kPaymentTxnId));
+
+    // The request holds for that transaction only
+    harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0]));
+    EXPECT_EQ(harness.approve().data, signature.data);
+}
+
+TEST_F(ApduHandler, RejectedReviewIsNotSigned) {
+    ASSERT_TRUE(harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0])).review);
+    const ApduReply reply = harness.reject();
+    EXPECT_EQ(reply.sw, 0x6986);
+    EXPECT_TRUE(reply.data.empty());
+    EXPECT_EQ(harness.histograms().count({INS_SIGN_MSGPACK, ApduPhase::Sign}), 0u);
+}
+
+TEST_F(ApduHandler, LockedDeviceRefusesToSign) {
+    sdk_standin_set_pin_validated(false);
+    const ApduReply reply = harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0]));
+    EXPECT_EQ(reply.sw, 0x6986);
+    EXPECT_FALSE(harness.reviewPending());
+    EXPECT_EQ(harness.exchange(command(INS_GET_VERSION, 0, 0)).sw, 0x9000);
+}
+
+TEST_F(ApduHandler, MalformedChunkIsAnsweredAtOnce) {
+    // Reserved msgpack type in the first chunk of a longer upload
+    const vector<uint8_t> first = {0x00, 0x00, 0x00, 0x00, 0xc1, 0x01, 0x02};
+    const ApduReply reply = harness.exchange(command(INS_SIGN_MSGPACK, P1_FIRST_ACCOUNT_ID, P2_MORE, first));
+    EXPECT_EQ(reply.sw, 0x6984);
+    EXPECT_FALSE(reply.data.empty());
+
+    // The sequence has to start over
+    const ApduReply next = harness.exchange(command(INS_SIGN_MSGPACK, P1_MORE, P2_LAST, {0x01}));
+    EXPECT_EQ(next.sw, 0x6987);
+}
+
+TEST_F(ApduHandler, AddressRangeMatchesSingleRequests) {
+    const ApduReply range = harness.exchange(command(INS_GET_ADDRESS_RANGE, 0, 0, {0, 0, 0, 3, 20}));
+    EXPECT_EQ(range.sw, 0x9000);
+    ASSERT_EQ(range.data.size(), 8 * PK_LEN_25519);
+
+    for (uint8_t i = 0; i < 8; i++) {
+        const ApduReply single = harness.exchange(command(INS_GET_PUBLIC_KEY, 0, 0, {0, 0, 0, static_cast<uint8_t>(3 + i)}));
+        ASSERT_EQ(single.sw, 0x9000);
+        ASSERT_EQ(single.data.size(), PK_LEN_25519);
+        EXPECT_EQ(vector<uint8_t>(range.data.begin() + i * PK_LEN_25519, range.data.begin() + (i + 1) * PK_LEN_25519),
+                  single.data) << int(i);
+    }
+
+    EXPECT_EQ(harness.exchange(command(INS_GET_ADDRESS_RANGE, 0, 0, {0, 0, 0, 3, 0})).sw, 0x6984);
+    EXPECT_EQ(harness.exchange(command(INS_GET_ADDRESS_RANGE, 0, 0, {0x7F, 0xFF, 0xFF, 0xFF, 2})).sw, 0x6984);
+    EXPECT_EQ(harness.exchange(command(INS_GET_ADDRESS_RANGE, 0, 0, {0, 0, 0, 3})).sw, 0x6700);
+}
+
+TEST_F(ApduHandler, AddressRangeKeepsTheSigningAccount) {
+    ASSERT_TRUE(harness.upload(INS_SIGN_MSGPACK, 2, fromHex(kGroupUngrouped[0])).review);
+    const ApduReply expected = harness.approve();
+    ASSERT_EQ(expected.sw, 0x9000);
+
+    // Range starting at the same account, then a signature without account ID
+    ASSERT_EQ(harness.exchange(command(INS_GET_ADDRESS_RANGE, 0, 0, {0, 0, 0, 2, 5})).sw, 0x9000);
+    ASSERT_TRUE(harness.exchange(command(INS_SIGN_MSGPACK, P1_FIRST, P2_LAST, fromHex(kGroupUngrouped[0]))).review);
+    const ApduReply signature = harness.approve();
+    EXPECT_EQ(signature.sw, 0x9000);
+    EXPECT_EQ(signature.data, expected.data);
+}
+
+TEST_F(ApduHandler, ReplaysRecordedSequence) {
+    std::ifstream script(string(TESTVECTORS_DIR) + "apdu_sequences/payment_and_group.apdu");
+    ASSERT_TRUE(script.is_open());
+
+    vector<ApduReply> replies;
+    string error;
+    ASSERT_TRUE(harness.replay(script, &replies, &error)) << error;
+    ASSERT_EQ(replies.size(), 12u);
+    for (size_t i = 0; i < replies.size(); i++) {
+        EXPECT_TRUE(replies[i].review || replies[i].sw == 0x9000) << i;
+    }
+
+    // Group approval replies with its ID, then each signature comes with the member's ID
+    EXPECT_EQ(replies[9].data.size(), 32u);
+    EXPECT_EQ(replies[10].data.size(), ED25519_SIGNATURE_SIZE + TXID_LEN);
+    EXPECT_EQ(replies[11].data.size(), ED25519_SIGNATURE_SIZE + TXID_LEN);
+
+    const auto &histograms = harness.histograms();
+    EXPECT_EQ(histograms.at({INS_SIGN_MSGPACK, ApduPhase::Parse}).count(), 2u);
+    EXPECT_EQ(histograms.at({INS_SIGN_MSGPACK, ApduPhase::Validate}).count(), 1u);
+    EXPECT_EQ(histograms.at({INS_SIGN_MSGPACK, ApduPhase::Sign}).count(), 1u);
+    EXPECT_EQ(histograms.at({INS_SIGN_GROUP, ApduPhase::Parse}).count(), 3u);
+    EXPECT_EQ(histograms.at({INS_SIGN_GROUP, ApduPhase::Sign}).count(), 3u);
+    EXPECT_EQ(histograms.at({INS_GET_ADDRESS_RANGE, ApduPhase::Parse}).count(), 1u);
+
+    std::ostringstream report;
+    harness.report(report);
+    EXPECT_THAT(report.str(), ::testing::HasSubstr("0x09  sign"));
+}
+
+TEST_F(ApduHandler, KeyIsKeptOnlyForTheGroupSignatures) {
+    std::ifstream script(string(TESTVECTORS_DIR) + "apdu_sequences/payment_and_group.apdu");
+    vector<ApduReply> replies;
+    string error;
+    ASSERT_TRUE(harness.replay(script, &replies, &error)) << error;
+    ASSERT_EQ(replies.size(), 12u);
+
+    // Members signed after the approval share one derivation
+    const vector<uint8_t> memberSignature = command(INS_SIGN_GROUP, P1_GROUP_SIGNATURE, 0);
+    const uint32_t derived = cx_standin_count(CX_STANDIN_DERIVE);
+    EXPECT_EQ(harness.exchange(memberSignature).data, replies[10].data);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), derived);
+
+    // Any other command ends the session, the group can still be signed
+    EXPECT_EQ(harness.exchange(command(INS_GET_VERSION, 0, 0)).sw, 0x9000);
+    EXPECT_EQ(harness.exchange(memberSignature).data, replies[10].data);
+    EXPECT_EQ(harness.exchange(memberSignature).data, replies[10].data);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), derived + 2);
+
+    // Single transactions derive for their signature only
+    harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0]));
+    harness.approve();
+    harness.upload(INS_SIGN_MSGPACK, 0, fromHex(kGroupUngrouped[0]));
+    harness.approve();
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), derived + 4);
+}
+
+TEST_F(ApduHandler, GroupSignatureKeepsTheSigningAccount) {
+    std::ifstream script(string(TESTVECTORS_DIR) + "apdu_sequences/payment_and_group.apdu");
+    vector<ApduReply> replies;
+    string error;
+    ASSERT_TRUE(harness.replay(script, &replies, &error)) << error;
+    ASSERT_EQ(replies.size(), 12u);
+
+    // Address of another account between the group approval and a member signature
+    ASSERT_EQ(harness.exchange(command(INS_GET_ADDRESS, 0, 0, {0, 0, 0, 5})).sw, 0x9000);
+    EXPECT_EQ(harness.exchange(command(INS_SIGN_GROUP, P1_GROUP_SIGNATURE, 0)).data, replies[10].data);
+
+    // A signature without account ID still uses the account of INS_GET_ADDRESS
+    ASSERT_TRUE(harness.exchange(command(INS_SIGN_MSGPACK, P1_FIRST, P2_LAST, fromHex(kGroupUngrouped[0]))).review);
+    const ApduReply signature = harness.approve();
+    EXPECT_EQ(signature.sw, 0x9000);
+
+    ASSERT_TRUE(harness.upload(INS_SIGN_MSGPACK, 5, fromHex(kGroupUngrouped[0])).review);
+    EXPECT_EQ(harness.approve().data, signature.data);
+}
+
+TEST_F(ApduHandler, ReplayStopsAtMalformedLines) {
+    std::istringstream script("8000000000\napprove\n");
+    string error;
+    EXPECT_FALSE(harness.replay(script, nullptr, &error));
+    EXPECT_EQ(error, "line 2: no review to approve");
+
+    std::istringstream garbage("800000000\n");
+    EXPECT_FALSE(harness.replay(garbage, nullptr, &error));
+    EXPECT_EQ(error, "line 1: expected a command in hex, approve or reject");
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram h;
+    for (uint64_t ns = 1; ns <= 1000; ns++) {
+        h.add(ns);
+    }
+    EXPECT_EQ(h.count(), 1000u);
+    EXPECT_EQ(h.min(), 1u);
+    EXPECT_EQ(h.max(), 1000u);
+    EXPECT_EQ(h.mean(), 500u);
+    // 500 falls in [256, 512), 990 in [512, 1024) capped by the largest sample
+    EXPECT_EQ(h.percentile(50), 511u);
+    EXPECT_EQ(h.percentile(99), 1000u);
+}
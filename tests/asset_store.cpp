@@ -0,0 +1,196 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "asset_store.h"
+#include "parser.h"
+#include "parser_impl.h"
+
+namespace {
+
+std::string storePath(const char *name) {
+    return "/tmp/asset_store_" + std::to_string(getpid()) + "_" + name;
+}
+
+std::vector<uint8_t> readFile(const std::string &path) {
+    std::vector<uint8_t> data;
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        return data;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(f);
+    return data;
+}
+
+void writeFile(const std::string &path, const std::vector<uint8_t> &data) {
+    FILE *f = fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    ASSERT_EQ(fwrite(data.data(), 1, data.size(), f), data.size());
+    fclose(f);
+}
+
+const asset_store_entry_t kEntries[] = {
+    {31566704, "USDC", "USDC", 6},
+    {1234, "Test Asset", "TST", 2},
+    {UINT64_MAX, "Last", "LST", 19},
+    {0, "Zero", "ZRO", 0},
+    {5, "Same Unit", "TST", 4},
+};
+
+}  // namespace
+
+TEST(AssetStore, WriteAndFind) {
+    const std::string path = storePath("find");
+    ASSERT_TRUE(asset_store_write(path.c_str(), kEntries, sizeof(kEntries) / sizeof(kEntries[0])));
+
+    asset_store_t *store = asset_store_open(path.c_str());
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(asset_store_count(store), 5u);
+
+    for (const asset_store_entry_t &e : kEntries) {
+        algo_asset_t asa {};
+        ASSERT_TRUE(asset_store_get(store, e.id, &asa)) << e.id;
+        EXPECT_STREQ(asa.name, e.name);
+        EXPECT_EQ(std::string(asa.unit), std::string(e.unit) + " ");
+        EXPECT_EQ(asa.decimals, e.decimals);
+    }
+
+    // Shared units are stored once
+    algo_asset_t a {}, b {};
+    ASSERT_TRUE(asset_store_get(store, 1234, &a));
+    ASSERT_TRUE(asset_store_get(store, 5, &b));
+    EXPECT_EQ(a.unit, b.unit);
+
+    algo_asset_t asa {};
+    for (const uint64_t id : std::vector<uint64_t> {1, 4, 6, 1233, 1235, 31566705, UINT64_MAX - 1}) {
+        EXPECT_FALSE(asset_store_get(store, id, &asa)) << id;
+    }
+
+    asset_store_close(store);
+    remove(path.c_str());
+}
+
+TEST(AssetStore, RejectsInvalidInput) {
+    const std::string path = storePath("invalid");
+    const asset_store_entry_t duplicate[] = {{7, "A", "A", 0}, {7, "B", "B", 0}};
+    EXPECT_FALSE(asset_store_write(path.c_str(), duplicate, 2));
+    const asset_store_entry_t emptyName[] = {{7, "", "A", 0}};
+    EXPECT_FALSE(asset_store_write(path.c_str(), emptyName, 1));
+    const asset_store_entry_t noUnit[] = {{7, "A", nullptr, 0}};
+    EXPECT_FALSE(asset_store_write(path.c_str(), noUnit, 1));
+
+    ASSERT_TRUE(asset_store_write(path.c_str(), nullptr, 0));
+    asset_store_t *store = asset_store_open(path.c_str());
+    ASSERT_NE(store, nullptr);
+    algo_asset_t asa {};
+    EXPECT_FALSE(asset_store_get(store, 0, &asa));
+    asset_store_close(store);
+    remove(path.c_str());
+
+    EXPECT_EQ(asset_store_open(storePath("missing").c_str()), nullptr);
+}
+
+TEST(AssetStore, RejectsCorruptFiles) {
+    const std::string path = storePath("corrupt");
+    ASSERT_TRUE(asset_store_write(path.c_str(), kEntries, sizeof(kEntries) / sizeof(kEntries[0])));
+    const std::vector<uint8_t> good = readFile(path);
+    ASSERT_GT(good.size(), sizeof(asset_store_header_t));
+
+    const auto corrupt = [&](void (*mutate)(std::vector<uint8_t> &)) {
+        std::vector<uint8_t> data = good;
+        mutate(data);
+        writeFile(path, data);
+        asset_store_t *store = asset_store_open(path.c_str());
+        asset_store_close(store);
+        return store == nullptr;
+    };
+
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) { d[0] ^= 1; }));
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) { d.resize(sizeof(asset_store_header_t) - 1); }));
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) { d.pop_back(); }));
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) { d.back() = 'x'; }));
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) {
+        reinterpret_cast<asset_store_header_t *>(d.data())->version++;
+    }));
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) {
+        reinterpret_cast<asset_store_header_t *>(d.data())->recordSize = 16;
+    }));
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) {
+        reinterpret_cast<asset_store_header_t *>(d.data())->count = UINT64_MAX / 8;
+    }));
+    EXPECT_TRUE(corrupt([](std::vector<uint8_t> &d) {
+        reinterpret_cast<asset_store_header_t *>(d.data())->heapOffset = UINT64_MAX - 4;
+    }));
+    EXPECT_FALSE(corrupt([](std::vector<uint8_t> &) {}));
+
+    // A record pointing past the heap is not returned
+    std::vector<uint8_t> data = good;
+    reinterpret_cast<asset_store_record_t *>(data.data() + sizeof(asset_store_header_t))->name = 0xFFFFFFFF;
+    writeFile(path, data);
+    asset_store_t *store = asset_store_open(path.c_str());
+    ASSERT_NE(store, nullptr);
+    algo_asset_t asa {};
+    EXPECT_FALSE(asset_store_get(store, 0, &asa));
+    EXPECT_TRUE(asset_store_get(store, 5, &asa));
+    asset_store_close(store);
+    remove(path.c_str());
+}
+
+TEST(AssetStore, ResolvesWhileParsing) {
+    const std::string path = storePath("parse");
+    ASSERT_TRUE(asset_store_write(path.c_str(), kEntries, sizeof(kEntries) / sizeof(kEntries[0])));
+    asset_store_t *store = asset_store_open(path.c_str());
+    ASSERT_NE(store, nullptr);
+
+    // Transfer of asset 1234, not in the built-in table
+    uint8_t buffer[] = {137,164,97,97,109,116,10,164,97,114,99,118,196,32,86,149,120,43,210,87,218,245,240,34,71,114,243,188,72,116,212,242,145,254,132,88,187,108,72,154,171,40,86,45,162,57,163,102,101,101,205,9,16,162,102,118,205,3,232,162,103,104,196,32,72,99,181,24,164,179,200,78,200,16,242,45,79,16,129,203,15,113,240,89,167,172,32,222,198,47,127,112,229,9,58,34,162,108,118,205,7,208,163,115,110,100,196,32,86,149,120,43,210,87,218,245,240,34,71,114,243,188,72,116,212,242,145,254,132,88,187,108,72,154,171,40,86,45,162,57,164,116,121,112,101,165,97,120,102,101,114,164,120,97,105,100,205,4,210};
+    parser_context_t ctx;
+    parser_tx_t tx;
+
+    parser_init(&ctx, buffer, sizeof(buffer));
+    ASSERT_EQ(_read(&ctx, &tx), parser_ok);
+    EXPECT_EQ(tx.asset_xfer.asa.name, nullptr);
+
+    algo_asa_set_resolver(asset_store_resolve, store);
+    parser_init(&ctx, buffer, sizeof(buffer));
+    const parser_error_t err = _read(&ctx, &tx);
+    // The store replaces the built-in table, assets only listed there are unknown
+    algo_asset_t asa {};
+    const bool builtinFound = algo_asa_get(287867876, &asa);
+    algo_asa_set_resolver(nullptr, nullptr);
+
+    ASSERT_EQ(err, parser_ok);
+    ASSERT_NE(tx.asset_xfer.asa.name, nullptr);
+    EXPECT_STREQ(tx.asset_xfer.asa.name, "Test Asset");
+    EXPECT_STREQ(tx.asset_xfer.asa.unit, "TST ");
+    EXPECT_EQ(tx.asset_xfer.asa.decimals, 2);
+    EXPECT_FALSE(builtinFound);
+    EXPECT_TRUE(algo_asa_get(287867876, &asa));
+
+    asset_store_close(store);
+    remove(path.c_str());
+}
@@ -0,0 +1,310 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+
+#include "gmock/gmock.h"
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "base32.h"
+#include "address_batch.h"
+#include "parser_encoding.h"
+
+using namespace std;
+
+namespace {
+
+// The original bit by bit encoder, kept as the reference for the block encoder
+uint32_t referenceEncode(const uint8_t *data, uint32_t length, char *result, uint32_t resultLen) {
+    if (data == NULL || result == NULL || length > (1 << 28) || length == 0 || resultLen == 0) {
+        return 0;
+    }
+    uint32_t count = 0;
+    uint32_t buffer = data[0];
+    uint32_t next = 1;
+    uint32_t bitsLeft = 8;
+    while (count < resultLen && (bitsLeft > 0 || next < length)) {
+        if (bitsLeft < 5) {
+            if (next < length) {
+                buffer <<= 8;
+                buffer |= data[next++] & 0xFF;
+                bitsLeft += 8;
+            } else {
+                uint32_t pad = 5u - bitsLeft;
+                buffer <<= pad;
+                bitsLeft += pad;
+            }
+        }
+        uint32_t index = 0x1Fu & (buffer >> (bitsLeft - 5u));
+        bitsLeft -= 5;
+        result[count++] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"[index];
+    }
+    if (count < resultLen) {
+        result[count] = '\000';
+    } else {
+        count = 0;
+    }
+    return count;
+}
+
+typedef uint32_t (*encode_fn)(const uint8_t *data, uint32_t length, char *result, uint32_t resultLen);
+
+uint32_t encodeAddress(const uint8_t *data, uint32_t length, char *result, uint32_t resultLen) {
+    EXPECT_EQ(length, BASE32_ADDRESS_INPUT_LEN);
+    return base32_encode_address(data, result, resultLen);
+}
+
+// Compares return value and the whole output buffer, including bytes past the terminator
+void expectSame(encode_fn fn, const vector<uint8_t> &data, uint32_t resultLen) {
+    vector<char> expected(resultLen + 1, '#');
+    vector<char> actual(resultLen + 1, '#');
+    const uint32_t expectedLen = referenceEncode(data.data(), data.size(), expected.data(), resultLen);
+    const uint32_t actualLen = fn(data.data(), data.size(), actual.data(), resultLen);
+    ASSERT_EQ(actualLen, expectedLen) << "length " << data.size() << " buffer " << resultLen;
+    ASSERT_EQ(actual, expected) << "length " << data.size() << " buffer " << resultLen;
+}
+
+string encode(const string &s) {
+    char out[64];
+    const uint32_t len = base32_encode(reinterpret_cast<const uint8_t *>(s.data()), s.size(), out, sizeof(out));
+    return string(out, len);
+}
+
+// Empty on rejection; none of the inputs below decode to an empty string
+string decode(const string &s) {
+    uint8_t out[64];
+    const uint32_t len = base32_decode(s.data(), s.size(), out, sizeof(out));
+    return string(reinterpret_cast<const char *>(out), len);
+}
+
+vector<array<uint8_t, PK_LEN_25519>> randomKeys(size_t count, uint32_t seed) {
+    mt19937 rng(seed);
+    vector<array<uint8_t, PK_LEN_25519>> keys(count);
+    for (auto &key : keys) {
+        for (auto &b : key) {
+            b = static_cast<uint8_t>(rng());
+        }
+    }
+    return keys;
+}
+
+string address(const array<uint8_t, PK_LEN_25519> &key) {
+    uint8_t buffer[ADDRESS_BUFFER_LEN];
+    const uint32_t len = encodePubKey(buffer, sizeof(buffer), key.data());
+    return string(reinterpret_cast<const char *>(buffer), len);
+}
+
+}  // namespace
+
+TEST(Base32, KnownAnswers) {
+    // RFC 4648 test vectors, without padding
+    EXPECT_EQ(encode("f"), "MY");
+    EXPECT_EQ(encode("fo"), "MZXQ");
+    EXPECT_EQ(encode("foo"), "MZXW6");
+    EXPECT_EQ(encode("foob"), "MZXW6YQ");
+    EXPECT_EQ(encode("fooba"), "MZXW6YTB");
+    EXPECT_EQ(encode("foobar"), "MZXW6YTBOI");
+}
+
+TEST(Base32, InvalidArguments) {
+    uint8_t data[5] = {0};
+    char out[16];
+    EXPECT_EQ(base32_encode(nullptr, sizeof(data), out, sizeof(out)), 0u);
+    EXPECT_EQ(base32_encode(data, sizeof(data), nullptr, sizeof(out)), 0u);
+    EXPECT_EQ(base32_encode(data, 0, out, sizeof(out)), 0u);
+    EXPECT_EQ(base32_encode(data, sizeof(data), out, 0), 0u);
+    EXPECT_EQ(base32_encode_address(nullptr, out, sizeof(out)), 0u);
+}
+
+TEST(Base32, ExhaustiveBytePairs) {
+    // Each output character depends on at most two adjacent input bytes, so
+    // every value of every adjacent pair, at every offset within a group and
+    // for every tail length, covers all characters the encoder can produce
+    vector<uint8_t> data;
+    for (uint32_t length = 1; length <= 2 * BASE32_BLOCK_BYTES; length++) {
+        data.assign(length, 0xA5);
+        const uint32_t pairs = length == 1 ? 1 : length - 1;
+        for (uint32_t pos = 0; pos < pairs; pos++) {
+            for (uint32_t value = 0; value < 0x10000; value++) {
+                data[pos] = static_cast<uint8_t>(value >> 8);
+                if (pos + 1 < length) {
+                    data[pos + 1] = static_cast<uint8_t>(value);
+                } else if ((value & 0xFF) != 0) {
+                    continue;
+                }
+                expectSame(base32_encode, data, 64);
+                if (HasFatalFailure()) {
+                    return;
+                }
+            }
+            data.assign(length, 0xA5);
+        }
+    }
+}
+
+TEST(Base32, EveryBufferSize) {
+    mt19937 rng(1234);
+    for (uint32_t length = 1; length <= 41; length++) {
+        vector<uint8_t> data(length);
+        for (auto &b : data) {
+            b = static_cast<uint8_t>(rng());
+        }
+        const uint32_t outLen = (length * 8 + 4) / 5;
+        for (uint32_t resultLen = 1; resultLen <= outLen + 2; resultLen++) {
+            expectSame(base32_encode, data, resultLen);
+        }
+    }
+}
+
+TEST(Base32, AddressMatchesGeneric) {
+    mt19937 rng(42);
+    vector<uint8_t> data(BASE32_ADDRESS_INPUT_LEN);
+    for (int i = 0; i < 100000; i++) {
+        for (auto &b : data) {
+            b = static_cast<uint8_t>(rng());
+        }
+        expectSame(encodeAddress, data, BASE32_ADDRESS_LEN + 1);
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+    for (uint32_t resultLen = 1; resultLen <= BASE32_ADDRESS_LEN + 2; resultLen++) {
+        expectSame(encodeAddress, data, resultLen);
+    }
+}
+
+TEST(Base32, DecodeKnownAnswers) {
+    EXPECT_EQ(decode("MY"), "f");
+    EXPECT_EQ(decode("MZXQ"), "fo");
+    EXPECT_EQ(decode("MZXW6"), "foo");
+    EXPECT_EQ(decode("MZXW6YQ"), "foob");
+    EXPECT_EQ(decode("MZXW6YTB"), "fooba");
+    EXPECT_EQ(decode("MZXW6YTBOI"), "foobar");
+}
+
+TEST(Base32, DecodeRejects) {
+    EXPECT_EQ(decode(""), "");
+    EXPECT_EQ(decode("mzxw6"), "");        // lower case
+    EXPECT_EQ(decode("MZXW6==="), "");     // padding
+    EXPECT_EQ(decode("MZX W6"), "");       // white-space
+    EXPECT_EQ(decode("MZXW1"), "");        // outside the alphabet
+    EXPECT_EQ(decode("MZXW0"), "");
+    EXPECT_EQ(decode(string("MZ\0W6", 5)), "");
+    EXPECT_EQ(decode("M"), "");            // lengths no encoding produces
+    EXPECT_EQ(decode("MZX"), "");
+    EXPECT_EQ(decode("MZXW6Y"), "");
+    EXPECT_EQ(decode("MZ"), "");           // non zero padding bits
+    EXPECT_EQ(decode("MZXW6YR"), "");
+
+    uint8_t out[4];
+    EXPECT_EQ(base32_decode("MZXW6YTB", 8, out, sizeof(out)), 0u);
+    EXPECT_EQ(base32_decode(nullptr, 8, out, sizeof(out)), 0u);
+    EXPECT_EQ(base32_decode("MZXW6YTB", 8, nullptr, sizeof(out)), 0u);
+}
+
+TEST(Base32, DecodeRoundTrip) {
+    mt19937 rng(7);
+    for (uint32_t length = 1; length <= 41; length++) {
+        for (int i = 0; i < 200; i++) {
+            vector<uint8_t> data(length);
+            for (auto &b : data) {
+                b = static_cast<uint8_t>(rng());
+            }
+            char encoded[80];
+            const uint32_t encodedLen = base32_encode(data.data(), length, encoded, sizeof(encoded));
+            vector<uint8_t> decoded(length);
+            ASSERT_EQ(base32_decode(encoded, encodedLen, decoded.data(), length), length);
+            ASSERT_EQ(decoded, data);
+        }
+    }
+}
+
+TEST(Address, DecodeRoundTrip) {
+    for (const auto &key : randomKeys(10000, 99)) {
+        const string encoded = address(key);
+        array<uint8_t, PK_LEN_25519> decoded {};
+        ASSERT_EQ(decodeAddress(encoded.data(), encoded.size(), decoded.data()), parser_ok);
+        ASSERT_EQ(decoded, key);
+    }
+}
+
+TEST(Address, DecodeRejectsEverySubstitution) {
+    const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567a1=";
+    for (const auto &key : randomKeys(50, 5)) {
+        const string encoded = address(key);
+        array<uint8_t, PK_LEN_25519> decoded {};
+        for (size_t pos = 0; pos < encoded.size(); pos++) {
+            for (const char *c = alphabet; *c != '\0'; c++) {
+                if (*c == encoded[pos]) {
+                    continue;
+                }
+                string mutated = encoded;
+                mutated[pos] = *c;
+                ASSERT_EQ(decodeAddress(mutated.data(), mutated.size(), decoded.data()), parser_invalid_address)
+                    << mutated;
+            }
+        }
+        EXPECT_EQ(decodeAddress(encoded.data(), encoded.size() - 1, decoded.data()), parser_invalid_address);
+        EXPECT_EQ(decodeAddress((encoded + "A").data(), encoded.size() + 1, decoded.data()), parser_invalid_address);
+    }
+    uint8_t key[PK_LEN_25519];
+    EXPECT_EQ(decodeAddress(nullptr, BASE32_ADDRESS_LEN, key), parser_no_data);
+}
+
+TEST(Address, DecodeBatchMatchesScalar) {
+    const auto keys = randomKeys(150, 11);
+    vector<string> encoded;
+    for (size_t i = 0; i < keys.size(); i++) {
+        string a = address(keys[i]);
+        if (i % 7 == 3) {
+            a[10] = a[10] == 'A' ? 'B' : 'A';   // bad checksum
+        } else if (i % 11 == 5) {
+            a.pop_back();                       // bad length
+        } else if (i % 13 == 0) {
+            a[0] = 'a';                         // bad character
+        }
+        encoded.push_back(a);
+    }
+    vector<const char *> addresses;
+    for (const auto &a : encoded) {
+        addresses.push_back(a.c_str());
+    }
+    addresses.push_back(nullptr);
+
+    vector<array<uint8_t, PK_LEN_25519>> decoded(addresses.size());
+    vector<parser_error_t> errors(addresses.size());
+    const size_t valid = decodeAddressBatch(addresses.data(), addresses.size(),
+                                            reinterpret_cast<uint8_t (*)[PK_LEN_25519]>(decoded.data()),
+                                            errors.data());
+
+    size_t expectedValid = 0;
+    for (size_t i = 0; i < encoded.size(); i++) {
+        array<uint8_t, PK_LEN_25519> expected {};
+        const parser_error_t err = decodeAddress(encoded[i].data(), encoded[i].size(), expected.data());
+        EXPECT_EQ(errors[i], err) << "address " << i;
+        if (err == parser_ok) {
+            EXPECT_EQ(decoded[i], keys[i]);
+            expectedValid++;
+        }
+    }
+    EXPECT_EQ(errors.back(), parser_no_data);
+    EXPECT_EQ(valid, expectedValid);
+    EXPECT_GT(valid, 0u);
+    EXPECT_LT(valid, encoded.size());
+}
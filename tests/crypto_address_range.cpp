@@ -0,0 +1,122 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <cstring>
+#include <vector>
+#include "crypto_fixture.h"
+
+namespace {
+
+// What is left of the APDU buffer once the status word is reserved
+constexpr uint16_t kReplyLen = 258;
+constexpr uint16_t kRecordWithAddress = PK_LEN_25519 + 58;
+
+class CryptoAddressRange : public CryptoStandinTest {
+protected:
+    // Public key and address of one account, as returned by INS_GET_ADDRESS
+    static std::vector<uint8_t> address(uint32_t account) {
+        useAccount(account);
+        uint8_t buffer[256];
+        uint16_t len = 0;
+        EXPECT_EQ(crypto_fillAddress(buffer, sizeof(buffer), &len), zxerr_ok);
+        EXPECT_EQ(len, kRecordWithAddress);
+        return std::vector<uint8_t>(buffer, buffer + kRecordWithAddress);
+    }
+};
+
+}  // namespace
+
+TEST_F(CryptoAddressRange, KeysMatchSingleAccountRequests) {
+    useAccount(1000);
+    uint8_t reply[kReplyLen];
+    uint16_t replyLen = 0;
+    ASSERT_EQ(crypto_fillPublicKeys(5, false, reply, sizeof(reply), &replyLen), zxerr_ok);
+    ASSERT_EQ(replyLen, 5 * PK_LEN_25519);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 5u);
+    EXPECT_EQ(hdPath[2], HDPATH_2_DEFAULT | 1000u);
+
+    for (uint32_t i = 0; i < 5; i++) {
+        const std::vector<uint8_t> expected = address(1000 + i);
+        EXPECT_EQ(memcmp(reply + i * PK_LEN_25519, expected.data(), PK_LEN_25519), 0) << i;
+    }
+}
+
+TEST_F(CryptoAddressRange, AddressesFollowTheirKeys) {
+    useAccount(7);
+    uint8_t reply[kReplyLen];
+    uint16_t replyLen = 0;
+    ASSERT_EQ(crypto_fillPublicKeys(2, true, reply, sizeof(reply), &replyLen), zxerr_ok);
+    ASSERT_EQ(replyLen, 2 * kRecordWithAddress);
+
+    for (uint32_t i = 0; i < 2; i++) {
+        const std::vector<uint8_t> expected = address(7 + i);
+        EXPECT_EQ(memcmp(reply + i * kRecordWithAddress, expected.data(), kRecordWithAddress), 0) << i;
+    }
+}
+
+TEST_F(CryptoAddressRange, StopsAtWhatFitsInTheReply) {
+    uint8_t reply[kReplyLen];
+    uint16_t replyLen = 0;
+    ASSERT_EQ(crypto_fillPublicKeys(255, false, reply, sizeof(reply), &replyLen), zxerr_ok);
+    EXPECT_EQ(replyLen, 8 * PK_LEN_25519);
+    EXPECT_EQ(hdPath[2], HDPATH_2_DEFAULT | 0u);
+
+    // The host continues from the next account
+    useAccount(8);
+    ASSERT_EQ(crypto_fillPublicKeys(255, true, reply, sizeof(reply), &replyLen), zxerr_ok);
+    EXPECT_EQ(replyLen, 2 * kRecordWithAddress);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 10u);
+    EXPECT_EQ(memcmp(reply, address(8).data(), kRecordWithAddress), 0);
+}
+
+TEST_F(CryptoAddressRange, LeavesNoKeyCached) {
+    useAccount(3);
+    uint8_t reply[kReplyLen];
+    uint16_t replyLen = 0;
+    ASSERT_EQ(crypto_fillPublicKeys(1, false, reply, sizeof(reply), &replyLen), zxerr_ok);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 1u);
+
+    // Signing for the same account must derive again
+    const uint8_t message[] = {'T', 'X', 0x80};
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    ASSERT_EQ(crypto_sign(signature, sizeof(signature), message, sizeof(message)), zxerr_ok);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 2u);
+}
+
+TEST_F(CryptoAddressRange, RejectsInvalidRanges) {
+    uint8_t reply[kReplyLen];
+    uint16_t replyLen = 0;
+    EXPECT_EQ(crypto_fillPublicKeys(0, false, reply, sizeof(reply), &replyLen), zxerr_unknown);
+    EXPECT_EQ(crypto_fillPublicKeys(1, true, reply, kRecordWithAddress - 1, &replyLen), zxerr_buffer_too_small);
+
+    // Last account of the range past 2^31 - 1
+    useAccount(0x7FFFFFFEu);
+    EXPECT_EQ(crypto_fillPublicKeys(3, false, reply, sizeof(reply), &replyLen), zxerr_out_of_bounds);
+    EXPECT_EQ(crypto_fillPublicKeys(2, false, reply, sizeof(reply), &replyLen), zxerr_ok);
+    EXPECT_EQ(replyLen, 2 * PK_LEN_25519);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 2u);
+}
+
+TEST_F(CryptoAddressRange, FailureClearsTheReply) {
+    uint8_t reply[kReplyLen];
+    uint16_t replyLen = 0;
+    cx_standin_fail_next(CX_STANDIN_GENERATE_PAIR);
+    EXPECT_NE(crypto_fillPublicKeys(4, false, reply, sizeof(reply), &replyLen), zxerr_ok);
+    EXPECT_EQ(replyLen, 0u);
+    EXPECT_EQ(std::vector<uint8_t>(reply, reply + sizeof(reply)), std::vector<uint8_t>(sizeof(reply), 0));
+}
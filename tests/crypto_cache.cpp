@@ -0,0 +1,123 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <cstring>
+#include <vector>
+#include "crypto_fixture.h"
+
+namespace {
+
+// Relative costs only, the stand-in adds them up instead of spending them
+constexpr uint32_t kDeriveUs = 40000;
+constexpr uint32_t kSignUs = 10000;
+
+const uint8_t kMessage[] = {'T', 'X', 0x81, 0xa3, 'f', 'e', 'e', 0x01};
+
+class CryptoKeyCache : public CryptoStandinTest {
+protected:
+    void SetUp() override {
+        CryptoStandinTest::SetUp();
+        crypto_openKeySession();
+        cx_standin_set_cost(CX_STANDIN_DERIVE, kDeriveUs);
+        cx_standin_set_cost(CX_STANDIN_SIGN, kSignUs);
+    }
+
+    void TearDown() override {
+        CryptoStandinTest::TearDown();
+        for (int call = 0; call < CX_STANDIN_CALLS; call++) {
+            cx_standin_set_cost(static_cast<cx_standin_call_e>(call), 0);
+        }
+    }
+
+    static std::vector<uint8_t> sign() {
+        std::vector<uint8_t> signature(ED25519_SIGNATURE_SIZE);
+        EXPECT_EQ(crypto_sign(signature.data(), signature.size(), kMessage, sizeof(kMessage)), zxerr_ok);
+        return signature;
+    }
+};
+
+}  // namespace
+
+TEST_F(CryptoKeyCache, BackToBackSignaturesDeriveOnce) {
+    const std::vector<uint8_t> first = sign();
+    for (int i = 0; i < 9; i++) {
+        EXPECT_EQ(sign(), first);
+    }
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 1u);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_SIGN), 10u);
+    EXPECT_EQ(cx_standin_elapsed_us(), kDeriveUs + 10u * kSignUs);
+
+    // Same signature as a fresh derivation
+    crypto_clearKeyCache();
+    EXPECT_EQ(sign(), first);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 2u);
+}
+
+TEST_F(CryptoKeyCache, NothingIsKeptOutsideASession) {
+    crypto_clearKeyCache();
+    const std::vector<uint8_t> first = sign();
+    EXPECT_EQ(sign(), first);
+
+    uint8_t address[256];
+    uint16_t addressLen = 0;
+    ASSERT_EQ(crypto_fillAddress(address, sizeof(address), &addressLen), zxerr_ok);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 3u);
+}
+
+TEST_F(CryptoKeyCache, PathChangeDerivesAgain) {
+    const std::vector<uint8_t> account0 = sign();
+    useAccount(1);
+    const std::vector<uint8_t> account1 = sign();
+    EXPECT_NE(account0, account1);
+    useAccount(0);
+    EXPECT_EQ(sign(), account0);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 3u);
+}
+
+TEST_F(CryptoKeyCache, AddressReusesKeyAndPublicKey) {
+    // As large as the APDU buffer crypto_fillAddress writes to on the device
+    uint8_t first[256];
+    uint8_t second[256];
+    uint16_t firstLen = 0;
+    uint16_t secondLen = 0;
+
+    ASSERT_EQ(crypto_fillAddress(first, sizeof(first), &firstLen), zxerr_ok);
+    sign();
+    ASSERT_EQ(crypto_fillAddress(second, sizeof(second), &secondLen), zxerr_ok);
+    EXPECT_EQ(firstLen, secondLen);
+    EXPECT_EQ(memcmp(first, second, firstLen), 0);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 1u);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_GENERATE_PAIR), 1u);
+}
+
+TEST_F(CryptoKeyCache, FailuresDropTheKey) {
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    sign();
+    cx_standin_fail_next(CX_STANDIN_SIGN);
+    EXPECT_NE(crypto_sign(signature, sizeof(signature), kMessage, sizeof(kMessage)), zxerr_ok);
+    sign();
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 2u);
+
+    // A failed derivation leaves nothing behind to sign with
+    crypto_clearKeyCache();
+    cx_standin_fail_next(CX_STANDIN_DERIVE);
+    EXPECT_NE(crypto_sign(signature, sizeof(signature), kMessage, sizeof(kMessage)), zxerr_ok);
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_SIGN), 3u);
+    sign();
+    EXPECT_EQ(cx_standin_count(CX_STANDIN_DERIVE), 4u);
+}
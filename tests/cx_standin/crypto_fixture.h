@@ -0,0 +1,45 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#include "gmock/gmock.h"
+
+#include "crypto.h"
+#include "cx_standin.h"
+
+/// app/src/crypto.c against the cx stand-in: every test starts on account 0 with
+/// fresh counters and an empty key cache, and leaves no key behind
+class CryptoStandinTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        crypto_clearKeyCache();
+        cx_standin_reset();
+        useAccount(0);
+    }
+
+    void TearDown() override {
+        crypto_clearKeyCache();
+    }
+
+    /// Points hdPath at the default path of that account, as INS_GET_ADDRESS would
+    static void useAccount(uint32_t account) {
+        hdPath[0] = HDPATH_0_DEFAULT;
+        hdPath[1] = HDPATH_1_DEFAULT;
+        hdPath[2] = HDPATH_2_DEFAULT | account;
+        hdPath[3] = HDPATH_3_DEFAULT;
+        hdPath[4] = HDPATH_4_DEFAULT;
+    }
+};
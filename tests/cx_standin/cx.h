@@ -0,0 +1,80 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Host stand-in for the cx / os calls made by app/src/crypto.c. Keys and signatures
+// are deterministic digests, not Ed25519: only call counts and cost are meaningful.
+
+typedef uint32_t cx_err_t;
+typedef int cx_curve_t;
+typedef int cx_md_t;
+
+#define CX_OK               0x00000000
+#define CX_INTERNAL_ERROR   0xFFFFFF85
+#define CX_CURVE_Ed25519    0x71
+#define CX_SHA512           6
+#define HDW_NORMAL          0
+
+typedef struct {
+    cx_curve_t curve;
+    size_t d_len;
+    uint8_t d[64];
+} cx_ecfp_private_key_t;
+
+typedef struct {
+    cx_curve_t curve;
+    size_t W_len;
+    uint8_t W[65];
+} cx_ecfp_public_key_t;
+
+#ifndef CATCH_CXERROR
+#define CATCH_CXERROR(CALL)                 \
+    do {                                    \
+        cx_err_t __cx_err = CALL;           \
+        if (__cx_err != CX_OK) {            \
+            goto catch_cx_error;            \
+        }                                   \
+    } while (0)
+#endif
+
+cx_err_t os_derive_bip32_with_seed_no_throw(unsigned int derivationMode, cx_curve_t curve,
+                                            const uint32_t *path, unsigned int pathLength,
+                                            unsigned char *privateKey, unsigned char *chain,
+                                            unsigned char *seed, unsigned int seedLength);
+
+cx_err_t cx_ecfp_init_private_key_no_throw(cx_curve_t curve, const uint8_t *rawKey, size_t keyLen,
+                                           cx_ecfp_private_key_t *privateKey);
+
+cx_err_t cx_ecfp_init_public_key_no_throw(cx_curve_t curve, const uint8_t *rawKey, size_t keyLen,
+                                          cx_ecfp_public_key_t *publicKey);
+
+cx_err_t cx_ecfp_generate_pair_no_throw(cx_curve_t curve, cx_ecfp_public_key_t *publicKey,
+                                        cx_ecfp_private_key_t *privateKey, int keepPrivate);
+
+cx_err_t cx_eddsa_sign_no_throw(const cx_ecfp_private_key_t *privateKey, cx_md_t hashId,
+                                const uint8_t *hash, size_t hashLen,
+                                uint8_t *signature, size_t signatureLen);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,148 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "cx.h"
+#include "cx_standin.h"
+#include "sha512.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+static uint32_t counts[CX_STANDIN_CALLS];
+static uint32_t costs[CX_STANDIN_CALLS];
+static bool failNext[CX_STANDIN_CALLS];
+static uint64_t elapsedUs;
+
+void cx_standin_reset(void) {
+    memset(counts, 0, sizeof(counts));
+    memset(failNext, 0, sizeof(failNext));
+    elapsedUs = 0;
+}
+
+void cx_standin_set_cost(cx_standin_call_e call, uint32_t costUs) {
+    if (call < CX_STANDIN_CALLS) {
+        costs[call] = costUs;
+    }
+}
+
+uint32_t cx_standin_count(cx_standin_call_e call) {
+    return call < CX_STANDIN_CALLS ? counts[call] : 0;
+}
+
+uint64_t cx_standin_elapsed_us(void) {
+    return elapsedUs;
+}
+
+void cx_standin_fail_next(cx_standin_call_e call) {
+    if (call < CX_STANDIN_CALLS) {
+        failNext[call] = true;
+    }
+}
+
+static bool record(cx_standin_call_e call) {
+    counts[call]++;
+    elapsedUs += costs[call];
+    if (failNext[call]) {
+        failNext[call] = false;
+        return false;
+    }
+    return true;
+}
+
+static void digest(const uint8_t *a, size_t aLen, const uint8_t *b, size_t bLen, uint8_t out[SHA512_DIGEST_LENGTH]) {
+    SHA512_256_CTX ctx;
+    SHA512_256_Init(&ctx);
+    SHA512_256_Update(&ctx, a, aLen);
+    SHA512_256_Update(&ctx, b, bLen);
+    SHA512_256_Final(&ctx, out);
+}
+
+cx_err_t os_derive_bip32_with_seed_no_throw(unsigned int derivationMode, cx_curve_t curve,
+                                            const uint32_t *path, unsigned int pathLength,
+                                            unsigned char *privateKey, unsigned char *chain,
+                                            unsigned char *seed, unsigned int seedLength) {
+    (void) derivationMode;
+    (void) chain;
+    (void) seed;
+    (void) seedLength;
+    if (!record(CX_STANDIN_DERIVE) || curve != CX_CURVE_Ed25519 || path == NULL || privateKey == NULL) {
+        return CX_INTERNAL_ERROR;
+    }
+    // Expanded Ed25519 keys are 64 bytes, as written by the device
+    uint8_t out[SHA512_DIGEST_LENGTH];
+    digest((const uint8_t *) "derive", 6, (const uint8_t *) path, pathLength * sizeof(uint32_t), out);
+    memcpy(privateKey, out, 32);
+    digest((const uint8_t *) "chain", 5, out, 32, out);
+    memcpy(privateKey + 32, out, 32);
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_init_private_key_no_throw(cx_curve_t curve, const uint8_t *rawKey, size_t keyLen,
+                                           cx_ecfp_private_key_t *privateKey) {
+    if (!record(CX_STANDIN_INIT_PRIVATE) || privateKey == NULL || keyLen > sizeof(privateKey->d)) {
+        return CX_INTERNAL_ERROR;
+    }
+    privateKey->curve = curve;
+    privateKey->d_len = keyLen;
+    memcpy(privateKey->d, rawKey, keyLen);
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_init_public_key_no_throw(cx_curve_t curve, const uint8_t *rawKey, size_t keyLen,
+                                          cx_ecfp_public_key_t *publicKey) {
+    if (publicKey == NULL || keyLen > sizeof(publicKey->W)) {
+        return CX_INTERNAL_ERROR;
+    }
+    memset(publicKey, 0, sizeof(cx_ecfp_public_key_t));
+    publicKey->curve = curve;
+    publicKey->W_len = keyLen;
+    if (keyLen > 0) {
+        memcpy(publicKey->W, rawKey, keyLen);
+    }
+    return CX_OK;
+}
+
+cx_err_t cx_ecfp_generate_pair_no_throw(cx_curve_t curve, cx_ecfp_public_key_t *publicKey,
+                                        cx_ecfp_private_key_t *privateKey, int keepPrivate) {
+    if (!record(CX_STANDIN_GENERATE_PAIR) || publicKey == NULL || privateKey == NULL || !keepPrivate) {
+        return CX_INTERNAL_ERROR;
+    }
+    // Uncompressed point layout: 0x04 || x || y
+    uint8_t out[SHA512_DIGEST_LENGTH];
+    publicKey->curve = curve;
+    publicKey->W_len = sizeof(publicKey->W);
+    publicKey->W[0] = 0x04;
+    digest((const uint8_t *) "x", 1, privateKey->d, privateKey->d_len, out);
+    memcpy(publicKey->W + 1, out, 32);
+    digest((const uint8_t *) "y", 1, privateKey->d, privateKey->d_len, out);
+    memcpy(publicKey->W + 33, out, 32);
+    return CX_OK;
+}
+
+cx_err_t cx_eddsa_sign_no_throw(const cx_ecfp_private_key_t *privateKey, cx_md_t hashId,
+                                const uint8_t *hash, size_t hashLen,
+                                uint8_t *signature, size_t signatureLen) {
+    (void) hashId;
+    if (!record(CX_STANDIN_SIGN) || privateKey == NULL || signature == NULL || signatureLen < 64) {
+        return CX_INTERNAL_ERROR;
+    }
+    uint8_t out[SHA512_DIGEST_LENGTH];
+    digest(privateKey->d, privateKey->d_len, hash, hashLen, out);
+    memcpy(signature, out, 32);
+    digest(out, 32, hash, hashLen, out);
+    memcpy(signature + 32, out, 32);
+    return CX_OK;
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef enum {
+    CX_STANDIN_DERIVE = 0,      // os_derive_bip32_with_seed_no_throw
+    CX_STANDIN_INIT_PRIVATE,    // cx_ecfp_init_private_key_no_throw
+    CX_STANDIN_GENERATE_PAIR,   // cx_ecfp_generate_pair_no_throw
+    CX_STANDIN_SIGN,            // cx_eddsa_sign_no_throw
+    CX_STANDIN_CALLS,
+} cx_standin_call_e;
+
+/// Clears call counts and the elapsed time, costs are kept
+void cx_standin_reset(void);
+
+/// Time each call of that kind adds to cx_standin_elapsed_us
+void cx_standin_set_cost(cx_standin_call_e call, uint32_t costUs);
+
+uint32_t cx_standin_count(cx_standin_call_e call);
+
+/// Sum of the costs of every call since the last reset, what the device would spend in them
+uint64_t cx_standin_elapsed_us(void);
+
+/// Makes the next call of that kind fail
+void cx_standin_fail_next(cx_standin_call_e call);
+
+#ifdef __cplusplus
+}
+#endif
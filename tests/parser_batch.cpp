@@ -0,0 +1,114 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <vector>
+#include <string>
+#include <hexutils.h>
+#include <parser_txdef.h>
+#include <parser.h>
+#include "parser_batch.h"
+#include "utils/common.h"
+
+namespace {
+
+std::vector<std::vector<uint8_t>> buildCorpus(size_t numBlobs) {
+    const size_t numVectors = sizeof(kTxBlobs) / sizeof(kTxBlobs[0]);
+    std::vector<std::vector<uint8_t>> corpus;
+    for (size_t i = 0; i < numBlobs; i++) {
+        const char *hex = kTxBlobs[i % numVectors];
+        std::vector<uint8_t> blob(strlen(hex) / 2);
+        parseHexString(blob.data(), blob.size(), hex);
+        switch (i % 5) {
+            case 3:
+                // Truncated transaction
+                blob.resize(blob.size() - 1 - (i % 17));
+                break;
+            case 4:
+                // Corrupted byte
+                blob[(i * 31) % blob.size()] ^= 0xA5;
+                break;
+            default:
+                break;
+        }
+        corpus.push_back(blob);
+    }
+    return corpus;
+}
+
+parser_batch_result_t sequentialResult(const std::vector<uint8_t> &blob) {
+    parser_batch_result_t result = {parser_ok, 0};
+    parser_context_t ctx;
+    parser_tx_t tx_obj;
+    memset(&tx_obj, 0, sizeof(tx_obj));
+
+    result.error = parser_parse(&ctx, blob.data(), blob.size(), &tx_obj);
+    if (result.error == parser_ok) {
+        result.error = parser_validateStructure(&ctx);
+    }
+    if (result.error == parser_ok) {
+        result.error = parser_getNumItems(&ctx, &result.numItems);
+    }
+    return result;
+}
+
+void checkBatch(uint32_t numThreads) {
+    const auto corpus = buildCorpus(1000);
+    std::vector<parser_batch_blob_t> blobs;
+    for (const auto &blob : corpus) {
+        blobs.push_back({blob.data(), blob.size()});
+    }
+
+    std::vector<parser_batch_result_t> results(blobs.size());
+    const parser_error_t err = parser_parse_batch(blobs.data(), blobs.size(), results.data(), numThreads);
+    ASSERT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    size_t valid = 0;
+    for (size_t i = 0; i < corpus.size(); i++) {
+        const parser_batch_result_t expected = sequentialResult(corpus[i]);
+        EXPECT_EQ(results[i].error, expected.error) << "blob " << i;
+        EXPECT_EQ(results[i].numItems, expected.numItems) << "blob " << i;
+        valid += results[i].error == parser_ok ? 1 : 0;
+    }
+    EXPECT_GE(valid, corpus.size() * 3 / 5);
+}
+
+}  // namespace
+
+TEST(ParserBatch, SingleThread) { checkBatch(1); }
+
+TEST(ParserBatch, MultipleThreads) { checkBatch(4); }
+
+TEST(ParserBatch, MoreThreadsThanBlobs) {
+    const auto corpus = buildCorpus(3);
+    std::vector<parser_batch_blob_t> blobs;
+    for (const auto &blob : corpus) {
+        blobs.push_back({blob.data(), blob.size()});
+    }
+    std::vector<parser_batch_result_t> results(blobs.size());
+    EXPECT_EQ(parser_parse_batch(blobs.data(), blobs.size(), results.data(), 16), parser_ok);
+    for (const auto &result : results) {
+        EXPECT_EQ(result.error, parser_ok);
+        EXPECT_GT(result.numItems, 0);
+    }
+}
+
+TEST(ParserBatch, InvalidArguments) {
+    parser_batch_result_t result;
+    EXPECT_EQ(parser_parse_batch(nullptr, 0, nullptr, 1), parser_ok);
+    EXPECT_EQ(parser_parse_batch(nullptr, 1, &result, 1), parser_unexpected_value);
+}
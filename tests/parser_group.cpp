@@ -0,0 +1,282 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "parser.h"
+#include "parser_group.h"
+#include "sha512.h"
+#include "utils/common.h"
+
+using namespace std;
+
+namespace {
+
+// Transaction IDs of kGroupMembers, grp included, computed independently
+const vector<string> kMemberTxIds = {
+    "02f827fa3c6929a57905c8d548491a83df3bb95be535e50e0b82266df4ed47df",
+    "390966005e2c6225c9815cb7d5bad1415fa44841f6693558d11916ee71ff4d02",
+    "416d006e2d45b28f8e1d7abea12c36892de76b1cd6c395e76da8ba1ad573db14",
+};
+
+// The two payments grouped on their own
+const vector<string> kPair = {
+    "8aa3616d74ce000f4240a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c420aea7ea2738c5c1c753c3a03208fb5de27c40d4b6fee5f7d6bdb1495106e12089a26c76cd07d0a3726376c4204142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f60a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a3706179",
+    "8aa3616d74cd09c4a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c420aea7ea2738c5c1c753c3a03208fb5de27c40d4b6fee5f7d6bdb1495106e12089a26c76cd07d0a3726376c4206162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f80a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a3706179",
+};
+
+// Sixteen payments of 1 to 16 microalgos, member i has amt = i + 1 at kAmountOffset
+const char *kGroup16Id = "eda551df80b65783be9832c57af55e30b0233ac5669f7d604bc1ad44d726f10e";
+const char *kGroup16Member = "8aa3616d7401a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c420eda551df80b65783be9832c57af55e30b0233ac5669f7d604bc1ad44d726f10ea26c76cd07d0a3726376c4204142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f60a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a3706179";
+constexpr size_t kAmountOffset = 5;
+
+vector<uint8_t> groupStream(uint8_t count, uint16_t signMask, const vector<vector<uint8_t>> &members) {
+    vector<uint8_t> stream = {count, static_cast<uint8_t>(signMask >> 8), static_cast<uint8_t>(signMask)};
+    for (const auto &m : members) {
+        stream.push_back(static_cast<uint8_t>(m.size() >> 8));
+        stream.push_back(static_cast<uint8_t>(m.size()));
+        stream.insert(stream.end(), m.begin(), m.end());
+    }
+    return stream;
+}
+
+vector<uint8_t> groupStream(uint16_t signMask, const vector<string> &members) {
+    vector<vector<uint8_t>> raw;
+    for (const auto &m : members) {
+        raw.push_back(fromHex(m));
+    }
+    return groupStream(static_cast<uint8_t>(raw.size()), signMask, raw);
+}
+
+// Scans the stream in chunks as the device receives it, the stream ends up as the group buffer
+parser_error_t scan(parser_group_t *group, vector<uint8_t> &stream, size_t chunkLen) {
+    parser_groupInit(group);
+    for (size_t off = 0; off < stream.size(); off += chunkLen) {
+        const size_t len = min(chunkLen, stream.size() - off);
+        const parser_error_t err = parser_groupScan(group, stream.data() + off, static_cast<uint16_t>(len));
+        if (err != parser_ok) {
+            return err;
+        }
+    }
+    return parser_ok;
+}
+
+struct GroupReview {
+    parser_group_t group {};
+    parser_context_t ctx {};
+    parser_tx_t tx {};
+    vector<uint8_t> buffer;
+
+    parser_error_t load(vector<uint8_t> stream, size_t chunkLen = 250) {
+        buffer = std::move(stream);
+        CHECK_ERROR(scan(&group, buffer, chunkLen))
+        return parser_groupVerify(&group, &ctx, &tx, buffer.data(), static_cast<uint16_t>(buffer.size()));
+    }
+
+    vector<string> items() {
+        vector<string> out;
+        uint8_t numItems = 0;
+        EXPECT_EQ(parser_groupGetNumItems(&group, &numItems), parser_ok);
+        for (uint8_t i = 0; i < numItems; i++) {
+            char key[40];
+            char val[100];
+            uint8_t pageCount = 0;
+            const parser_error_t err = parser_groupGetItem(&group, &ctx, &tx, i, key, sizeof(key),
+                                                           val, sizeof(val), 0, &pageCount);
+            EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+            out.push_back(string(key) + " = " + val);
+        }
+        return out;
+    }
+};
+
+}  // namespace
+
+TEST(TxGroup, ScanReplacesLengthsWithPrefix) {
+    const vector<uint8_t> original = groupStream(0b101, kGroupMembers);
+    for (size_t chunkLen : {1, 2, 3, 7, 64, 250, 4096}) {
+        vector<uint8_t> stream = original;
+        parser_group_t group;
+        ASSERT_EQ(scan(&group, stream, chunkLen), parser_ok) << chunkLen;
+        ASSERT_EQ(group.numTxns, 3);
+        ASSERT_EQ(group.signMask, 0b101);
+
+        size_t offset = GROUP_HEADER_LEN;
+        for (size_t i = 0; i < kGroupMembers.size(); i++) {
+            const vector<uint8_t> member = fromHex(kGroupMembers[i]);
+            EXPECT_EQ(group.txnOffset[i], offset);
+            EXPECT_EQ(group.txnLen[i], member.size());
+            EXPECT_EQ(stream[offset], 'T');
+            EXPECT_EQ(stream[offset + 1], 'X');
+            EXPECT_EQ(memcmp(stream.data() + offset + 2, member.data(), member.size()), 0);
+            offset += GROUP_TXN_PREFIX_LEN + member.size();
+        }
+        EXPECT_EQ(offset, stream.size());
+    }
+}
+
+TEST(TxGroup, RejectsMalformedStreams) {
+    const vector<vector<uint8_t>> members = {fromHex(kPair[0]), fromHex(kPair[1])};
+    parser_group_t group;
+
+    vector<uint8_t> noMembers = groupStream(0, 1, {});
+    EXPECT_EQ(scan(&group, noMembers, 250), parser_unexpected_number_items);
+
+    vector<uint8_t> tooMany = groupStream(GROUP_MAX_TXNS + 1, 1, members);
+    EXPECT_EQ(scan(&group, tooMany, 250), parser_unexpected_number_items);
+
+    vector<uint8_t> noSigner = groupStream(2, 0, members);
+    EXPECT_EQ(scan(&group, noSigner, 250), parser_unexpected_value);
+
+    vector<uint8_t> missingSigner = groupStream(2, 0b100, members);
+    EXPECT_EQ(scan(&group, missingSigner, 250), parser_unexpected_value);
+
+    vector<uint8_t> emptyMember = groupStream(2, 1, {members[0], {}});
+    EXPECT_EQ(scan(&group, emptyMember, 250), parser_unexpected_buffer_end);
+
+    vector<uint8_t> trailing = groupStream(2, 1, members);
+    trailing.push_back(0);
+    EXPECT_EQ(scan(&group, trailing, 1), parser_unexpected_characters);
+    // The first error sticks
+    EXPECT_EQ(parser_groupScan(&group, trailing.data(), 1), parser_unexpected_characters);
+
+    // Stops in the middle of the second member
+    vector<uint8_t> truncated = groupStream(2, 1, members);
+    truncated.resize(truncated.size() - 10);
+    ASSERT_EQ(scan(&group, truncated, 250), parser_ok);
+    parser_context_t ctx;
+    parser_tx_t tx;
+    EXPECT_EQ(parser_groupVerify(&group, &ctx, &tx, truncated.data(), truncated.size()), parser_unexpected_buffer_end);
+}
+
+TEST(TxGroup, VerifiesGroupId) {
+    GroupReview review;
+    ASSERT_EQ(review.load(groupStream(0b101, kGroupMembers)), parser_ok);
+    EXPECT_EQ(toHex(review.group.groupId, GROUP_ID_LEN), kGroupId);
+
+    // Signed members are returned exactly as their transaction ID is computed
+    for (uint8_t i = 0; i < kGroupMembers.size(); i++) {
+        const uint8_t *message = nullptr;
+        uint16_t messageLen = 0;
+        const parser_error_t err = parser_groupGetSignedTxn(&review.group, i, &message, &messageLen);
+        if ((0b101 >> i) & 1) {
+            ASSERT_EQ(err, parser_ok);
+            uint8_t digest[SHA512_DIGEST_LENGTH];
+            SHA512_256(message, messageLen, digest);
+            EXPECT_EQ(toHex(digest, 32), kMemberTxIds[i]);
+        } else {
+            EXPECT_EQ(err, parser_unexpected_value);
+        }
+    }
+    const uint8_t *message = nullptr;
+    uint16_t messageLen = 0;
+    EXPECT_EQ(parser_groupGetSignedTxn(&review.group, 3, &message, &messageLen), parser_display_idx_out_of_range);
+}
+
+TEST(TxGroup, VerifiesLargestGroup) {
+    vector<vector<uint8_t>> members;
+    for (uint8_t i = 0; i < GROUP_MAX_TXNS; i++) {
+        vector<uint8_t> member = fromHex(kGroup16Member);
+        member[kAmountOffset] = i + 1;
+        members.push_back(member);
+    }
+    GroupReview review;
+    ASSERT_EQ(review.load(groupStream(GROUP_MAX_TXNS, 0xFFFF, members), 64), parser_ok);
+    EXPECT_EQ(toHex(review.group.groupId, GROUP_ID_LEN), kGroup16Id);
+
+    const vector<string> items = review.items();
+    ASSERT_EQ(items.size(), review.group.numItems);
+    EXPECT_EQ(items[0], "Group = 16 txns");
+    EXPECT_EQ(items[1], "Sign txns = 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16");
+    EXPECT_EQ(items.back(), "16/16 Amount = ALGO 0.000016");
+}
+
+TEST(TxGroup, RejectsMismatchedMembers) {
+    // One amount changed after the group ID was computed
+    vector<vector<uint8_t>> members = {fromHex(kGroupMembers[0]), fromHex(kGroupMembers[1]), fromHex(kGroupMembers[2])};
+    members[1][kAmountOffset + 2] ^= 1;
+    GroupReview tampered;
+    EXPECT_EQ(tampered.load(groupStream(3, 1, members)), parser_group_id_mismatch);
+
+    // Members of two different groups
+    GroupReview mixed;
+    EXPECT_EQ(mixed.load(groupStream(1, {kGroupMembers[0], kPair[1]})), parser_group_id_mismatch);
+
+    // A member of the group left out
+    GroupReview partial;
+    EXPECT_EQ(partial.load(groupStream(1, {kGroupMembers[0], kGroupMembers[1]})), parser_group_id_mismatch);
+
+    GroupReview ungrouped;
+    EXPECT_EQ(ungrouped.load(groupStream(1, kGroupUngrouped)), parser_missing_field);
+
+    // Bytes after the map would be signed but not covered by the group ID
+    vector<vector<uint8_t>> trailing = {fromHex(kPair[0]), fromHex(kPair[1])};
+    trailing[0].push_back(0xc0);
+    GroupReview extra;
+    EXPECT_EQ(extra.load(groupStream(2, 1, trailing)), parser_unexpected_characters);
+
+    // Nothing can be signed from a group that did not verify
+    const uint8_t *message = nullptr;
+    uint16_t messageLen = 0;
+    EXPECT_NE(parser_groupGetSignedTxn(&tampered.group, 0, &message, &messageLen), parser_ok);
+}
+
+TEST(TxGroup, SharedFieldsShownOnce) {
+    GroupReview review;
+    ASSERT_EQ(review.load(groupStream(0b101, kGroupMembers)), parser_ok);
+
+    // Fee, genesis and group ID are the same in every member, senders differ
+    const vector<string> items = review.items();
+    EXPECT_THAT(items, ::testing::ElementsAre(
+        "Group = 3 txns",
+        "Sign txns = 1, 3",
+        "Fee = ALGO 0.001",
+        "Genesis ID = testnet-v1.0",
+        "Genesis hash = SGO1GKSzyE7IEPItTxCByw9x8FmnrCDexi9/cOUJOiI=",
+        "Group ID = GICtRiI1NmFAEIO8Z3QTx5JuFHv7AJ1fXJdqOtL+6uk=",
+        "1/3 Txn type = Payment",
+        "1/3 Sender = AEBAGBAFAYDQQCIKBMGA2DQPCAIREEYUCULBOGAZDINRYHI6D4QDTYK3BA",
+        "1/3 Receiver = IFBEGRCFIZDUQSKKJNGE2TSPKBIVEU2UKVLFOWCZLJNVYXK6L5QDK3LAIY",
+        "1/3 Amount = ALGO 1.0",
+        "2/3 Txn type = Payment",
+        "2/3 Sender = AEBAGBAFAYDQQCIKBMGA2DQPCAIREEYUCULBOGAZDINRYHI6D4QDTYK3BA",
+        "2/3 Receiver = MFRGGZDFMZTWQ2LKNNWG23TPOBYXE43UOV3HO6DZPJ5XY7L6P6AORBDTFY",
+        "2/3 Amount = ALGO 0.0025",
+        "3/3 Txn type = Asset xfer",
+        "3/3 Sender = EERCGJBFEYTSQKJKFMWC2LRPGAYTEMZUGU3DOOBZHI5TYPJ6H5APQGQK7A",
+        "3/3 Asset ID = USDC (#31566704)",
+        "3/3 Amount = USDC 0.00001",
+        "3/3 Asset dst = AEBAGBAFAYDQQCIKBMGA2DQPCAIREEYUCULBOGAZDINRYHI6D4QDTYK3BA"));
+
+    // Same review for any order of requests, members are parsed again as needed
+    for (int i = static_cast<int>(items.size()) - 1; i >= 0; i--) {
+        char key[40];
+        char val[100];
+        uint8_t pageCount = 0;
+        ASSERT_EQ(parser_groupGetItem(&review.group, &review.ctx, &review.tx, i, key, sizeof(key),
+                                      val, sizeof(val), 0, &pageCount), parser_ok);
+        EXPECT_EQ(string(key) + " = " + val, items[i]);
+    }
+
+    uint8_t pageCount = 0;
+    char key[40];
+    char val[100];
+    EXPECT_EQ(parser_groupGetItem(&review.group, &review.ctx, &review.tx, items.size(), key, sizeof(key),
+                                  val, sizeof(val), 0, &pageCount), parser_display_idx_out_of_range);
+}
@@ -0,0 +1,180 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <array>
+#include <string>
+#include <vector>
+#include <hexutils.h>
+#include "parser_group_build.h"
+#include "group_batch.h"
+#include "parser.h"
+#include "utils/common.h"
+
+using namespace std;
+
+namespace {
+
+// Transaction IDs of kGroupUngrouped, computed independently
+const vector<string> kTxnIds = {
+    "581655317aefe706165f675b6ee3cbe263ac43498d38e1c6da005c587d820660",
+    "eafc86a00ad7049888ed84efe86b7faebed06526a881520b94edd7a311a7efa5",
+    "675c2d1c5c655aef326060d4e38ee2042629e5a50df1beca645a173ab5b8254d",
+};
+
+// Application call with 15 keys, grp turns its fixmap into a map16
+const char *kFullMap = "8fa46170616e01a46170657001a46170677381a36e756901a46170696405a461706c7381a36e627302a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a26c78c4207878787878787878787878787878787878787878787878787878787878787878a46e6f7465c4016ea572656b6579c4202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f40a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a46170706c";
+const char *kFullMapGroupId = "db041359423ba3a19acad29f49880244c9711b4b7d3e8ddffcb8c4f74b9d6ae4";
+const char *kFullMapGrouped = "de0010a46170616e01a46170657001a46170677381a36e756901a46170696405a461706c7381a36e627302a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c420db041359423ba3a19acad29f49880244c9711b4b7d3e8ddffcb8c4f74b9d6ae4a26c76cd07d0a26c78c4207878787878787878787878787878787878787878787878787878787878787878a46e6f7465c4016ea572656b6579c4202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f40a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a46170706c";
+
+// Member buffer with room for grp
+struct Member {
+    vector<uint8_t> buffer;
+    group_txn_t txn {};
+
+    explicit Member(const string &hex, size_t room = GROUP_BUILD_MAX_GROWTH) {
+        buffer.resize(hex.size() / 2 + room);
+        txn.len = static_cast<uint16_t>(parseHexString(buffer.data(), buffer.size(), hex.c_str()));
+        txn.data = buffer.data();
+        txn.capacity = static_cast<uint16_t>(buffer.size());
+    }
+
+    string hex() const { return toHex(txn.data, txn.len); }
+};
+
+vector<group_txn_t> txns(vector<Member> &members) {
+    vector<group_txn_t> out;
+    for (auto &m : members) {
+        out.push_back(m.txn);
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(GroupBuild, SetsGroupInEveryMember) {
+    vector<Member> members;
+    for (const auto &hex : kGroupUngrouped) {
+        members.emplace_back(hex);
+    }
+    vector<group_txn_t> group = txns(members);
+    uint8_t ids[3][GROUP_ID_LEN];
+    uint8_t groupId[GROUP_ID_LEN];
+
+    ASSERT_EQ(group_build(group.data(), 3, ids, groupId), parser_ok);
+    EXPECT_EQ(toHex(groupId, GROUP_ID_LEN), kGroupId);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(toHex(ids[i], GROUP_ID_LEN), kTxnIds[i]) << i;
+        EXPECT_EQ(toHex(group[i].data, group[i].len), kGroupMembers[i]) << i;
+    }
+
+    // Building again only rewrites grp, the IDs do not depend on it
+    const uint16_t len = group[0].len;
+    ASSERT_EQ(group_build(group.data(), 3, ids, groupId), parser_ok);
+    EXPECT_EQ(group[0].len, len);
+    EXPECT_EQ(toHex(groupId, GROUP_ID_LEN), kGroupId);
+    EXPECT_EQ(toHex(group[2].data, group[2].len), kGroupMembers[2]);
+}
+
+TEST(GroupBuild, GrowsFixmapIntoMap16) {
+    Member member(kFullMap);
+    uint8_t groupId[GROUP_ID_LEN];
+
+    ASSERT_EQ(group_build(&member.txn, 1, nullptr, groupId), parser_ok);
+    EXPECT_EQ(toHex(groupId, GROUP_ID_LEN), kFullMapGroupId);
+    EXPECT_EQ(member.hex(), kFullMapGrouped);
+}
+
+TEST(GroupBuild, RejectsWithoutTouchingMembers) {
+    uint8_t groupId[GROUP_ID_LEN];
+
+    // Second member can not take grp
+    vector<Member> members;
+    members.emplace_back(kGroupUngrouped[0]);
+    members.emplace_back(kGroupUngrouped[1], GROUP_GRP_ENTRY_LEN - 1);
+    vector<group_txn_t> group = txns(members);
+    EXPECT_EQ(group_build(group.data(), 2, nullptr, groupId), parser_buffer_too_small);
+    EXPECT_EQ(toHex(group[0].data, group[0].len), kGroupUngrouped[0]);
+
+    // "amt" and "fee" swapped
+    string unsorted = kGroupUngrouped[0];
+    const string amt = unsorted.substr(2, 18);
+    const string fee = unsorted.substr(20, 14);
+    unsorted.replace(2, 32, fee + amt);
+    Member bad(unsorted);
+    EXPECT_EQ(group_build(&bad.txn, 1, nullptr, groupId), parser_msgpack_unexpected_key);
+    EXPECT_EQ(bad.hex(), unsorted);
+
+    Member trailing(kGroupUngrouped[0] + "c0");
+    EXPECT_EQ(group_build(&trailing.txn, 1, nullptr, groupId), parser_unexpected_characters);
+
+    EXPECT_EQ(group_build(group.data(), 0, nullptr, groupId), parser_unexpected_number_items);
+}
+
+TEST(GroupBuild, BatchMatchesSingleGroups) {
+    constexpr size_t kGroups = 1000;
+    const vector<string> variants = {kGroupUngrouped[0], kGroupUngrouped[1], kGroupUngrouped[2], kFullMap, kGroupMembers[1]};
+
+    // Groups of 1 to 16 members, every 7th one with a member that has no room for grp
+    auto makeGroup = [&](size_t g) {
+        vector<Member> members;
+        const size_t count = 1 + g % GROUP_MAX_TXNS;
+        for (size_t i = 0; i < count; i++) {
+            const size_t room = (g % 7 == 3 && i == count - 1) ? 0 : GROUP_BUILD_MAX_GROWTH;
+            members.emplace_back(variants[(g + i) % variants.size()], room);
+        }
+        return members;
+    };
+
+    for (uint32_t threads : {1u, 4u}) {
+        vector<vector<Member>> members(kGroups);
+        vector<vector<group_txn_t>> groupTxns(kGroups);
+        vector<vector<uint8_t>> ids(kGroups);
+        vector<group_batch_t> batch(kGroups);
+        for (size_t g = 0; g < kGroups; g++) {
+            members[g] = makeGroup(g);
+            groupTxns[g] = txns(members[g]);
+            ids[g].resize(members[g].size() * GROUP_ID_LEN);
+            batch[g].txns = groupTxns[g].data();
+            batch[g].count = static_cast<uint8_t>(members[g].size());
+            batch[g].txnIds = reinterpret_cast<uint8_t (*)[GROUP_ID_LEN]>(ids[g].data());
+        }
+
+        ASSERT_EQ(batch.size(), kGroups);
+        const size_t built = group_build_batch(batch.data(), kGroups, threads);
+
+        size_t expectedBuilt = 0;
+        for (size_t g = 0; g < kGroups; g++) {
+            vector<Member> single = makeGroup(g);
+            vector<group_txn_t> group = txns(single);
+            uint8_t expectedIds[GROUP_MAX_TXNS][GROUP_ID_LEN];
+            uint8_t groupId[GROUP_ID_LEN];
+            const parser_error_t err = group_build(group.data(), static_cast<uint8_t>(group.size()), expectedIds, groupId);
+            expectedBuilt += err == parser_ok ? 1 : 0;
+
+            ASSERT_EQ(batch[g].error, err) << g;
+            for (size_t i = 0; i < group.size(); i++) {
+                EXPECT_EQ(toHex(groupTxns[g][i].data, groupTxns[g][i].len), toHex(group[i].data, group[i].len)) << g;
+            }
+            if (err == parser_ok) {
+                EXPECT_EQ(toHex(batch[g].groupId, GROUP_ID_LEN), toHex(groupId, GROUP_ID_LEN)) << g;
+                EXPECT_EQ(toHex(ids[g].data(), ids[g].size()), toHex(expectedIds[0], ids[g].size())) << g;
+            }
+        }
+        EXPECT_EQ(built, expectedBuilt);
+    }
+}
@@ -16,15 +16,26 @@
 
 #include "gmock/gmock.h"
 
+#include <utility>
 #include <vector>
 #include <iostream>
 #include <hexutils.h>
 #include <parser_txdef.h>
 #include <parser.h>
 #include "parser_impl.h"
+#include "msgpack.h"
+#include "parser_keys.h"
+#include "parser_encoding.h"
+#include "utils/common.h"
 
 using namespace std;
 
+namespace {
+
+const std::vector<uint8_t> kApplicationCall = fromHex(kApplicationCallHex);
+
+}
+
 TEST(SCALE, ReadBytes) {
     parser_context_t ctx;
     parser_error_t err;
@@ -385,12 +396,19 @@ TEST(Transactions, Application) {
     parser_error_t err;
     parser_tx_t parser_obj;
 
-    uint8_t buffer[] = {222,0,20,164,97,112,97,97,146,196,1,0,196,2,1,2,164,97,112,97,110,1,164,97,112,97,112,196,5,1,32,1,1,34,164,97,112,97,115,145,6,164,97,112,97,116,145,196,32,187,14,182,52,21,74,24,11,106,39,77,215,117,41,92,54,211,186,122,174,107,93,176,204,16,197,70,45,176,243,48,223,164,97,112,101,112,2,164,97,112,102,97,145,3,164,97,112,103,115,130,163,110,98,115,2,163,110,117,105,1,164,97,112,108,115,130,163,110,98,115,4,163,110,117,105,3,164,97,112,115,117,196,5,2,32,1,1,34,163,102,101,101,205,3,232,162,102,118,206,0,4,236,15,163,103,101,110,172,116,101,115,116,110,101,116,45,118,49,46,48,162,103,104,196,32,72,99,181,24,164,179,200,78,200,16,242,45,79,16,129,203,15,113,240,89,167,172,32,222,198,47,127,112,229,9,58,34,162,108,118,206,0,4,239,247,162,108,120,196,32,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,164,110,111,116,101,196,10,110,111,116,101,32,118,97,108,117,101,165,114,101,107,101,121,196,32,160,137,170,105,34,227,185,152,250,223,246,205,72,8,221,249,224,33,228,148,78,56,158,163,213,198,56,120,102,137,25,126,163,115,110,100,196,32,9,251,210,118,44,8,248,108,90,230,191,109,215,167,169,1,222,102,117,215,80,224,126,140,92,118,152,100,125,182,225,253,164,116,121,112,101,164,97,112,112,108};
-    uint16_t bufferLen = sizeof(buffer)/sizeof(buffer[0]);
-
-    parser_init(&ctx, buffer, bufferLen);
+    parser_init(&ctx, kApplicationCall.data(), kApplicationCall.size());
     err =_read(&ctx, &parser_obj);
     EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    // Args and accounts are recorded as views into the buffer while they are verified
+    const txn_application &application = parser_obj.application;
+    ASSERT_EQ(application.num_app_args, 2);
+    EXPECT_EQ(application.app_args_len[0], 1);
+    EXPECT_EQ(application.app_args[0], kApplicationCall.data() + 11);
+    EXPECT_EQ(application.app_args_len[1], 2);
+    EXPECT_EQ(application.app_args[1], kApplicationCall.data() + 14);
+    ASSERT_EQ(application.num_accounts, 1);
+    EXPECT_EQ(application.accounts[0], kApplicationCall.data() + 49);
 }
 
 TEST(Transactions, ApplicationLongBoxes) {
@@ -407,3 +425,404 @@ TEST(Transactions, ApplicationLongBoxes) {
     // Try to parse transaction with Box: n = 65 bytes. It should be rejected with value out of range
     EXPECT_EQ(err, parser_value_out_of_range) << parser_getErrorDescription(err);
 }
+
+TEST(Transactions, KeyIndexSinglePass) {
+    parser_context_t ctx;
+    parser_tx_t parser_obj;
+
+    std::string blobStr = "8fa46170616192c50420ce1eb981afa49dde3d96f723a21eb3d8282755cd679fd55352bf010a49866c38d44f96e5ad9d674e6970ca6da1eb9707bc3333fd6789fe029eedf4303842d87049328f2789a898388cb1632680bb72216486d6f71bf946867ee36a5b1d4d0258a169157111c82af79b7566c1c606a7dc315235fe90253eedb41c264622fd9999676d305021be204cf715a02b6121a5f1db0d7d8d85ab9319d7105c786a12826a50be196c2631eb2295cbfdcb949099bf53201aee56ce06f70e9524dcd79c399f375cc1a8388d68e46a42fade2c40eb6e5ddf5ad267dd7ac7b66b120730c5c71f4b9f198141592c8b3f78ceef696fc51810b98d3178ac6af3e157f36b1eca33a54fadee1483e621e100dcddf52eafe3a3fdd636eb72a7d3cb28c9f73cfdb06eeee28215609e5d5c06266ec11c1d03439cd15af5fa13fac7fcabd48dfbded45f89fc36b2031f2acbdcc1cabbce9503572ac473fe585fb558640cc1e67d9e58b61f2284acee61cfab0b6a8237c6a06db378d0ebf3532b3243840b369f5a0fc08678c24ab38da942c6fbe5847f4779ca0be090eec0233c2d20b740a99be53c9118eda5182e7bd96973f19c359afbef8fb232dfeee26ed06aecd0ed97c2c22e98e0d53c7c5cd6eba396bec9afe7e919e04ee665b25269e02623cb8909c8172c09c7cab02281adf070e079ee379cd2f5e56410584096fc32d813b9f0595bfbfd8ee81b44925853c2654d1692d7b6bc25e4c806fec0f4f82889139e34a9c23ac662c6895079f1aeedde53094189ab72b9c3a5c78b35ae98c1275001b97f29ab8688954650f831d2dd47777fef9b063225c49fd7f4bff364238db26fd0dbee0d27861431f61da05deef420196f1d3fe189e1dc7acec265668fb8091cc1518de336090e696cb59aadb601b902505ca3679dd6343be18c9dcfe58c1180a3c95204c011aab05e724889d175f75b1ecf957884bae425786fc3cd5e6e46cf168929aafa1873dc96b875908fc33b81b330a878dc3479b8a79551db0c1d168d6d7eaa0be07957f29441ab1e0d3bc4f68b07a710ec2e8416a8a66df537542cedc1f88fa457c95a97fb4ec970834ccc4f891bc4ee28b5fe85146c49527781d6c32a1eebc87691f921a27c71312c03bfc9593c3e12f7cc62b994f865137b319caf467a771ce8b95bcfe950d4840208154d2ca07f0e5fbb4f0b78abaf000f55a3763e37a36f3075d0a79ade78fbfe7355d553dd8437358cb5131bd0d3024314edf31a2d4f4fe1454e482425144cf1473a60d3c5d1f10adae93edd8621dd4b082f83a9fd2320f60691b52e1f23c4c01a6087011239ce9faa131fef0d6615d70d23accd77cd0ce1c3a14d01dbb0afc3540da1b8b6bf8135901f10e5fbe17997e3c8f1c5e26aa80ed3bd14756e4eacaa7f8d1f2b6941b63bfec135a0d5cc1eb145d6fe48d367c6ae0878b18974af125bca886199f49ef07398266951b5df3969249a4d1126438f8cc923b5c4f51f7e83e436207dbc1556492778b60dde070c3d2932a2ca225d421b9b43c2e217d8c63ca6518fc4955da8de21dee22c1f26fcfeb356ae0ae723330d183bdc92fa3f2966aa347892053216e0c5c5ce2f95b05dc61617ce1ec46b8caa0d5c1280d28717a926aaf23242cea5a1bb8001b52fa57524c37e854d3dafe6d35a6d12ceda776c8e0c758d73771ccdd869b3a63782f0060397328ebdc1b880d07f8f52a843080db1112a3e8ab9962fa94463ee11e74418ae205887f0ae1d09708f96679882dbb73ba2e098c42ab9bf7d525884d08e65fbee450c73163cc03077b40a6f3facf58717a32630d44fd1b61e18ed7b6b82ac3292f210a46170616e01a46170617393cf00000002fb5d485fcf0000001a3d1b9e3ccf0000000fc575a8aea4617062789382a16901a16ec4083e3e3e3e3e54686982a16902a16ec408000000000000000181a16ec4080000000000000001a46170666192cf000000017448d3abcf00000012fbb6ac74a461706c7382a36e6273ce096a4b0ba36e7569ce34738bc9a3666565ce01017240a26676cd4f2aa367656eac6d61696e6e65742d76312e30a26768c420c061c4d8fc1dbdded2d7604be4568e3f6d041987ac37bde4b620b5ab39248adfa26c76ce00023a83a26c78c420df3c5ae42404363d396ed15f40bf55f658254b7b2c4d7374e7ec3d81b21a7168a46e6f7465c5000474757270a3736e64c4207c9952d72afcd20cb5c1666aa78de3adcfac081e02f1bcbc56129aab7a2c0186a474797065a46170706c";
+
+    uint8_t buffer[20000];
+    uint16_t bufferLen = parseHexString(buffer, sizeof(buffer), blobStr.c_str());
+
+    parser_init(&ctx, buffer, bufferLen);
+    const parser_error_t err = _read(&ctx, &parser_obj);
+    EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+    EXPECT_EQ(ctx.numKeys, 15);
+    // Every byte is walked once by the key index and at most once more by the field readers
+    EXPECT_LE(ctx.bytesScanned, 2u * bufferLen);
+}
+
+TEST(Transactions, DuplicatedKey) {
+    parser_context_t ctx;
+    parser_tx_t parser_obj;
+
+    uint8_t buffer[100];
+    auto bufferLen = parseHexString(buffer, sizeof(buffer), "82A366656501A366656502");
+
+    parser_init(&ctx, buffer, bufferLen);
+    const parser_error_t err = _read(&ctx, &parser_obj);
+    EXPECT_EQ(err, parser_duplicated_field) << parser_getErrorDescription(err);
+}
+
+TEST(Transactions, ValidateStructureMatchesValidate) {
+    const uint16_t bufferLen = kApplicationCall.size();
+
+    // Every blob that still parses must get the same verdict from both validation modes
+    uint32_t parsed = 0;
+    const uint8_t patterns[] = {0x00, 0x01, 0x7F, 0x80, 0xC4, 0xFF};
+    for (uint16_t pos = 0; pos < bufferLen; pos++) {
+        for (uint8_t pattern : patterns) {
+            std::vector<uint8_t> buffer = kApplicationCall;
+            buffer[pos] = pattern;
+
+            parser_context_t ctx;
+            parser_tx_t parser_obj;
+            if (parser_parse(&ctx, buffer.data(), bufferLen, &parser_obj) != parser_ok) {
+                continue;
+            }
+            parsed++;
+
+            const parser_error_t expected = parser_validate(&ctx);
+            const parser_error_t err = parser_validateStructure(&ctx);
+            EXPECT_EQ(err, expected) << "pos " << pos << " pattern " << (int) pattern;
+        }
+    }
+    EXPECT_GT(parsed, 0u);
+}
+
+TEST(Transactions, AddressRenderCache) {
+    parser_context_t ctx;
+    parser_tx_t parser_obj;
+    memset(&parser_obj, 0, sizeof(parser_obj));
+    parser_init(&ctx, kApplicationCall.data(), kApplicationCall.size());
+    ctx.parser_tx_obj = &parser_obj;
+    ASSERT_EQ(_read(&ctx, &parser_obj), parser_ok);
+    EXPECT_EQ(ctx.addresses.count, 0);
+
+    // Narrow pages so every address is requested several times
+    const auto cold = dumpUI(&ctx, 40, 21);
+    EXPECT_EQ(ctx.addresses.count, 3);      // Sender, rekey and one account
+    EXPECT_EQ(dumpUI(&ctx, 40, 21), cold);
+    EXPECT_EQ(ctx.addresses.count, 3);
+
+    for (uint8_t i = 0; i < ctx.addresses.count; i++) {
+        char expected[65];
+        ASSERT_EQ(encodePubKey((uint8_t *) expected, sizeof(expected), ctx.addresses.keys[i]), 58u);
+        EXPECT_STREQ(ctx.addresses.text[i], expected);
+    }
+
+    // A new parse must not show addresses of the previous transaction
+    memset(&parser_obj, 0, sizeof(parser_obj));
+    parser_init(&ctx, kApplicationCall.data(), kApplicationCall.size());
+    ASSERT_EQ(_read(&ctx, &parser_obj), parser_ok);
+    EXPECT_EQ(ctx.addresses.count, 0);
+}
+
+TEST(Transactions, AddressRenderCacheEviction) {
+    parser_address_cache_t cache;
+    cache.count = 0;
+    cache.next = 0;
+
+    uint8_t keys[ADDRESS_CACHE_ENTRIES + 3][32];
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        memset(keys[i], (int) i + 1, sizeof(keys[i]));
+    }
+
+    for (int round = 0; round < 3; round++) {
+        for (const auto &key : keys) {
+            const char *address = nullptr;
+            ASSERT_EQ(_renderAddress(&cache, key, &address), parser_ok);
+            char expected[65];
+            encodePubKey((uint8_t *) expected, sizeof(expected), key);
+            EXPECT_STREQ(address, expected);
+        }
+    }
+    EXPECT_EQ(cache.count, ADDRESS_CACHE_ENTRIES);
+}
+
+TEST(Transactions, DigestRenderCache) {
+    parser_context_t ctx;
+    parser_tx_t parser_obj;
+    memset(&parser_obj, 0, sizeof(parser_obj));
+    parser_init(&ctx, kApplicationCall.data(), kApplicationCall.size());
+    ctx.parser_tx_obj = &parser_obj;
+    ASSERT_EQ(_read(&ctx, &parser_obj), parser_ok);
+    EXPECT_EQ(ctx.digests.count, 0);
+
+    const auto cold = dumpUI(&ctx, 40, 21);
+    EXPECT_EQ(ctx.digests.count, 4);        // Two app args and both programs
+    EXPECT_EQ(dumpUI(&ctx, 40, 21), cold);
+    EXPECT_EQ(ctx.digests.count, 4);
+
+    for (uint8_t i = 0; i < ctx.digests.count; i++) {
+        char expected[45];
+        char cached[45];
+        ASSERT_EQ(b64hash_data((unsigned char *) ctx.digests.data[i], ctx.digests.dataLen[i], expected, sizeof(expected)), parser_ok);
+        ASSERT_EQ(_renderDigest(&ctx.digests, ctx.digests.data[i], ctx.digests.dataLen[i], cached, sizeof(cached)), parser_ok);
+        EXPECT_STREQ(cached, expected);
+    }
+
+    memset(&parser_obj, 0, sizeof(parser_obj));
+    parser_init(&ctx, kApplicationCall.data(), kApplicationCall.size());
+    ASSERT_EQ(_read(&ctx, &parser_obj), parser_ok);
+    EXPECT_EQ(ctx.digests.count, 0);
+}
+
+TEST(Transactions, DigestRenderCacheEviction) {
+    parser_digest_cache_t cache;
+    cache.count = 0;
+    cache.next = 0;
+
+    // Overlapping slices of one buffer, told apart by start and length
+    uint8_t data[DIGEST_CACHE_ENTRIES + 3];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 31 + 7);
+    }
+
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < sizeof(data); i++) {
+            char digest[45];
+            char expected[45];
+            ASSERT_EQ(_renderDigest(&cache, data + i, (uint16_t) (sizeof(data) - i), digest, sizeof(digest)), parser_ok);
+            b64hash_data(data + i, sizeof(data) - i, expected, sizeof(expected));
+            EXPECT_STREQ(digest, expected);
+
+            ASSERT_EQ(_renderDigest(&cache, data, (uint16_t) i, digest, sizeof(digest)), parser_ok);
+            b64hash_data(data, i, expected, sizeof(expected));
+            EXPECT_STREQ(digest, expected);
+        }
+    }
+    EXPECT_EQ(cache.count, DIGEST_CACHE_ENTRIES);
+}
+
+// Pages requested in the order a user scrolling back and forth would ask for them
+static std::vector<std::pair<uint8_t, uint8_t>> scrollOrder(parser_context_t *ctx, uint16_t keyLen, uint16_t valueLen) {
+    std::vector<std::pair<uint8_t, uint8_t>> order;
+    uint8_t numItems = 0;
+    parser_getNumItems(ctx, &numItems);
+    for (uint8_t idx = 0; idx < numItems; idx++) {
+        char key[100];
+        char value[100];
+        uint8_t pageCount = 0;
+        ctx->rendered.state = RENDER_NONE;
+        parser_getItem(ctx, idx, key, keyLen, value, valueLen, 0, &pageCount);
+        for (uint8_t page = 0; page < pageCount; page++) {
+            order.emplace_back(idx, page);
+        }
+        for (uint8_t page = pageCount; page > 0; page--) {
+            order.emplace_back(idx, page - 1);
+        }
+        if (idx > 0) {
+            order.emplace_back(idx - 1, 0);
+            order.emplace_back(idx, pageCount > 0 ? pageCount - 1 : 0);
+        }
+    }
+    return order;
+}
+
+TEST(Transactions, PagedRenderMatchesFormatter) {
+    const char *blobs[] = {
+        "88a46170617284a163c420546b182d119ce30f63b237b89cd9a468e82bb4ffd7357b55db971ca98020af40a166c42043"
+        "b7c58a06dac0e907e8bf6d7432757c6e5d3f6a74e1e5666586c9a21ab6944ea16dc420c844ffa90d4bf89da6a44a1c8c"
+        "be6d2d5a7e65a032a480b11b713f22d61bad3aa172c42022775c2ba5ab7997f2f396a32b37ca956e8a201fb5b6481db9"
+        "083f4a3a65cf51a463616964cd04d2a3666565cd0d20a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081"
+        "cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3736e64c4209fc49dcc6e5a09152e2c1dae9c4d0591cbb9f5"
+        "e7b8b12c8a2be896c7bfa1ed67a474797065a461636667",
+        "8ca3666565cd0e42a26676cd03e7a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5"
+        "093a22a26c76cd0d80a673656c6b6579c420771ef5ecbdee38821bfe3afd388ca5b35979122d343458116b7f34c3b4e7"
+        "3ebea3736e64c420bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfa7737072666b6579"
+        "c44099847419510e6cc4d235db0a33a470632c0760fa950ea837138245cf164eade1fd354f01fad2b351a9f263c010d7"
+        "8e21113812317edf5d6c2305d1f3e805a4f7a474797065a66b6579726567a7766f746566737401a6766f74656b640aa7"
+        "766f74656b6579c420f66af5dd18bcac57a9c4dde084852b64dba2e8baaa339844cc1e3946b8b99645a7766f74656c73"
+        "74cd07d0",
+        kPaymentHex,
+        "de0011a46170616192c40100c4020102a46170616e01a461706170c4050120010122a4617061739106a46170617492c4"
+        "20bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfc420a089aa6922e3b998fadff6cd48"
+        "08ddf9e021e4944e389ea3d5c638786689197ea4617066619103a46170677382a36e627302a36e756901a461706c7382"
+        "a36e627304a36e756903a461707375c4050220010122a3666565cd03e8a26676ce0004ec0fa367656eac746573746e65"
+        "742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76ce00"
+        "04eff7a46e6f7465c40a6e6f74652076616c7565a3736e64c42009fbd2762c08f86c5ae6bf6dd7a7a901de6675d750e0"
+        "7e8c5c7698647db6e1fda474797065a46170706c",
+        "89a461616d740aa461726376c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a366"
+        "6565cd0910a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22"
+        "a26c76cd07d0a3736e64c4205695782bd257daf5f0224772f3bc4874d4f291fe8458bb6c489aab28562da239a4747970"
+        "65a56178666572a478616964cd04d2",
+    };
+
+    for (const char *blob : blobs) {
+        uint8_t buffer[1000];
+        const uint16_t bufferLen = parseHexString(buffer, sizeof(buffer), blob);
+        parser_context_t ctx;
+        parser_tx_t parser_obj;
+        memset(&parser_obj, 0, sizeof(parser_obj));
+        ASSERT_EQ(parser_parse(&ctx, buffer, bufferLen, &parser_obj), parser_ok);
+
+        uint32_t servedFromRender = 0;
+        for (uint16_t valueLen : {2, 10, 17, 21, 40, 100}) {
+            for (const auto &page : scrollOrder(&ctx, 40, valueLen)) {
+                servedFromRender += ctx.rendered.state == RENDER_READY && ctx.rendered.displayIdx == page.first &&
+                                    ctx.rendered.outValLen == valueLen;
+                char key[100], value[100], expectedKey[100], expectedValue[100];
+                uint8_t pageCount = 0, expectedPageCount = 0;
+                const parser_error_t err = parser_getItem(&ctx, page.first, key, 40, value, valueLen,
+                                                          page.second, &pageCount);
+
+                // Same request with every cache dropped runs the formatters from scratch
+                const parser_rendered_item_t rendered = ctx.rendered;
+                ctx.rendered.state = RENDER_NONE;
+                ctx.addresses.count = 0;
+                const parser_error_t expectedErr = parser_getItem(&ctx, page.first, expectedKey, 40, expectedValue,
+                                                                  valueLen, page.second, &expectedPageCount);
+                ctx.rendered = rendered;
+
+                ASSERT_EQ(err, expectedErr);
+                EXPECT_EQ(pageCount, expectedPageCount);
+                EXPECT_STREQ(key, expectedKey);
+                EXPECT_EQ(memcmp(value, expectedValue, valueLen), 0)
+                    << "item " << (int) page.first << " page " << (int) page.second << " width " << valueLen;
+            }
+        }
+        EXPECT_GT(servedFromRender, 0u);
+    }
+}
+
+// Feeds buffer to a stream in chunks of chunkLen bytes, as tx_append does while the APDUs arrive
+static parser_error_t parseInChunks(parser_context_t *ctx, parser_tx_t *parser_obj,
+                                    const uint8_t *buffer, uint16_t bufferLen, uint16_t chunkLen) {
+    parser_stream_t stream;
+    parser_error_t err = parser_streamInit(&stream, ctx);
+    for (uint16_t received = 0; received < bufferLen && err == parser_ok; ) {
+        received = (bufferLen - received < chunkLen) ? bufferLen : received + chunkLen;
+        err = parser_streamAppend(&stream, buffer, received);
+    }
+    if (err != parser_ok) {
+        return err;
+    }
+    return parser_parseStreamed(ctx, &stream, buffer, bufferLen, parser_obj);
+}
+
+TEST(Transactions, StreamedParseMatchesParse) {
+    const uint16_t bufferLen = kApplicationCall.size();
+
+    // Whatever the chunking, the streamed parse must agree with the one-shot parse
+    const uint8_t patterns[] = {0x00, 0x01, 0x7F, 0x80, 0xC4, 0xDE, 0xFF};
+    for (uint16_t pos = 0; pos < bufferLen; pos++) {
+        for (uint8_t pattern : patterns) {
+            std::vector<uint8_t> buffer = kApplicationCall;
+            buffer[pos] = pattern;
+
+            parser_context_t ctx;
+            parser_tx_t parser_obj;
+            const parser_error_t expected = parser_parse(&ctx, buffer.data(), bufferLen, &parser_obj);
+            const uint8_t expectedItems = ctx.display.num_items;
+
+            for (uint16_t chunkLen : {1, 7, 250}) {
+                const parser_error_t err = parseInChunks(&ctx, &parser_obj, buffer.data(), bufferLen, chunkLen);
+                EXPECT_EQ(err, expected) << "pos " << pos << " pattern " << (int) pattern << " chunk " << chunkLen;
+                if (err == parser_ok && expected == parser_ok) {
+                    EXPECT_EQ(ctx.display.num_items, expectedItems);
+                }
+            }
+        }
+    }
+}
+
+TEST(Transactions, StreamRejectsAtFirstBadChunk) {
+    parser_context_t ctx;
+    parser_stream_t stream;
+
+    // {"fee": 1, "fee": 2, ...}, the second "fee" is already a duplicate
+    uint8_t buffer[100];
+    auto bufferLen = parseHexString(buffer, sizeof(buffer), "83A366656501A366656502A3726376C420");
+
+    parser_error_t err = parser_streamInit(&stream, &ctx);
+    EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    err = parser_streamAppend(&stream, buffer, 6);
+    EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    err = parser_streamAppend(&stream, buffer, 10);
+    EXPECT_EQ(err, parser_duplicated_field) << parser_getErrorDescription(err);
+
+    // The error sticks for the rest of the upload
+    err = parser_streamAppend(&stream, buffer, bufferLen);
+    EXPECT_EQ(err, parser_duplicated_field) << parser_getErrorDescription(err);
+
+    parser_tx_t parser_obj;
+    err = parser_parseStreamed(&ctx, &stream, buffer, bufferLen, &parser_obj);
+    EXPECT_EQ(err, parser_duplicated_field) << parser_getErrorDescription(err);
+}
+
+TEST(Transactions, StreamIncomplete) {
+    parser_context_t ctx;
+    parser_stream_t stream;
+    parser_tx_t parser_obj;
+
+    uint8_t buffer[100];
+    auto bufferLen = parseHexString(buffer, sizeof(buffer), "82A366656501A26676");
+
+    parser_streamInit(&stream, &ctx);
+    parser_error_t err = parser_streamAppend(&stream, buffer, bufferLen);
+    EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    err = parser_parseStreamed(&ctx, &stream, buffer, bufferLen, &parser_obj);
+    EXPECT_EQ(err, parser_unexpected_buffer_end) << parser_getErrorDescription(err);
+}
+
+TEST(Transactions, StreamTrailingBytes) {
+    parser_context_t ctx;
+    parser_stream_t stream;
+    parser_tx_t parser_obj;
+
+    std::vector<uint8_t> buffer = fromHex(kPaymentHex);
+    ASSERT_EQ(parseInChunks(&ctx, &parser_obj, buffer.data(), buffer.size(), 64), parser_ok);
+
+    // One byte after the map
+    buffer.push_back(0xc0);
+    parser_streamInit(&stream, &ctx);
+    parser_error_t err = parser_streamAppend(&stream, buffer.data(), buffer.size());
+    EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    err = parser_parseStreamed(&ctx, &stream, buffer.data(), buffer.size(), &parser_obj);
+    EXPECT_EQ(err, parser_unexpected_characters) << parser_getErrorDescription(err);
+}
+
+TEST(Transactions, NestedValueDepthLimit) {
+    parser_context_t ctx;
+    parser_tx_t parser_obj;
+
+    for (size_t depth : {MSGPACK_MAX_DEPTH, MSGPACK_MAX_DEPTH + 1, 4000}) {
+        // {"xtra": [[[...[1]...]]]}
+        std::vector<uint8_t> buffer = {0x81, 0xa4, 'x', 't', 'r', 'a'};
+        buffer.insert(buffer.end(), depth, 0x91);
+        buffer.push_back(0x01);
+
+        parser_init(&ctx, buffer.data(), buffer.size());
+        const parser_error_t err = _read(&ctx, &parser_obj);
+        if (depth <= MSGPACK_MAX_DEPTH) {
+            // Skipped fine, the transaction type is what is missing
+            EXPECT_EQ(err, parser_no_data) << parser_getErrorDescription(err);
+        } else {
+            EXPECT_EQ(err, parser_msgpack_depth_exceeded) << parser_getErrorDescription(err);
+        }
+    }
+}
+
+TEST(Transactions, PackedKeyTable) {
+    // Every generated key id must hash back to itself
+    for (uint8_t keyId = 0; keyId < KEYID_COUNT; keyId++) {
+        EXPECT_EQ(parserKeyHashTable[PARSER_KEY_HASH(parserKeyPacked[keyId])], keyId);
+    }
+}
+
+TEST(Transactions, AssetParamsExactKeyMatch) {
+    parser_context_t ctx;
+    parser_tx_t parser_obj;
+
+    std::string blobStr = "88a46170617284a163c420546b182d119ce30f63b237b89cd9a468e82bb4ffd7357b55db971ca98020af40a166c42043b7c58a06dac0e907e8bf6d7432757c6e5d3f6a74e1e5666586c9a21ab6944ea16dc420c844ffa90d4bf89da6a44a1c8cbe6d2d5a7e65a032a480b11b713f22d61bad3aa172c42022775c2ba5ab7997f2f396a32b37ca956e8a201fb5b6481db9083f4a3a65cf51a463616964cd04d2a3666565cd0d20a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3736e64c4209fc49dcc6e5a09152e2c1dae9c4d0591cbb9f5e7b8b12c8a2be896c7bfa1ed67a474797065a461636667";
+    uint8_t buffer[1000];
+    uint16_t bufferLen = parseHexString(buffer, sizeof(buffer), blobStr.c_str());
+
+    parser_init(&ctx, buffer, bufferLen);
+    parser_error_t err = _read(&ctx, &parser_obj);
+    EXPECT_EQ(err, parser_ok) << parser_getErrorDescription(err);
+
+    // Same transaction with the manager key "m" renamed to "mm"
+    blobStr = "88a46170617284a163c420546b182d119ce30f63b237b89cd9a468e82bb4ffd7357b55db971ca98020af40a166c42043b7c58a06dac0e907e8bf6d7432757c6e5d3f6a74e1e5666586c9a21ab6944ea26d6dc420c844ffa90d4bf89da6a44a1c8cbe6d2d5a7e65a032a480b11b713f22d61bad3aa172c42022775c2ba5ab7997f2f396a32b37ca956e8a201fb5b6481db9083f4a3a65cf51a463616964cd04d2a3666565cd0d20a26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3736e64c4209fc49dcc6e5a09152e2c1dae9c4d0591cbb9f5e7b8b12c8a2be896c7bfa1ed67a474797065a461636667";
+    bufferLen = parseHexString(buffer, sizeof(buffer), blobStr.c_str());
+
+    parser_init(&ctx, buffer, bufferLen);
+    err = _read(&ctx, &parser_obj);
+    EXPECT_EQ(err, parser_msgpack_unexpected_key) << parser_getErrorDescription(err);
+}
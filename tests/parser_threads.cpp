@@ -0,0 +1,99 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <hexutils.h>
+#include <parser_txdef.h>
+#include <parser.h>
+#include "utils/common.h"
+
+namespace {
+
+struct ParsedTx {
+    std::vector<uint8_t> blob;
+    parser_tx_t tx_obj;
+    parser_context_t ctx;
+};
+
+parser_error_t parseBlob(const char *hex, ParsedTx &parsed) {
+    parsed.blob.resize(strlen(hex) / 2);
+    const auto len = parseHexString(parsed.blob.data(), parsed.blob.size(), hex);
+    memset(&parsed.tx_obj, 0, sizeof(parsed.tx_obj));
+    parser_error_t err = parser_parse(&parsed.ctx, parsed.blob.data(), len, &parsed.tx_obj);
+    if (err != parser_ok) {
+        return err;
+    }
+    return parser_validate(&parsed.ctx);
+}
+
+std::vector<std::vector<std::string>> referenceOutputs() {
+    std::vector<std::vector<std::string>> answer;
+    for (const char *hex : kTxBlobs) {
+        ParsedTx parsed;
+        EXPECT_EQ(parseBlob(hex, parsed), parser_ok);
+        answer.push_back(dumpUI(&parsed.ctx, 39, 39));
+    }
+    return answer;
+}
+
+}  // namespace
+
+TEST(ParserContext, IndependentContextsCoexist) {
+    const auto expected = referenceOutputs();
+    const size_t numBlobs = sizeof(kTxBlobs) / sizeof(kTxBlobs[0]);
+
+    // Keep every transaction parsed at the same time and render them afterwards
+    std::vector<ParsedTx> parsed(numBlobs);
+    for (size_t i = 0; i < numBlobs; i++) {
+        ASSERT_EQ(parseBlob(kTxBlobs[i], parsed[i]), parser_ok);
+    }
+
+    for (size_t i = numBlobs; i > 0; i--) {
+        EXPECT_EQ(dumpUI(&parsed[i - 1].ctx, 39, 39), expected[i - 1]);
+    }
+}
+
+TEST(ParserContext, ConcurrentParsing) {
+    const auto expected = referenceOutputs();
+    const size_t numBlobs = sizeof(kTxBlobs) / sizeof(kTxBlobs[0]);
+    const size_t numThreads = 8;
+    const size_t iterations = 200;
+
+    std::atomic<uint32_t> mismatches {0};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; t++) {
+        workers.emplace_back([&, t]() {
+            for (size_t it = 0; it < iterations; it++) {
+                const size_t idx = (t + it) % numBlobs;
+                ParsedTx parsed;
+                if (parseBlob(kTxBlobs[idx], parsed) != parser_ok ||
+                    dumpUI(&parsed.ctx, 39, 39) != expected[idx]) {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    EXPECT_EQ(mismatches.load(), 0u);
+}
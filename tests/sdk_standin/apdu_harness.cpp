@@ -0,0 +1,281 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "apdu_harness.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include "coin.h"
+#include "sdk_standin.h"
+
+namespace {
+
+// IO_APDU_BUFFER_SIZE, for commands and replies
+constexpr size_t kApduBufferLen = 260;
+constexpr size_t kMaxApduData = 255;
+
+uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+std::string formatNs(uint64_t ns) {
+    char text[32];
+    if (ns < 1000) {
+        snprintf(text, sizeof(text), "%uns", static_cast<unsigned>(ns));
+    } else if (ns < 1000000) {
+        snprintf(text, sizeof(text), "%.1fus", ns / 1e3);
+    } else {
+        snprintf(text, sizeof(text), "%.1fms", ns / 1e6);
+    }
+    return text;
+}
+
+ApduReply toReply(const uint8_t *data, uint16_t len) {
+    ApduReply reply;
+    reply.review = sdk_standin_review_pending();
+    if (len >= 2) {
+        reply.data.assign(data, data + len - 2);
+        reply.sw = static_cast<uint16_t>((data[len - 2] << 8) | data[len - 1]);
+    }
+    return reply;
+}
+
+bool parseHexLine(const std::string &line, std::vector<uint8_t> *bytes) {
+    std::string digits;
+    for (char c : line) {
+        if (c == ' ' || c == '\t' || c == '\r') {
+            continue;
+        }
+        if (!isxdigit(static_cast<unsigned char>(c))) {
+            return false;
+        }
+        digits.push_back(c);
+    }
+    if (digits.empty() || digits.size() % 2 != 0 || digits.size() / 2 > kApduBufferLen) {
+        return false;
+    }
+    bytes->clear();
+    for (size_t i = 0; i < digits.size(); i += 2) {
+        bytes->push_back(static_cast<uint8_t>(std::stoul(digits.substr(i, 2), nullptr, 16)));
+    }
+    return true;
+}
+
+}  // namespace
+
+void LatencyHistogram::add(uint64_t ns) {
+    size_t bucket = 0;
+    while (bucket + 1 < kBuckets && (ns >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+    buckets_[bucket]++;
+    count_++;
+    total_ += ns;
+    min_ = std::min(min_, ns);
+    max_ = std::max(max_, ns);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p / 100.0 * count_ + 0.5));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < kBuckets; bucket++) {
+        seen += buckets_[bucket];
+        if (seen >= rank) {
+            return std::min(max_, (uint64_t(2) << bucket) - 1);
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::print(std::ostream &out) const {
+    uint64_t largest = 0;
+    for (uint64_t n : buckets_) {
+        largest = std::max(largest, n);
+    }
+    for (size_t bucket = 0; bucket < kBuckets; bucket++) {
+        if (buckets_[bucket] == 0) {
+            continue;
+        }
+        char line[64];
+        snprintf(line, sizeof(line), "    %8s - %-8s %10llu ",
+                 formatNs(uint64_t(1) << bucket).c_str(), formatNs(uint64_t(2) << bucket).c_str(),
+                 static_cast<unsigned long long>(buckets_[bucket]));
+        out << line << std::string(static_cast<size_t>(buckets_[bucket] * 40 / largest), '#') << "\n";
+    }
+}
+
+const char *apduPhaseName(ApduPhase phase) {
+    switch (phase) {
+        case ApduPhase::Parse:
+            return "parse";
+        case ApduPhase::Validate:
+            return "validate";
+        case ApduPhase::Sign:
+            return "sign";
+    }
+    return "";
+}
+
+ApduHarness::ApduHarness() {
+    sdk_standin_reset();
+}
+
+ApduReply ApduHarness::exchange(const std::vector<uint8_t> &command) {
+    uint8_t reply[kApduBufferLen];
+    const auto start = std::chrono::steady_clock::now();
+    const uint16_t len = sdk_standin_exchange(command.data(), static_cast<uint16_t>(command.size()), reply, sizeof(reply));
+    const uint64_t ns = elapsedNs(start);
+
+    if (command.size() > 2) {
+        const uint8_t ins = command[1];
+        // Group members are signed straight from the command, the review came before
+        const bool signs = ins == INS_SIGN_GROUP && command[2] == P1_GROUP_SIGNATURE;
+        record(ins, signs ? ApduPhase::Sign : ApduPhase::Parse, ns);
+        reviewIns_ = ins;
+    }
+    return toReply(reply, len);
+}
+
+ApduReply ApduHarness::upload(uint8_t ins, uint32_t account, const std::vector<uint8_t> &payload, size_t chunkLen) {
+    chunkLen = std::min(chunkLen, kMaxApduData);
+    std::vector<uint8_t> data = {
+        static_cast<uint8_t>(account >> 24), static_cast<uint8_t>(account >> 16),
+        static_cast<uint8_t>(account >> 8), static_cast<uint8_t>(account),
+    };
+    data.insert(data.end(), payload.begin(), payload.end());
+
+    ApduReply reply;
+    for (size_t offset = 0; offset < data.size(); offset += chunkLen) {
+        const size_t len = std::min(chunkLen, data.size() - offset);
+        const bool first = offset == 0;
+        const bool last = offset + len == data.size();
+        std::vector<uint8_t> command = {
+            CLA, ins,
+            static_cast<uint8_t>(first ? P1_FIRST_ACCOUNT_ID : P1_MORE),
+            static_cast<uint8_t>(last ? P2_LAST : P2_MORE),
+            static_cast<uint8_t>(len),
+        };
+        command.insert(command.end(), data.begin() + offset, data.begin() + offset + len);
+
+        reply = exchange(command);
+        if (reply.review || reply.sw != 0x9000) {
+            break;
+        }
+    }
+    return reply;
+}
+
+bool ApduHarness::reviewPending() const {
+    return sdk_standin_review_pending();
+}
+
+ApduReply ApduHarness::approve() {
+    return closeReview(true);
+}
+
+ApduReply ApduHarness::reject() {
+    return closeReview(false);
+}
+
+ApduReply ApduHarness::closeReview(bool accept) {
+    screens_.clear();
+    if (!sdk_standin_review_pending()) {
+        return ApduReply();
+    }
+
+    auto screen = [](const char *key, const char *value, void *ctx) {
+        static_cast<ApduHarness *>(ctx)->screens_.emplace_back(key, value);
+    };
+    auto start = std::chrono::steady_clock::now();
+    sdk_standin_review_walk(screen, this, nullptr);
+    record(reviewIns_, ApduPhase::Validate, elapsedNs(start));
+
+    uint8_t reply[kApduBufferLen];
+    start = std::chrono::steady_clock::now();
+    const uint16_t len = accept ? sdk_standin_approve(reply, sizeof(reply)) : sdk_standin_reject(reply, sizeof(reply));
+    if (accept) {
+        record(reviewIns_, ApduPhase::Sign, elapsedNs(start));
+    }
+    return toReply(reply, len);
+}
+
+bool ApduHarness::replay(std::istream &script, std::vector<ApduReply> *replies, std::string *error) {
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(script, line)) {
+        lineNumber++;
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        line = line.substr(first, line.find_last_not_of(" \t\r") + 1 - first);
+
+        ApduReply reply;
+        std::vector<uint8_t> command;
+        if (line == "approve" || line == "reject") {
+            if (!reviewPending()) {
+                if (error != nullptr) {
+                    *error = "line " + std::to_string(lineNumber) + ": no review to " + line;
+                }
+                return false;
+            }
+            reply = line == "approve" ? approve() : reject();
+        } else if (parseHexLine(line, &command)) {
+            reply = exchange(command);
+        } else {
+            if (error != nullptr) {
+                *error = "line " + std::to_string(lineNumber) + ": expected a command in hex, approve or reject";
+            }
+            return false;
+        }
+        if (replies != nullptr) {
+            replies->push_back(reply);
+        }
+    }
+    return true;
+}
+
+void ApduHarness::report(std::ostream &out) const {
+    char line[128];
+    snprintf(line, sizeof(line), "%-5s %-9s %10s %9s %9s %9s %9s %9s %9s\n",
+             "INS", "phase", "count", "min", "p50", "p90", "p99", "max", "mean");
+    out << line;
+    for (const auto &entry : histograms_) {
+        const LatencyHistogram &h = entry.second;
+        snprintf(line, sizeof(line), "0x%02x  %-9s %10llu %9s %9s %9s %9s %9s %9s\n",
+                 entry.first.first, apduPhaseName(entry.first.second),
+                 static_cast<unsigned long long>(h.count()),
+                 formatNs(h.min()).c_str(), formatNs(h.percentile(50)).c_str(),
+                 formatNs(h.percentile(90)).c_str(), formatNs(h.percentile(99)).c_str(),
+                 formatNs(h.max()).c_str(), formatNs(h.mean()).c_str());
+        out << line;
+    }
+    for (const auto &entry : histograms_) {
+        snprintf(line, sizeof(line), "\n0x%02x %s\n", entry.first.first, apduPhaseName(entry.first.second));
+        out << line;
+        entry.second.print(out);
+    }
+}
+
+void ApduHarness::record(uint8_t ins, ApduPhase phase, uint64_t ns) {
+    histograms_[std::make_pair(ins, phase)].add(ns);
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Replays APDU exchanges against app/src/apdu_handler.c on the host (see sdk_standin.h)
+// and keeps latency histograms per instruction and phase.
+
+// Power of two buckets in nanoseconds, bucket i holds [2^i, 2^(i+1))
+class LatencyHistogram {
+public:
+    static constexpr size_t kBuckets = 40;
+
+    void add(uint64_t ns);
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ == 0 ? 0 : min_; }
+    uint64_t max() const { return max_; }
+    uint64_t mean() const { return count_ == 0 ? 0 : total_ / count_; }
+
+    /// Upper bound of the bucket holding the given percentile (0 - 100)
+    uint64_t percentile(double p) const;
+
+    void print(std::ostream &out) const;
+
+private:
+    uint64_t buckets_[kBuckets] {};
+    uint64_t count_ = 0;
+    uint64_t total_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+enum class ApduPhase {
+    // handleApdu, from the command to its reply or to the review it opens
+    Parse,
+    // Every page of the review the user validates
+    Validate,
+    // The approval, up to the signature (or address, group ID) it replies with
+    Sign,
+};
+
+const char *apduPhaseName(ApduPhase phase);
+
+struct ApduReply {
+    std::vector<uint8_t> data;  // without the status word
+    uint16_t sw = 0;
+    bool review = false;        // a review was opened, approve() or reject() replies
+};
+
+class ApduHarness {
+public:
+    ApduHarness();
+
+    ApduReply exchange(const std::vector<uint8_t> &command);
+
+    /// Uploads a transaction (or group) in chunks of at most chunkLen bytes, the first one with the account
+    /// \return reply to the last chunk, or to the first one that failed
+    ApduReply upload(uint8_t ins, uint32_t account, const std::vector<uint8_t> &payload, size_t chunkLen = 250);
+
+    bool reviewPending() const;
+
+    /// Walks the open review then accepts it
+    ApduReply approve();
+
+    /// Walks the open review then rejects it
+    ApduReply reject();
+
+    /// Key / value of every page of the last review walked
+    const std::vector<std::pair<std::string, std::string>> &screens() const { return screens_; }
+
+    /// Replays a recorded sequence: one command per line in hex, "approve" or "reject" to close
+    /// the review the previous command opened. Empty lines and lines starting with # are skipped.
+    /// \return false on a malformed line, described in error
+    bool replay(std::istream &script, std::vector<ApduReply> *replies, std::string *error);
+
+    const std::map<std::pair<uint8_t, ApduPhase>, LatencyHistogram> &histograms() const { return histograms_; }
+
+    void clearHistograms() { histograms_.clear(); }
+
+    void report(std::ostream &out) const;
+
+private:
+    ApduReply closeReview(bool accept);
+    void record(uint8_t ins, ApduPhase phase, uint64_t ns);
+
+    uint8_t reviewIns_ = 0;
+    std::vector<std::pair<std::string, std::string>> screens_;
+    std::map<std::pair<uint8_t, ApduPhase>, LatencyHistogram> histograms_;
+};
@@ -0,0 +1,100 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Host stand-in for the BOLOS SDK calls reached from app/src/apdu_handler.c and
+// app/src/common. Exceptions keep the setjmp layout of the SDK, so handlers run unchanged.
+
+typedef unsigned short exception_t;
+
+typedef struct try_context_s {
+    jmp_buf jmp_buf;
+    struct try_context_s *previous;
+    exception_t ex;
+} try_context_t;
+
+try_context_t *try_context_get(void);
+
+/// Makes context the innermost one, returns the one it replaces
+try_context_t *try_context_set(try_context_t *context);
+
+/// Jumps to the innermost context, aborts if there is none
+void os_longjmp(unsigned int exception) __attribute__((noreturn));
+
+#define EXCEPTION_IO_RESET  0x10
+
+#define BEGIN_TRY                                               \
+    {                                                           \
+        try_context_t __try_context;
+
+#define TRY                                                     \
+        __try_context.ex = (exception_t) setjmp(__try_context.jmp_buf); \
+        if (__try_context.ex == 0) {                            \
+            __try_context.previous = try_context_set(&__try_context);
+
+#define CATCH(x)                                                \
+            goto __FINALLY;                                     \
+        } else if (__try_context.ex == (x)) {                   \
+            __try_context.ex = 0;                               \
+            try_context_set(__try_context.previous);
+
+#define CATCH_OTHER(e)                                          \
+            goto __FINALLY;                                     \
+        } else {                                                \
+            exception_t e;                                      \
+            e = __try_context.ex;                               \
+            __try_context.ex = 0;                               \
+            try_context_set(__try_context.previous);
+
+#define FINALLY                                                 \
+            goto __FINALLY;                                     \
+        }                                                       \
+        __FINALLY:                                              \
+        try_context_set(__try_context.previous);
+
+#define END_TRY                                                 \
+        if (__try_context.ex != 0) {                            \
+            THROW(__try_context.ex);                            \
+        }                                                       \
+    }
+
+#define THROW(x) os_longjmp(x)
+
+typedef unsigned char bolos_bool_t;
+#define BOLOS_UX_OK 0xAA
+
+/// BOLOS_UX_OK unless sdk_standin_set_pin_validated(false) was called
+bolos_bool_t os_global_pin_is_validated(void);
+
+// Not a device, GET_VERSION reports a zero target
+#define TARGET_ID 0x00000000
+
+#ifndef U4BE
+#define U4BE(buf, off) ((uint32_t) (((uint32_t) (buf)[(off)] << 24) | ((uint32_t) (buf)[(off) + 1] << 16) | \
+                                    ((uint32_t) (buf)[(off) + 2] << 8) | (uint32_t) (buf)[(off) + 3]))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,226 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "sdk_standin.h"
+#include "app_main.h"
+#include "os.h"
+#include "os_io_seproxyhal.h"
+#include "view.h"
+#include "actions.h"
+#include "crypto.h"
+#include "zxmacros.h"
+
+#include <stdlib.h>
+
+unsigned char G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+static try_context_t *tryContext = NULL;
+static bool pinValidated = true;
+
+// Reply sent through io_exchange by a review callback
+static uint8_t asyncReply[IO_APDU_BUFFER_SIZE];
+static uint16_t asyncReplyLen = 0;
+
+static struct {
+    viewfunc_getItem_t getItem;
+    viewfunc_getNumItems_t getNumItems;
+    viewfunc_accept_t accept;
+    bool pending;
+} review;
+
+try_context_t *try_context_get(void) {
+    return tryContext;
+}
+
+try_context_t *try_context_set(try_context_t *context) {
+    try_context_t *previous = tryContext;
+    tryContext = context;
+    return previous;
+}
+
+void os_longjmp(unsigned int exception) {
+    if (tryContext == NULL) {
+        abort();
+    }
+    longjmp(tryContext->jmp_buf, (int) exception);
+}
+
+bolos_bool_t os_global_pin_is_validated(void) {
+    return pinValidated ? BOLOS_UX_OK : 0;
+}
+
+unsigned short io_exchange(__Z_UNUSED unsigned char channel_and_flags, unsigned short tx_len) {
+    if (tx_len > sizeof(asyncReply)) {
+        tx_len = sizeof(asyncReply);
+    }
+    MEMCPY(asyncReply, G_io_apdu_buffer, tx_len);
+    asyncReplyLen = tx_len;
+    return 0;
+}
+
+void view_review_init(viewfunc_getItem_t viewfuncGetItem,
+                      viewfunc_getNumItems_t viewfuncGetNumItems,
+                      viewfunc_accept_t viewfuncAccept) {
+    review.getItem = viewfuncGetItem;
+    review.getNumItems = viewfuncGetNumItems;
+    review.accept = viewfuncAccept;
+    review.pending = false;
+}
+
+void view_review_show(__Z_UNUSED review_type_e reviewKind) {
+    review.pending = true;
+}
+
+// Status word appended the way the main loop of the app does
+static uint16_t statusWord(exception_t e) {
+    switch (e & 0xF000) {
+        case 0x6000:
+        case APDU_CODE_OK:
+            return e;
+        default:
+            return 0x6800 | (e & 0x7FF);
+    }
+}
+
+static uint16_t copyReply(const uint8_t *data, uint32_t len, uint8_t *reply, uint16_t replyMaxLen) {
+    if (reply == NULL || len > replyMaxLen) {
+        return 0;
+    }
+    MEMCPY(reply, data, len);
+    return (uint16_t) len;
+}
+
+void sdk_standin_reset(void) {
+    MEMZERO(&review, sizeof(review));
+    MEMZERO(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    asyncReplyLen = 0;
+    pinValidated = true;
+    crypto_clearKeyCache();
+}
+
+void sdk_standin_set_pin_validated(bool validated) {
+    pinValidated = validated;
+}
+
+uint16_t sdk_standin_exchange(const uint8_t *command, uint16_t commandLen, uint8_t *reply, uint16_t replyMaxLen) {
+    if ((command == NULL && commandLen != 0) || commandLen > sizeof(G_io_apdu_buffer)) {
+        return 0;
+    }
+    review.pending = false;
+    MEMZERO(G_io_apdu_buffer, sizeof(G_io_apdu_buffer));
+    if (commandLen != 0) {
+        MEMCPY(G_io_apdu_buffer, command, commandLen);
+    }
+
+    volatile uint32_t flags = 0;
+    volatile uint32_t tx = 0;
+
+    BEGIN_TRY
+    {
+        TRY
+        {
+            if (commandLen == 0) {
+                THROW(APDU_CODE_EMPTY_BUFFER);
+            }
+            handleApdu(&flags, &tx, commandLen);
+        }
+        CATCH_OTHER(e)
+        {
+            const uint16_t sw = statusWord(e);
+            G_io_apdu_buffer[tx] = sw >> 8;
+            G_io_apdu_buffer[tx + 1] = sw & 0xFF;
+            tx += 2;
+        }
+        FINALLY
+        {
+        }
+    }
+    END_TRY;
+
+    if ((flags & IO_ASYNCH_REPLY) != 0) {
+        return 0;
+    }
+    return copyReply(G_io_apdu_buffer, tx, reply, replyMaxLen);
+}
+
+bool sdk_standin_review_pending(void) {
+    return review.pending;
+}
+
+zxerr_t sdk_standin_review_walk(sdk_standin_screen_t screen, void *ctx, uint16_t *pages) {
+    if (!review.pending || review.getItem == NULL || review.getNumItems == NULL) {
+        return zxerr_no_data;
+    }
+
+    char key[SDK_STANDIN_KEY_LEN];
+    char value[SDK_STANDIN_VALUE_LEN];
+    uint16_t rendered = 0;
+    uint8_t numItems = 0;
+    CHECK_ZXERR(review.getNumItems(&numItems))
+
+    for (uint8_t item = 0; item < numItems; item++) {
+        uint8_t pageCount = 1;
+        for (uint8_t page = 0; page < pageCount; page++) {
+            CHECK_ZXERR(review.getItem((int8_t) item, key, sizeof(key), value, sizeof(value), page, &pageCount))
+            if (screen != NULL) {
+                screen(key, value, ctx);
+            }
+            rendered++;
+        }
+    }
+
+    if (pages != NULL) {
+        *pages = rendered;
+    }
+    return zxerr_ok;
+}
+
+static uint16_t closeReview(viewfunc_accept_t callback, uint8_t *reply, uint16_t replyMaxLen) {
+    if (!review.pending || callback == NULL) {
+        return 0;
+    }
+    review.pending = false;
+    asyncReplyLen = 0;
+
+    BEGIN_TRY
+    {
+        TRY
+        {
+            callback();
+        }
+        CATCH_OTHER(e)
+        {
+            const uint16_t sw = statusWord(e);
+            asyncReply[0] = sw >> 8;
+            asyncReply[1] = sw & 0xFF;
+            asyncReplyLen = 2;
+        }
+        FINALLY
+        {
+        }
+    }
+    END_TRY;
+
+    return copyReply(asyncReply, asyncReplyLen, reply, replyMaxLen);
+}
+
+uint16_t sdk_standin_approve(uint8_t *reply, uint16_t replyMaxLen) {
+    return closeReview(review.accept, reply, replyMaxLen);
+}
+
+uint16_t sdk_standin_reject(uint8_t *reply, uint16_t replyMaxLen) {
+    return closeReview(app_reject, reply, replyMaxLen);
+}
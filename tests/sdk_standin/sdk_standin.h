@@ -0,0 +1,63 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "zxerror.h"
+
+// Drives app/src/apdu_handler.c on the host the way the main loop of the app does on the device.
+// Replies are copied out with their status word.
+
+// Review buffers of the Nano S+ / X view
+#define SDK_STANDIN_KEY_LEN     64
+#define SDK_STANDIN_VALUE_LEN   4096
+
+/// Called for every page of the review, in the order the user scrolls through them
+typedef void (*sdk_standin_screen_t)(const char *key, const char *value, void *ctx);
+
+/// Clears the review, the reply, the derived key and validates the PIN
+void sdk_standin_reset(void);
+
+void sdk_standin_set_pin_validated(bool validated);
+
+/// Sends one command through handleApdu. A review left open is dropped.
+/// \return reply length, status word included. 0 when the command opened a review,
+///         sdk_standin_approve or sdk_standin_reject then reply to it.
+uint16_t sdk_standin_exchange(const uint8_t *command, uint16_t commandLen, uint8_t *reply, uint16_t replyMaxLen);
+
+bool sdk_standin_review_pending(void);
+
+/// Renders every page of every item of the open review
+/// \param screen optional, receives each page
+/// \param pages optional, number of pages rendered
+zxerr_t sdk_standin_review_walk(sdk_standin_screen_t screen, void *ctx, uint16_t *pages);
+
+/// Accepts the open review, the reply is the one sent by its callback
+/// \return reply length, 0 if no review was open
+uint16_t sdk_standin_approve(uint8_t *reply, uint16_t replyMaxLen);
+
+/// Rejects the open review
+/// \return reply length, 0 if no review was open
+uint16_t sdk_standin_reject(uint8_t *reply, uint16_t replyMaxLen);
+
+#ifdef __cplusplus
+}
+#endif
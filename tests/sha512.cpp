@@ -0,0 +1,188 @@
+/*******************************************************************************
+*   (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <hexutils.h>
+#include "sha512.h"
+#include "sha512_xn.h"
+#include "sha512_xn_kernel.h"
+#include "address_batch.h"
+#include "parser_encoding.h"
+
+using namespace std;
+
+namespace {
+
+// SHA512/256 keeps the first half of the SHA-512 sized output
+string digestHex(const uint8_t digest[SHA512_DIGEST_LENGTH]) {
+    char hex[65];
+    array_to_hexstr(hex, sizeof(hex), digest, 32);
+    return string(hex);
+}
+
+string oneShot(const vector<uint8_t> &msg) {
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256(msg.data(), msg.size(), digest);
+    return digestHex(digest);
+}
+
+vector<uint8_t> bytes(const char *s) {
+    return vector<uint8_t>(s, s + strlen(s));
+}
+
+}  // namespace
+
+TEST(SHA512_256, KnownAnswers) {
+    // FIPS 180-4 examples
+    EXPECT_EQ(oneShot(bytes("")), "c672b8d1ef56ed28ab87c3622c5114069bdd3ad7b8f9737498d0c01ecef0967a");
+    EXPECT_EQ(oneShot(bytes("abc")), "53048e2681941ef99b2e29b76b4c7dabe4c2d0c634fc6d46e0e2f13107e7af23");
+    EXPECT_EQ(oneShot(bytes("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                            "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu")),
+              "3928e184fb8690f840da3988121d31be65cb9d3ef83ee6146feac861e19b563a");
+}
+
+TEST(SHA512_256, StreamingMatchesOneShot) {
+    // Long enough to span several 128-byte blocks
+    vector<uint8_t> msg(1000);
+    for (size_t i = 0; i < msg.size(); i++) {
+        msg[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+
+    for (size_t len : {0, 1, 111, 112, 127, 128, 129, 255, 256, 1000}) {
+        const vector<uint8_t> prefix(msg.begin(), msg.begin() + len);
+        const string expected = oneShot(prefix);
+
+        for (size_t chunkLen : {1, 3, 64, 127, 128, 250}) {
+            SHA512_256_CTX ctx;
+            SHA512_256_Init(&ctx);
+            for (size_t offset = 0; offset < len; offset += chunkLen) {
+                SHA512_256_Update(&ctx, prefix.data() + offset, min(chunkLen, len - offset));
+            }
+
+            uint8_t digest[SHA512_DIGEST_LENGTH];
+            SHA512_256_Final(&ctx, digest);
+            EXPECT_EQ(digestHex(digest), expected) << "len " << len << " chunk " << chunkLen;
+        }
+    }
+}
+
+TEST(SHA512_256, CopiedContextForks) {
+    SHA512_256_CTX ctx;
+    SHA512_256_Init(&ctx);
+    SHA512_256_Update(&ctx, reinterpret_cast<const uint8_t *>("ab"), 2);
+
+    SHA512_256_CTX fork = ctx;
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+
+    SHA512_256_Update(&ctx, reinterpret_cast<const uint8_t *>("c"), 1);
+    SHA512_256_Final(&ctx, digest);
+    EXPECT_EQ(digestHex(digest), oneShot(bytes("abc")));
+
+    SHA512_256_Final(&fork, digest);
+    EXPECT_EQ(digestHex(digest), oneShot(bytes("ab")));
+}
+
+TEST(SHA512_256, ContextVersionMatchesConcatenation) {
+    const vector<uint8_t> prefix = bytes("appID");
+    const vector<uint8_t> msg = bytes("message");
+
+    vector<uint8_t> concatenated(prefix);
+    concatenated.push_back(3);
+    concatenated.insert(concatenated.end(), msg.begin(), msg.end());
+
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    SHA512_256_with_context_version(prefix.data(), prefix.size(), 3, msg.data(), msg.size(), digest);
+    EXPECT_EQ(digestHex(digest), oneShot(concatenated));
+}
+
+namespace {
+
+typedef void (*xn_fn)(const uint8_t *const *in, const size_t *n, size_t count,
+                      uint8_t (*out)[SHA512_DIGEST_LENGTH]);
+
+// Messages of mixed lengths so lanes finish on different blocks
+void checkMultiBuffer(xn_fn fn, size_t count) {
+    vector<vector<uint8_t>> msgs(count);
+    vector<const uint8_t *> in(count);
+    vector<size_t> n(count);
+    for (size_t i = 0; i < count; i++) {
+        msgs[i].resize((i * 53) % 400);
+        for (size_t j = 0; j < msgs[i].size(); j++) {
+            msgs[i][j] = static_cast<uint8_t>(i + j * 7);
+        }
+        in[i] = msgs[i].data();
+        n[i] = msgs[i].size();
+    }
+
+    vector<array<uint8_t, SHA512_DIGEST_LENGTH>> out(count);
+    fn(in.data(), n.data(), count, reinterpret_cast<uint8_t (*)[SHA512_DIGEST_LENGTH]>(out.data()));
+
+    for (size_t i = 0; i < count; i++) {
+        EXPECT_EQ(digestHex(out[i].data()), oneShot(msgs[i])) << "message " << i << " of " << count;
+    }
+}
+
+}  // namespace
+
+TEST(SHA512_256, MultiBufferMatchesOneShot) {
+    for (size_t count : {0, 1, 3, 4, 5, 8, 9, 17, 100}) {
+        checkMultiBuffer(SHA512_256_xN, count);
+    }
+}
+
+#if defined(SHA512_XN_X86)
+TEST(SHA512_256, MultiBufferKernels) {
+    // Every kernel the CPU can run, whichever one the dispatcher picked
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        for (size_t count = 1; count <= 4; count++) {
+            checkMultiBuffer(sha512_256_x4_avx2, count);
+        }
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        for (size_t count = 1; count <= 8; count++) {
+            checkMultiBuffer(sha512_256_x8_avx512, count);
+        }
+    }
+}
+#endif
+
+TEST(SHA512_256, EncodePubKeyBatch) {
+    const size_t count = 70;
+    vector<array<uint8_t, PK_LEN_25519>> keys(count);
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < PK_LEN_25519; j++) {
+            keys[i][j] = static_cast<uint8_t>(i * 13 + j);
+        }
+    }
+
+    vector<array<char, ADDRESS_BUFFER_LEN>> addresses(count);
+    const size_t written = encodePubKeyBatch(reinterpret_cast<const uint8_t (*)[PK_LEN_25519]>(keys.data()), count,
+                                             reinterpret_cast<char (*)[ADDRESS_BUFFER_LEN]>(addresses.data()));
+    EXPECT_EQ(written, count);
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t expected[ADDRESS_BUFFER_LEN];
+        const uint32_t len = encodePubKey(expected, sizeof(expected), keys[i].data());
+        EXPECT_EQ(len, 58u);
+        EXPECT_STREQ(addresses[i].data(), reinterpret_cast<const char *>(expected)) << "key " << i;
+    }
+}
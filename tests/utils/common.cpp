@@ -16,15 +16,71 @@
 #include <parser.h>
 #include <sstream>
 #include <string>
+#include <hexutils.h>
 #include "common.h"
 
+std::vector<uint8_t> fromHex(const std::string &hex) {
+    std::vector<uint8_t> bytes(hex.size() / 2);
+    bytes.resize(parseHexString(bytes.data(), bytes.size(), hex.c_str()));
+    return bytes;
+}
+
+std::string toHex(const uint8_t *data, size_t len) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < len; i++) {
+        out.push_back(digits[data[i] >> 4]);
+        out.push_back(digits[data[i] & 0xF]);
+    }
+    return out;
+}
+
+const char kPaymentHex[] =
+    "8ba3616d74cd03e8a5636c6f7365c42040e93492882564cbce9c59a69b67542689e9a1c3a2a9ea5b65a6e8a4421ffc57"
+    "a3666565cd03e8a26676cd3039a367656eac6465766e65742d7633382e30a26768c420feb36c3910143900c3da5542ca"
+    "1836b00fd2f819591257cd23f6042f98c8369da26c76cdf6fda46e6f7465c40845262200185286fba3726376c4207b6c"
+    "e24feb5bacc0b164e29c222c57f5f63dc387d439048258411c5fe10f7c02a3736e64c4208d92b489900173a04dfa4359"
+    "a3666a6afcea2c42a05dd9c1f73eeba5478037e9a474797065a3706179";
+
+const char kAssetFreezeHex[] =
+    "88a466616464c420008071382ab5b4b9b3d92d194360891869f52a8c66016c7779700618c079bf91a466616964cd04d2"
+    "a3666565cd08caa26676cd03e8a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e509"
+    "3a22a26c76cd07d0a3736e64c420abfe6c24528d0cd161f95f54ef05c8bb3c8adfe829e5aaf3c7020046799efbb9a474"
+    "797065a46166727a";
+
+const char kApplicationCallHex[] =
+    "de0014a46170616192c40100c4020102a46170616e01a461706170c4050120010122a4617061739106a46170617491c4"
+    "20bb0eb634154a180b6a274dd775295c36d3ba7aae6b5db0cc10c5462db0f330dfa46170657002a4617066619103a461"
+    "70677382a36e627302a36e756901a461706c7382a36e627304a36e756903a461707375c4050220010122a3666565cd03"
+    "e8a26676ce0004ec0fa367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f"
+    "71f059a7ac20dec62f7f70e5093a22a26c76ce0004eff7a26c78c4200707070707070707070707070707070707070707"
+    "070707070707070707070707a46e6f7465c40a6e6f74652076616c7565a572656b6579c420a089aa6922e3b998fadff6"
+    "cd4808ddf9e021e4944e389ea3d5c638786689197ea3736e64c42009fbd2762c08f86c5ae6bf6dd7a7a901de6675d750"
+    "e07e8c5c7698647db6e1fda474797065a46170706c";
+
+const char *const kTxBlobs[3] = {kPaymentHex, kAssetFreezeHex, kApplicationCallHex};
+
+const std::vector<std::string> kGroupUngrouped = {
+    "89a3616d74ce000f4240a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3726376c4204142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f60a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a3706179",
+    "89a3616d74cd09c4a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3726376c4206162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f80a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a3706179",
+    "8aa461616d740aa461726376c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76cd07d0a3736e64c4202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f40a474797065a56178666572a478616964ce01e1ab70",
+};
+
+const char kGroupId[] = "1880ad4622353661401083bc677413c7926e147bfb009d5f5c976a3ad2feeae9";
+
+const std::vector<std::string> kGroupMembers = {
+    "8aa3616d74ce000f4240a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c4201880ad4622353661401083bc677413c7926e147bfb009d5f5c976a3ad2feeae9a26c76cd07d0a3726376c4204142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f60a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a3706179",
+    "8aa3616d74cd09c4a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c4201880ad4622353661401083bc677413c7926e147bfb009d5f5c976a3ad2feeae9a26c76cd07d0a3726376c4206162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f80a3736e64c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a474797065a3706179",
+    "8ba461616d740aa461726376c4200102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20a3666565cd03e8a26676cd03e8a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c4201880ad4622353661401083bc677413c7926e147bfb009d5f5c976a3ad2feeae9a26c76cd07d0a3736e64c4202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f40a474797065a56178666572a478616964ce01e1ab70",
+};
+
 std::vector<std::string> dumpUI(parser_context_t *ctx,
                                 uint16_t maxKeyLen,
                                 uint16_t maxValueLen) {
     auto answer = std::vector<std::string>();
 
     uint8_t numItems;
-    parser_error_t err = parser_getNumItems(&numItems);
+    parser_error_t err = parser_getNumItems(ctx, &numItems);
     if (err != parser_ok) {
         return answer;
     }
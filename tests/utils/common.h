@@ -13,9 +13,33 @@
 *  See the License for the specific language governing permissions and
 *  limitations under the License.
 ********************************************************************************/
+#include <cstdint>
 #include <vector>
 #include <string>
 
+/// Bytes of a hex string, parsed with parseHexString
+std::vector<uint8_t> fromHex(const std::string &hex);
+
+/// Lower case hex of data
+std::string toHex(const uint8_t *data, size_t len);
+
+/// Hex of a payment with close, rekey and note
+extern const char kPaymentHex[];
+/// Hex of an asset freeze
+extern const char kAssetFreezeHex[];
+/// Hex of an application call with args, accounts, foreign apps and assets, box references and both programs
+extern const char kApplicationCallHex[];
+
+/// The three transactions above, in that order
+extern const char *const kTxBlobs[3];
+
+/// Two payments from one sender and an asset transfer from another, without grp
+extern const std::vector<std::string> kGroupUngrouped;
+/// Group ID of kGroupUngrouped, computed independently: txlist of SHA512/256("TX" || member)
+extern const char kGroupId[];
+/// kGroupUngrouped with grp set to kGroupId, as group_build leaves them
+extern const std::vector<std::string> kGroupMembers;
+
 std::vector<std::string> dumpUI(parser_context_t *ctx,
                                 uint16_t maxKeyLen,
                                 uint16_t maxValueLen);
@@ -21,6 +21,7 @@ import { APP_SEED, models, txApplication, txAssetConfig, txAssetFreeze, txAssetX
 
 // @ts-ignore
 import ed25519 from 'ed25519-supercop'
+import jsSHA from 'jssha'
 
 const defaultOptions = {
   ...DEFAULT_START_OPTIONS,
@@ -182,7 +183,7 @@ describe('Standard', function () {
       const pubKey = responseAddr.publicKey
 
       // do not wait here.. we need to navigate
-      const signatureRequest = app.sign(accountId, txBlob)
+      const signatureRequest = app.sign(accountId, txBlob, true)
 
       // Wait until we are not in the main menu
       await sim.waitUntilScreenIsNot(sim.getMainMenuSnapshot())
@@ -198,6 +199,11 @@ describe('Standard', function () {
       const prehash = Buffer.concat([Buffer.from('TX'), txBlob])
       const valid = ed25519.verify(signatureResponse.signature, prehash, pubKey)
       expect(valid).toEqual(true)
+
+      // Requested with the last chunk, the device hashed it while the chunks arrived
+      const sha = new jsSHA('SHA-512/256', 'UINT8ARRAY')
+      sha.update(prehash)
+      expect(signatureResponse.txid).toEqual(Buffer.from(sha.getHash('UINT8ARRAY')))
     } finally {
       await sim.close()
     }
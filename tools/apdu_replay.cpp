@@ -0,0 +1,85 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Replays a recorded APDU sequence against app/src/apdu_handler.c built for the host
+// (tests/sdk_standin) and prints latency histograms per instruction and phase:
+//   parse     handleApdu, chunk intake, parsing and structure checks
+//   validate  rendering every page of the review
+//   sign      the approval, up to the reply it sends
+// See tests/apdu_sequences for the format. Times are host times, only comparable between runs
+// on the same machine, the stand-in SDK does not model device crypto.
+//
+// Usage: apdu_replay <sequence.apdu> [iterations]
+
+#include "apdu_harness.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr, "usage: %s <sequence.apdu> [iterations]\n", argv[0]);
+        return 2;
+    }
+
+    unsigned long iterations = 1000;
+    if (argc == 3) {
+        char *end = nullptr;
+        errno = 0;
+        iterations = strtoul(argv[2], &end, 10);
+        if (errno != 0 || *end != '\0' || iterations == 0) {
+            fprintf(stderr, "invalid iteration count %s\n", argv[2]);
+            return 2;
+        }
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        fprintf(stderr, "can not read %s\n", argv[1]);
+        return 1;
+    }
+    std::stringstream script;
+    script << in.rdbuf();
+
+    ApduHarness harness;
+    std::vector<ApduReply> replies;
+    for (unsigned long i = 0; i < iterations; i++) {
+        std::istringstream pass(script.str());
+        std::string error;
+        replies.clear();
+        if (!harness.replay(pass, &replies, &error)) {
+            fprintf(stderr, "%s: %s\n", argv[1], error.c_str());
+            return 1;
+        }
+    }
+
+    // Status words of the last pass, to tell a slow sequence from one that fails early
+    size_t failed = 0;
+    for (const ApduReply &reply : replies) {
+        if (!reply.review && reply.sw != 0x9000) {
+            failed++;
+        }
+    }
+    printf("%lu passes of %zu exchanges, %zu not answered with 0x9000\n\n", iterations, replies.size(), failed);
+    harness.report(std::cout);
+    return 0;
+}
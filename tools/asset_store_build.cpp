@@ -0,0 +1,136 @@
+/*******************************************************************************
+*  (c) 2018 - 2022 Zondax AG
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+********************************************************************************/
+
+// Builds an asset store file from a csv with the columns of app/src/algo_asa.csv:
+//   id,name,unit,decimals
+// Lines starting with # are comments, fields may be double quoted.
+//
+// Usage: asset_store_build <assets.csv> <assets.bin>
+
+#include "asset_store.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool splitCsvLine(const std::string &line, std::vector<std::string> *fields) {
+    fields->assign(1, std::string());
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields->back().push_back('"');
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields->back().push_back(c);
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields->emplace_back();
+        } else if (c != '\r') {
+            fields->back().push_back(c);
+        }
+    }
+    return !quoted;
+}
+
+bool parseUnsigned(const std::string &s, uint64_t max, uint64_t *value) {
+    if (s.empty() || s[0] < '0' || s[0] > '9') {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    const unsigned long long v = strtoull(s.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || v > max) {
+        return false;
+    }
+    *value = v;
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <assets.csv> <assets.bin>\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        fprintf(stderr, "can not read %s\n", argv[1]);
+        return 1;
+    }
+
+    // Strings stay owned here, entries point into them once reading is done
+    struct Row {
+        uint64_t id;
+        std::string name;
+        std::string unit;
+        uint8_t decimals;
+    };
+    std::vector<Row> rows;
+    std::string line;
+    size_t lineNumber = 0;
+    bool header = true;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::vector<std::string> fields;
+        if (!splitCsvLine(line, &fields) || fields.size() != 4) {
+            fprintf(stderr, "%s:%zu: expected id,name,unit,decimals\n", argv[1], lineNumber);
+            return 1;
+        }
+        if (header) {
+            header = false;
+            if (fields[0] == "id") {
+                continue;
+            }
+        }
+        uint64_t id = 0;
+        uint64_t decimals = 0;
+        // Digits of UINT64_MAX, the most an amount can be shifted
+        if (!parseUnsigned(fields[0], UINT64_MAX, &id) || !parseUnsigned(fields[3], 19, &decimals)) {
+            fprintf(stderr, "%s:%zu: invalid id or decimals\n", argv[1], lineNumber);
+            return 1;
+        }
+        rows.push_back({id, fields[1], fields[2], static_cast<uint8_t>(decimals)});
+    }
+
+    std::vector<asset_store_entry_t> entries;
+    entries.reserve(rows.size());
+    for (const Row &row : rows) {
+        entries.push_back({row.id, row.name.c_str(), row.unit.c_str(), row.decimals});
+    }
+
+    if (!asset_store_write(argv[2], entries.data(), entries.size())) {
+        fprintf(stderr, "can not write %s: duplicate ids, empty names or units, or I/O error\n", argv[2]);
+        return 1;
+    }
+    printf("%zu assets written to %s\n", entries.size(), argv[2]);
+    return 0;
+}